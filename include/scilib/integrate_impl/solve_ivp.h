@@ -119,6 +119,12 @@ void dormand_prince(F f,
     constexpr int max_iter = 100;
     int iter = 0;
 
+    // Work arrays for the stages; the expressions are evaluated in place.
+    using mdarray_type = Sci::MDArray<double, Kokkos::extents<IndexType, ext>, Layout, Container>;
+    mdarray_type ytmp = y;
+    mdarray_type ynew = y;
+    mdarray_type err_vec = y;
+
     // Algorithm: Runge-Kutta-Fehlberg method from Wikipedia
     while (x < xf) {
         if (h < hmin) {
@@ -132,14 +138,20 @@ void dormand_prince(F f,
         }
         // clang-format off
         auto k1 = f(x + c1 * h, y);
-        auto k2 = f(x + c2 * h, y + h * (a21 * k1));
-        auto k3 = f(x + c3 * h, y + h * (a31 * k1 + a32 * k2));
-        auto k4 = f(x + c4 * h, y + h * (a41 * k1 + a42 * k2 + a43 * k3));
-        auto k5 = f(x + c5 * h, y + h * (a51 * k1 + a52 * k2 + a53 * k3 + a54 * k4));
-        auto k6 = f(x + c6 * h, y + h * (a61 * k1 + a62 * k2 + a63 * k3 + a64 * k4 + a65 * k5));
-        auto k7 = f(x + c7 * h, y + h * (a71 * k1 + a72 * k2 + a73 * k3 + a74 * k4 + a75 * k5 + a76 * k6));
-        auto err_vec = h * (e1 * k1 + e2 * k2 + e3 * k3 + e4 * k4 + e5 * k5 + e6 * k6 + e7 * k7);
-        auto ynew = y + h * (b1 * k1 + b2 * k2 + b3 * k3 + b4 * k4 + b5 * k5 + b6 * k6 + b7 * k7);
+        ytmp = y + h * (a21 * k1);
+        auto k2 = f(x + c2 * h, ytmp);
+        ytmp = y + h * (a31 * k1 + a32 * k2);
+        auto k3 = f(x + c3 * h, ytmp);
+        ytmp = y + h * (a41 * k1 + a42 * k2 + a43 * k3);
+        auto k4 = f(x + c4 * h, ytmp);
+        ytmp = y + h * (a51 * k1 + a52 * k2 + a53 * k3 + a54 * k4);
+        auto k5 = f(x + c5 * h, ytmp);
+        ytmp = y + h * (a61 * k1 + a62 * k2 + a63 * k3 + a64 * k4 + a65 * k5);
+        auto k6 = f(x + c6 * h, ytmp);
+        ytmp = y + h * (a71 * k1 + a72 * k2 + a73 * k3 + a74 * k4 + a75 * k5 + a76 * k6);
+        auto k7 = f(x + c7 * h, ytmp);
+        err_vec = h * (e1 * k1 + e2 * k2 + e3 * k3 + e4 * k4 + e5 * k5 + e6 * k6 + e7 * k7);
+        ynew = y + h * (b1 * k1 + b2 * k2 + b3 * k3 + b4 * k4 + b5 * k5 + b6 * k6 + b7 * k7);
         // clang-format on
         double error_norm = Sci::Integrate::__Detail::error_norm(y, ynew, err_vec, atol, rtol);
 
@@ -26,6 +26,7 @@
 #include "linalg_impl/blas1_vector_norm2.h"
 #include "linalg_impl/blas2_matrix_vector_product.h"
 #include "linalg_impl/blas3_matrix_product.h"
+#include "linalg_impl/blas3_batched_matrix_product.h"
 
 #include "linalg_impl/scaled.h"
 #include "linalg_impl/trace.h"
@@ -36,9 +37,14 @@
 #include "linalg_impl/eigenvalue.h"
 #include "linalg_impl/inv.h"
 #include "linalg_impl/expm.h"
+#include "linalg_impl/expm_multiply.h"
 #include "linalg_impl/matrix_power.h"
 #include "linalg_impl/solve.h"
+#include "linalg_impl/lu.h"
+#include "linalg_impl/qr.h"
+#include "linalg_impl/randomized_svd.h"
 #include "linalg_impl/lstsq.h"
+#include "linalg_impl/batched_lapack.h"
 // clang-format on
 
 #endif // SCILIB_LINALG_H
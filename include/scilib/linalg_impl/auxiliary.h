@@ -7,11 +7,225 @@
 #ifndef SCILIB_LINALG_AUXILIARY_H
 #define SCILIB_LINALG_AUXILIARY_H
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <gsl/gsl>
 #include <random>
 #include <type_traits>
+#include <utility>
 
 namespace Sci {
+
+namespace __Detail {
+
+//--------------------------------------------------------------------------------------------------
+// Reductions:
+//
+// Exhaustive views with the default accessor are reduced over the flat
+// storage with reduce_lanes independent accumulators, which removes the
+// loop-carried dependency so that the loops vectorize. With a parallel
+// policy, large views are split over the thread pool. Other views are reduced
+// serially. Floating-point sums and products are therefore not accumulated in
+// index order.
+
+inline constexpr std::size_t reduce_lanes = 8;
+
+template <class T, class Extents, class Layout, class Accessor>
+inline auto first_element(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
+{
+    using index_type = typename Extents::index_type;
+
+    auto offset = [&]<std::size_t... Rs>(std::index_sequence<Rs...>)
+    {
+        return v.mapping()((static_cast<void>(Rs), index_type{0})...);
+    };
+    const auto k = offset(std::make_index_sequence<Extents::rank()>());
+    return v.accessor().access(v.data_handle(), k);
+}
+
+// Reduce op(acc, f(x[k])) for k in [first, last), where init is neutral
+// for op or equal to one of the elements for idempotent op.
+template <class T, class Acc, class Transform, class Op>
+inline Acc
+reduce_range(const T* x, std::size_t first, std::size_t last, Acc init, Transform& f, Op& op)
+{
+    Acc acc[reduce_lanes];
+    std::fill_n(acc, reduce_lanes, init);
+
+    std::size_t k = first;
+    for (; k + reduce_lanes <= last; k += reduce_lanes) {
+        for (std::size_t l = 0; l < reduce_lanes; ++l) {
+            acc[l] = op(acc[l], f(x[k + l]));
+        }
+    }
+    for (; k < last; ++k) {
+        acc[0] = op(acc[0], f(x[k]));
+    }
+    for (std::size_t w = reduce_lanes / 2; w > 0; w /= 2) {
+        for (std::size_t l = 0; l < w; ++l) {
+            acc[l] = op(acc[l], acc[l + w]);
+        }
+    }
+    return acc[0];
+}
+
+// Reduce op(acc, f(v[i...])) over all elements of v.
+template <class Policy,
+          class T,
+          class Extents,
+          class Layout,
+          class Accessor,
+          class Acc,
+          class Transform,
+          class Op>
+inline Acc
+reduce(Policy policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v, Acc init, Transform f, Op op)
+{
+    if constexpr (std::is_same_v<Accessor, Kokkos::default_accessor<T>>) {
+        if (v.is_exhaustive()) {
+            const T* x = v.data_handle();
+            const auto n = static_cast<std::size_t>(v.size());
+            return parallel_reduce(
+                policy, n, n, init,
+                [&](std::size_t first, std::size_t last) {
+                    return reduce_range(x, first, last, init, f, op);
+                },
+                op);
+        }
+    }
+    Acc res = init;
+    auto reduce_fn = [&]<class... IndexTypes>(IndexTypes... indices)
+    {
+#if MDSPAN_USE_BRACKET_OPERATOR
+        res = op(res, f(v[indices...]));
+#else
+        res = op(res, f(v(indices...)));
+#endif
+    };
+    for_each_in_extents(reduce_fn, v);
+    return res;
+}
+
+template <class Policy, class T, class Extents, class Layout, class Accessor, class Acc, class Op>
+inline Acc reduce(Policy policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v, Acc init, Op op)
+{
+    return reduce(policy, v, init, [](const T& x) -> const T& { return x; }, op);
+}
+
+// Index and value of the element for which comp(x, y) holds against all
+// others y, taking the first one in row-major order.
+template <class T>
+struct Arg_result {
+    T value;
+    std::size_t index;
+};
+
+template <class T, class Compare>
+inline Arg_result<T> arg_combine(const Arg_result<T>& a, const Arg_result<T>& b, Compare& comp)
+{
+    if (comp(b.value, a.value) || (!comp(a.value, b.value) && b.index < a.index)) {
+        return b;
+    }
+    return a;
+}
+
+template <class T, class Compare>
+inline Arg_result<T>
+arg_reduce_range(const T* x, std::size_t first, std::size_t last, Compare& comp)
+{
+    T val[reduce_lanes];
+    std::size_t idx[reduce_lanes];
+    std::fill_n(val, reduce_lanes, x[first]);
+    std::fill_n(idx, reduce_lanes, first);
+
+    std::size_t k = first;
+    for (; k + reduce_lanes <= last; k += reduce_lanes) {
+        for (std::size_t l = 0; l < reduce_lanes; ++l) {
+            const bool better = comp(x[k + l], val[l]);
+            val[l] = better ? x[k + l] : val[l];
+            idx[l] = better ? k + l : idx[l];
+        }
+    }
+    Arg_result<T> res{val[0], idx[0]};
+    for (std::size_t l = 1; l < reduce_lanes; ++l) {
+        res = arg_combine(res, Arg_result<T>{val[l], idx[l]}, comp);
+    }
+    for (; k < last; ++k) {
+        if (comp(x[k], res.value)) {
+            res = {x[k], k};
+        }
+    }
+    return res;
+}
+
+// Whether the offsets of an exhaustive view follow row-major order.
+template <class T, class Extents, class Layout, class Accessor>
+inline bool is_row_major_contiguous(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
+{
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_right> || Extents::rank() == 0) {
+        return true;
+    }
+    else if constexpr (Layout::template mapping<Extents>::is_always_strided()) {
+        if (!v.is_exhaustive()) {
+            return false;
+        }
+        std::size_t stride = 1;
+        for (std::size_t r = Extents::rank(); r-- > 0;) {
+            if (v.extent(r) > 1 && static_cast<std::size_t>(v.stride(r)) != stride) {
+                return false;
+            }
+            stride *= static_cast<std::size_t>(v.extent(r));
+        }
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+template <class Policy, class T, class Extents, class Layout, class Accessor, class Compare>
+inline std::size_t
+arg_reduce(Policy policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v, Compare comp)
+{
+    using value_type = std::remove_cv_t<T>;
+
+    Expects(v.size() > 0);
+    Arg_result<value_type> init{first_element(v), 0};
+
+    if constexpr (std::is_same_v<Accessor, Kokkos::default_accessor<T>>) {
+        if (is_row_major_contiguous(v)) {
+            const T* x = v.data_handle();
+            const auto n = static_cast<std::size_t>(v.size());
+            auto combine = [&](const auto& a, const auto& b) { return arg_combine(a, b, comp); };
+            return parallel_reduce(
+                       policy, n, n, init,
+                       [&](std::size_t first, std::size_t last) {
+                           return arg_reduce_range(x, first, last, comp);
+                       },
+                       combine)
+                .index;
+        }
+    }
+    std::size_t k = 0;
+    auto reduce_fn = [&]<class... IndexTypes>(IndexTypes... indices)
+    {
+#if MDSPAN_USE_BRACKET_OPERATOR
+        const value_type& x = v[indices...];
+#else
+        const value_type& x = v(indices...);
+#endif
+        if (comp(x, init.value)) {
+            init = {x, k};
+        }
+        ++k;
+    };
+    for_each_in_extents(reduce_fn, v.extents(), Kokkos::layout_right{});
+    return init.index;
+}
+
+} // namespace __Detail
+
 namespace Linalg {
 
 //--------------------------------------------------------------------------------------------------
@@ -99,145 +313,190 @@ inline void clip(Sci::MDArray<T, Extents, Layout, Container>& a, const T& a_min,
 
 //--------------------------------------------------------------------------------------------------
 // Find argmax, argmin, max, min, sum, and product of elements:
+//
+// The functions accept any rank. argmax and argmin return the index of the
+// first extremal element in row-major order, as for the flattened array.
+// The reductions run on the calling thread. An execution policy can be
+// passed first to split large arrays over the thread pool (see execution.h):
+//
+//   auto s = Sci::Linalg::sum(Sci::par, x);
+//
+// The floating-point sum and product are then accumulated in chunks that
+// depend on the size of the pool, hence they may differ in the last bits
+// from the serial result.
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline std::size_t argmax(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> v)
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline std::size_t argmax(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    using index_type = IndexType;
-    using value_type = std::remove_cv_t<T>;
+    return Sci::__Detail::arg_reduce(policy, v, std::greater<>{});
+}
 
-    index_type max_idx = 0;
-    value_type max_val = v[0];
-    for (index_type i = 0; i < v.extent(0); ++i) {
-        if (v[i] > max_val) {
-            max_val = v[i];
-            max_idx = i;
-        }
-    }
-    return max_idx;
+template <class T, class Extents, class Layout, class Accessor>
+inline std::size_t argmax(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
+{
+    return argmax(Sci::execution::seq, v);
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Container>
-    requires(std::is_integral_v<IndexType>)
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
 inline std::size_t
-argmax(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& v)
+argmax(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& v)
 {
-    return argmax(v.to_mdspan());
+    return argmax(policy, v.to_mdspan());
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline std::size_t argmin(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> v)
+template <class T, class Extents, class Layout, class Container>
+inline std::size_t argmax(const Sci::MDArray<T, Extents, Layout, Container>& v)
 {
-    using index_type = IndexType;
-    using value_type = std::remove_cv_t<T>;
+    return argmax(Sci::execution::seq, v.to_mdspan());
+}
 
-    index_type min_idx = 0;
-    value_type min_val = v[0];
-    for (index_type i = 0; i < v.extent(0); ++i) {
-        if (v[i] < min_val) {
-            min_val = v[i];
-            min_idx = i;
-        }
-    }
-    return min_idx;
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline std::size_t argmin(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v)
+{
+    return Sci::__Detail::arg_reduce(policy, v, std::less<>{});
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Container>
-    requires(std::is_integral_v<IndexType>)
+template <class T, class Extents, class Layout, class Accessor>
+inline std::size_t argmin(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
+{
+    return argmin(Sci::execution::seq, v);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
 inline std::size_t
-argmin(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& v)
+argmin(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& v)
 {
-    return argmin(v.to_mdspan());
+    return argmin(policy, v.to_mdspan());
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline auto max(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> v)
+template <class T, class Extents, class Layout, class Container>
+inline std::size_t argmin(const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return argmin(Sci::execution::seq, v.to_mdspan());
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline auto max(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    using index_type = IndexType;
     using value_type = std::remove_cv_t<T>;
 
-    value_type result = v[0];
-    for (index_type i = 0; i < v.extent(0); ++i) {
-        if (v[i] > result) {
-            result = v[i];
-        }
-    }
-    return result;
+    Expects(v.size() > 0);
+    return Sci::__Detail::reduce(policy, v, value_type{Sci::__Detail::first_element(v)},
+                                 [](const value_type& a, const value_type& b) {
+                                     return (b > a) ? b : a;
+                                 });
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Container>
-    requires(std::is_integral_v<IndexType>)
-inline T max(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& v)
+template <class T, class Extents, class Layout, class Accessor>
+inline auto max(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    return max(v.to_mdspan());
+    return max(Sci::execution::seq, v);
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline auto min(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> v)
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline T max(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return max(policy, v.to_mdspan());
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline T max(const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return max(Sci::execution::seq, v.to_mdspan());
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline auto min(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    using index_type = IndexType;
     using value_type = std::remove_cv_t<T>;
 
-    value_type result = v[0];
-    for (index_type i = 0; i < v.extent(0); ++i) {
-        if (v[i] < result) {
-            result = v[i];
-        }
-    }
-    return result;
+    Expects(v.size() > 0);
+    return Sci::__Detail::reduce(policy, v, value_type{Sci::__Detail::first_element(v)},
+                                 [](const value_type& a, const value_type& b) {
+                                     return (b < a) ? b : a;
+                                 });
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Container>
-    requires(std::is_integral_v<IndexType>)
-inline T min(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& v)
+template <class T, class Extents, class Layout, class Accessor>
+inline auto min(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    return min(v.to_mdspan());
+    return min(Sci::execution::seq, v);
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline auto sum(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> v)
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline T min(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return min(policy, v.to_mdspan());
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline T min(const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return min(Sci::execution::seq, v.to_mdspan());
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline auto sum(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    using index_type = IndexType;
     using value_type = std::remove_cv_t<T>;
 
-    value_type result = 0;
-    for (index_type i = 0; i < v.extent(0); ++i) {
-        result += v[i];
-    }
-    return result;
+    return Sci::__Detail::reduce(policy, v, value_type{0}, std::plus<>{});
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Container>
-    requires(std::is_integral_v<IndexType>)
-inline T sum(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& v)
+template <class T, class Extents, class Layout, class Accessor>
+inline auto sum(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    return sum(v.to_mdspan());
+    return sum(Sci::execution::seq, v);
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline auto prod(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> v)
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline T sum(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return sum(policy, v.to_mdspan());
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline T sum(const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return sum(Sci::execution::seq, v.to_mdspan());
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline auto prod(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    using index_type = IndexType;
     using value_type = std::remove_cv_t<T>;
 
-    value_type result = 1;
-    for (index_type i = 0; i < v.extent(0); ++i) {
-        result *= v[i];
-    }
-    return result;
+    return Sci::__Detail::reduce(policy, v, value_type{1}, std::multiplies<>{});
 }
 
-template <class T, class IndexType, std::size_t ext, class Layout, class Container>
-    requires(std::is_integral_v<IndexType>)
-inline T prod(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& v)
+template <class T, class Extents, class Layout, class Accessor>
+inline auto prod(Kokkos::mdspan<T, Extents, Layout, Accessor> v)
 {
-    return prod(v.to_mdspan());
+    return prod(Sci::execution::seq, v);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline T prod(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return prod(policy, v.to_mdspan());
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline T prod(const Sci::MDArray<T, Extents, Layout, Container>& v)
+{
+    return prod(Sci::execution::seq, v.to_mdspan());
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -248,9 +507,8 @@ template <class M, class... IndexTypes>
 inline M zeros(IndexTypes... exts)
 {
     using extents_type = typename M::extents_type;
-    using value_type = typename M::value_type;
 
-    return M(extents_type(exts...), value_type{0});
+    return M(Sci::zero_pages, extents_type(exts...));
 }
 
 template <class M, class... IndexTypes>
@@ -270,7 +528,7 @@ inline M identity(std::size_t n)
     using value_type = typename M::value_type;
     using index_type = typename M::index_type;
 
-    M res(n, n);
+    M res(Sci::zero_pages, n, n);
     auto res_diag = Sci::diag(res.to_mdspan());
     for (index_type i = 0; i < res_diag.extent(0); ++i) {
         res_diag[i] = value_type{1};
@@ -291,7 +549,7 @@ inline M randn(IndexTypes... exts)
     std::mt19937_64 gen{rd()};
     std::normal_distribution<value_type> nd{};
 
-    M res(exts...);
+    M res(Sci::uninitialized, exts...);
     res.apply([&](value_type& x) { x = nd(gen); });
     return res;
 }
@@ -309,7 +567,7 @@ inline M randu(IndexTypes... exts)
     std::mt19937_64 gen{rd()};
     std::uniform_real_distribution<value_type> ur{};
 
-    M res(exts...);
+    M res(Sci::uninitialized, exts...);
     res.apply([&](value_type& x) { x = ur(gen); });
     return res;
 }
@@ -327,7 +585,7 @@ inline M randi(IndexTypes... exts)
     std::mt19937_64 gen{rd()};
     std::uniform_int_distribution<value_type> ui{};
 
-    M res(exts...);
+    M res(Sci::uninitialized, exts...);
     res.apply([&](value_type& x) { x = ui(gen); });
     return res;
 }
@@ -385,6 +643,98 @@ void to_lower_triangular(
     to_lower_triangular(a.to_mdspan());
 }
 
+// Expression operands are evaluated before they are reduced.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto argmax(const E& e)
+{
+    return argmax(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { argmax(p, Sci::__Detail::eval(e)); })
+inline auto argmax(P&& p, const E& e)
+{
+    return argmax(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto argmin(const E& e)
+{
+    return argmin(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { argmin(p, Sci::__Detail::eval(e)); })
+inline auto argmin(P&& p, const E& e)
+{
+    return argmin(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto max(const E& e)
+{
+    return max(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { max(p, Sci::__Detail::eval(e)); })
+inline auto max(P&& p, const E& e)
+{
+    return max(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto min(const E& e)
+{
+    return min(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { min(p, Sci::__Detail::eval(e)); })
+inline auto min(P&& p, const E& e)
+{
+    return min(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto sum(const E& e)
+{
+    return sum(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { sum(p, Sci::__Detail::eval(e)); })
+inline auto sum(P&& p, const E& e)
+{
+    return sum(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto prod(const E& e)
+{
+    return prod(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { prod(p, Sci::__Detail::eval(e)); })
+inline auto prod(P&& p, const E& e)
+{
+    return prod(p, Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
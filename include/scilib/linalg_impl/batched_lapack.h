@@ -0,0 +1,370 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_BATCHED_LAPACK_H
+#define SCILIB_LINALG_BATCHED_LAPACK_H
+
+#include "lapack_types.h"
+#include <algorithm>
+#include <cstddef>
+#include <gsl/gsl>
+#include <type_traits>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// Batched LAPACK drivers:
+//
+// Solve a batch of independent, typically small, problems stored as rank-3
+// arrays (batch x rows x cols). The batch is split across the default
+// thread pool with one problem at a time per thread; LAPACK's own threading
+// does not pay off for such sizes. Each thread copies its problem into
+// column-major scratch arrays taken from a thread-local workspace, which is
+// reused for all problems of the thread, and calls the LAPACKE _work
+// routines, so no memory is allocated per problem. With MKL the BLAS
+// threading is disabled inside the worker threads.
+//
+// A failure does not abort the batch. Instead, the LAPACK status of each
+// problem is returned in a vector of info codes, where info[q] == 0 means
+// success, and the output for a failed problem is unspecified.
+
+namespace __Detail {
+
+template <class T>
+constexpr std::size_t scratch_bytes(std::size_t count)
+{
+    return count * sizeof(T) + Sci::Workspace::alignment;
+}
+
+// Call f(q) for q in [0, nbatch). Each chunk of the batch installs a
+// workspace with the given capacity for the scratch arrays of f.
+template <class IndexType, class Callable>
+void for_each_problem(IndexType nbatch, std::size_t nelem, std::size_t capacity, Callable&& f)
+{
+    Sci::__Detail::parallel_for(Sci::par, nbatch, nelem, [&](IndexType first, IndexType last) {
+#ifdef USE_MKL
+        const int nthreads = mkl_set_num_threads_local(1);
+#endif
+        Sci::Workspace ws(capacity);
+        Sci::Workspace_scope scope(ws);
+        for (IndexType q = first; q < last; ++q) {
+            f(q);
+        }
+#ifdef USE_MKL
+        mkl_set_num_threads_local(nthreads);
+#endif
+    });
+}
+
+template <class IndexType>
+inline std::size_t batched_work(IndexType nbatch, IndexType n)
+{
+    return static_cast<std::size_t>(nbatch) * static_cast<std::size_t>(n) *
+           static_cast<std::size_t>(n) * static_cast<std::size_t>(n);
+}
+
+} // namespace __Detail
+
+// Eigenvalues and eigenvectors of a batch of real symmetric matrices. On
+// exit w(q, :) holds the eigenvalues of a(q, :, :) in ascending order and
+// the columns of a(q, :, :) the corresponding eigenvectors.
+template <class IndexType_a,
+          std::size_t nb_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout_a,
+          class Accessor_a,
+          class IndexType_w,
+          std::size_t nb_w,
+          std::size_t ext_w,
+          class Layout_w,
+          class Accessor_w>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_w>)
+Sci::Vector<BLAS_INT> batched_eigh(
+    Kokkos::mdspan<double,
+                   Kokkos::extents<IndexType_a, nb_a, nrows_a, ncols_a>,
+                   Layout_a,
+                   Accessor_a> a,
+    Kokkos::mdspan<double, Kokkos::extents<IndexType_w, nb_w, ext_w>, Layout_w, Accessor_w> w,
+    char uplo = 'U',
+    double abstol = -1.0 /* use default value */)
+{
+    using index_type = IndexType_a;
+
+    Expects(a.extent(1) == a.extent(2));
+    Expects(w.extent(0) == a.extent(0) && w.extent(1) == a.extent(1));
+
+    const auto nbatch = static_cast<index_type>(a.extent(0));
+    const auto n = static_cast<index_type>(a.extent(1));
+
+    Sci::Vector<BLAS_INT> info(nbatch);
+    if (nbatch == 0 || n == 0) {
+        return info;
+    }
+    const BLAS_INT ld = gsl::narrow_cast<BLAS_INT>(n);
+
+    // Workspace query; the optimal sizes only depend on n.
+    BLAS_INT m;
+    BLAS_INT liwork;
+    double lwork;
+    LAPACKE_dsyevr_work(LAPACK_COL_MAJOR, 'V', 'A', uplo, ld, nullptr, ld, 0.0, 0.0, 1, ld, abstol,
+                        &m, nullptr, nullptr, ld, nullptr, &lwork, -1, &liwork, -1);
+    const auto nwork = static_cast<BLAS_INT>(lwork);
+    const auto nn = static_cast<std::size_t>(n) * static_cast<std::size_t>(n);
+
+    const std::size_t capacity = 2 * __Detail::scratch_bytes<double>(nn) +
+                                 __Detail::scratch_bytes<double>(n) +
+                                 __Detail::scratch_bytes<double>(nwork) +
+                                 __Detail::scratch_bytes<BLAS_INT>(2 * n + liwork);
+
+    const auto nelem = __Detail::batched_work(nbatch, n);
+    __Detail::for_each_problem(nbatch, nelem, capacity, [&](index_type q) {
+        auto aq = Kokkos::submdspan(a, q, Kokkos::full_extent, Kokkos::full_extent);
+        auto wq = Kokkos::submdspan(w, q, Kokkos::full_extent);
+
+        auto ac = Sci::make_scratch<double, Kokkos::layout_left>(n, n);
+        auto z = Sci::make_scratch<double, Kokkos::layout_left>(n, n);
+        auto wc = Sci::make_scratch<double>(n);
+        auto work = Sci::make_scratch<double>(nwork);
+        auto iwork = Sci::make_scratch<BLAS_INT>(2 * n + liwork);
+        Sci::copy(aq, ac.to_mdspan());
+
+        BLAS_INT mq;
+        info(q) = LAPACKE_dsyevr_work(LAPACK_COL_MAJOR, 'V', 'A', uplo, ld, ac.container_data(), ld,
+                                      0.0, 0.0, 1, ld, abstol, &mq, wc.container_data(),
+                                      z.container_data(), ld, iwork.container_data(),
+                                      work.container_data(), nwork,
+                                      iwork.container_data() + 2 * n, liwork);
+        if (info(q) == 0) {
+            Sci::copy(z.to_mdspan(), aq);
+            Sci::copy(wc.to_mdspan(), wq);
+        }
+    });
+    return info;
+}
+
+template <class Layout>
+inline Sci::Vector<BLAS_INT> batched_eigh(Sci::Array3D<double, Layout>& a,
+                                          Sci::Matrix<double, Layout>& w,
+                                          char uplo = 'U',
+                                          double abstol = -1.0 /* use default value */)
+{
+    return batched_eigh(a.to_mdspan(), w.to_mdspan(), uplo, abstol);
+}
+
+// Solve a(q, :, :) * x(q, :, :) = b(q, :, :) for a batch of general square
+// matrices. On exit b(q, :, :) holds the solution and a(q, :, :) the LU
+// factors of a(q, :, :), as for solve().
+template <class IndexType_a,
+          std::size_t nb_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout_a,
+          class Accessor_a,
+          class IndexType_b,
+          std::size_t nb_b,
+          std::size_t nrows_b,
+          std::size_t ncols_b,
+          class Layout_b,
+          class Accessor_b>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_b>)
+Sci::Vector<BLAS_INT> batched_solve(
+    Kokkos::mdspan<double,
+                   Kokkos::extents<IndexType_a, nb_a, nrows_a, ncols_a>,
+                   Layout_a,
+                   Accessor_a> a,
+    Kokkos::mdspan<double,
+                   Kokkos::extents<IndexType_b, nb_b, nrows_b, ncols_b>,
+                   Layout_b,
+                   Accessor_b> b)
+{
+    using index_type = IndexType_a;
+
+    Expects(a.extent(1) == a.extent(2));
+    Expects(b.extent(0) == a.extent(0) && b.extent(1) == a.extent(1));
+
+    const auto nbatch = static_cast<index_type>(a.extent(0));
+    const auto n = static_cast<index_type>(a.extent(1));
+    const auto nrhs = static_cast<index_type>(b.extent(2));
+
+    Sci::Vector<BLAS_INT> info(nbatch);
+    if (nbatch == 0 || n == 0) {
+        return info;
+    }
+    const BLAS_INT ld = gsl::narrow_cast<BLAS_INT>(n);
+    const auto nn = static_cast<std::size_t>(n) * static_cast<std::size_t>(n);
+
+    const std::size_t capacity =
+        __Detail::scratch_bytes<double>(nn) +
+        __Detail::scratch_bytes<double>(static_cast<std::size_t>(n) * nrhs) +
+        __Detail::scratch_bytes<BLAS_INT>(n);
+
+    const auto nelem = __Detail::batched_work(nbatch, n);
+    __Detail::for_each_problem(nbatch, nelem, capacity, [&](index_type q) {
+        auto aq = Kokkos::submdspan(a, q, Kokkos::full_extent, Kokkos::full_extent);
+        auto bq = Kokkos::submdspan(b, q, Kokkos::full_extent, Kokkos::full_extent);
+
+        auto ac = Sci::make_scratch<double, Kokkos::layout_left>(n, n);
+        auto bc = Sci::make_scratch<double, Kokkos::layout_left>(n, nrhs);
+        auto ipiv = Sci::make_scratch<BLAS_INT>(n);
+        Sci::copy(aq, ac.to_mdspan());
+        Sci::copy(bq, bc.to_mdspan());
+
+        info(q) = LAPACKE_dgetrf_work(LAPACK_COL_MAJOR, ld, ld, ac.container_data(), ld,
+                                      ipiv.container_data());
+        if (info(q) == 0) {
+            info(q) = LAPACKE_dgetrs_work(LAPACK_COL_MAJOR, 'N', ld,
+                                          gsl::narrow_cast<BLAS_INT>(nrhs), ac.container_data(),
+                                          ld, ipiv.container_data(), bc.container_data(), ld);
+        }
+        Sci::copy(ac.to_mdspan(), aq);
+        if (info(q) == 0) {
+            Sci::copy(bc.to_mdspan(), bq);
+        }
+    });
+    return info;
+}
+
+template <class Layout>
+inline Sci::Vector<BLAS_INT> batched_solve(Sci::Array3D<double, Layout>& a,
+                                           Sci::Array3D<double, Layout>& b)
+{
+    return batched_solve(a.to_mdspan(), b.to_mdspan());
+}
+
+// Cholesky factorization of a batch of symmetric positive definite matrices.
+// On exit a(q, :, :) holds the lower triangular factor, as for cholesky().
+template <class IndexType,
+          std::size_t nb,
+          std::size_t nrows,
+          std::size_t ncols,
+          class Layout,
+          class Accessor>
+    requires(std::is_integral_v<IndexType>)
+Sci::Vector<BLAS_INT> batched_cholesky(
+    Kokkos::mdspan<double, Kokkos::extents<IndexType, nb, nrows, ncols>, Layout, Accessor> a)
+{
+    using index_type = IndexType;
+
+    Expects(a.extent(1) == a.extent(2));
+
+    const auto nbatch = static_cast<index_type>(a.extent(0));
+    const auto n = static_cast<index_type>(a.extent(1));
+
+    Sci::Vector<BLAS_INT> info(nbatch);
+    if (nbatch == 0 || n == 0) {
+        return info;
+    }
+    const BLAS_INT ld = gsl::narrow_cast<BLAS_INT>(n);
+    const auto nn = static_cast<std::size_t>(n) * static_cast<std::size_t>(n);
+
+    __Detail::for_each_problem(
+        nbatch, __Detail::batched_work(nbatch, n), __Detail::scratch_bytes<double>(nn),
+        [&](index_type q) {
+            auto aq = Kokkos::submdspan(a, q, Kokkos::full_extent, Kokkos::full_extent);
+
+            auto ac = Sci::make_scratch<double, Kokkos::layout_left>(n, n);
+            Sci::copy(aq, ac.to_mdspan());
+
+            info(q) = LAPACKE_dpotrf_work(LAPACK_COL_MAJOR, 'L', ld, ac.container_data(), ld);
+            if (info(q) == 0) {
+                to_lower_triangular(ac.to_mdspan());
+                Sci::copy(ac.to_mdspan(), aq);
+            }
+        });
+    return info;
+}
+
+template <class Layout>
+inline Sci::Vector<BLAS_INT> batched_cholesky(Sci::Array3D<double, Layout>& a)
+{
+    return batched_cholesky(a.to_mdspan());
+}
+
+// Inverse of a batch of general square matrices: res(q, :, :) = inv(a(q, :, :)).
+template <class T_a,
+          class IndexType_a,
+          std::size_t nb_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout_a,
+          class Accessor_a,
+          class IndexType_res,
+          std::size_t nb_res,
+          std::size_t nrows_res,
+          std::size_t ncols_res,
+          class Layout_res,
+          class Accessor_res>
+    requires(std::is_same_v<std::remove_cv_t<T_a>, double>&& std::is_integral_v<IndexType_a>&&
+                 std::is_integral_v<IndexType_res>)
+Sci::Vector<BLAS_INT> batched_inv(
+    Kokkos::mdspan<T_a, Kokkos::extents<IndexType_a, nb_a, nrows_a, ncols_a>, Layout_a, Accessor_a>
+        a,
+    Kokkos::mdspan<double,
+                   Kokkos::extents<IndexType_res, nb_res, nrows_res, ncols_res>,
+                   Layout_res,
+                   Accessor_res> res)
+{
+    using index_type = IndexType_a;
+
+    Expects(a.extent(1) == a.extent(2));
+    Expects(res.extent(0) == a.extent(0) && res.extent(1) == a.extent(1) &&
+            res.extent(2) == a.extent(2));
+
+    const auto nbatch = static_cast<index_type>(a.extent(0));
+    const auto n = static_cast<index_type>(a.extent(1));
+
+    Sci::Vector<BLAS_INT> info(nbatch);
+    if (nbatch == 0 || n == 0) {
+        return info;
+    }
+    const BLAS_INT ld = gsl::narrow_cast<BLAS_INT>(n);
+
+    // Workspace query; the optimal size only depends on n.
+    double lwork;
+    LAPACKE_dgetri_work(LAPACK_COL_MAJOR, ld, nullptr, ld, nullptr, &lwork, -1);
+    const auto nwork = std::max<BLAS_INT>(ld, static_cast<BLAS_INT>(lwork));
+    const auto nn = static_cast<std::size_t>(n) * static_cast<std::size_t>(n);
+
+    const std::size_t capacity = __Detail::scratch_bytes<double>(nn) +
+                                 __Detail::scratch_bytes<double>(nwork) +
+                                 __Detail::scratch_bytes<BLAS_INT>(n);
+
+    const auto nelem = __Detail::batched_work(nbatch, n);
+    __Detail::for_each_problem(nbatch, nelem, capacity, [&](index_type q) {
+        auto aq = Kokkos::submdspan(a, q, Kokkos::full_extent, Kokkos::full_extent);
+        auto rq = Kokkos::submdspan(res, q, Kokkos::full_extent, Kokkos::full_extent);
+
+        auto ac = Sci::make_scratch<double, Kokkos::layout_left>(n, n);
+        auto work = Sci::make_scratch<double>(nwork);
+        auto ipiv = Sci::make_scratch<BLAS_INT>(n);
+        Sci::copy(aq, ac.to_mdspan());
+
+        info(q) = LAPACKE_dgetrf_work(LAPACK_COL_MAJOR, ld, ld, ac.container_data(), ld,
+                                      ipiv.container_data());
+        if (info(q) == 0) {
+            info(q) = LAPACKE_dgetri_work(LAPACK_COL_MAJOR, ld, ac.container_data(), ld,
+                                          ipiv.container_data(), work.container_data(), nwork);
+        }
+        if (info(q) == 0) {
+            Sci::copy(ac.to_mdspan(), rq);
+        }
+    });
+    return info;
+}
+
+template <class Layout>
+inline Sci::Vector<BLAS_INT> batched_inv(const Sci::Array3D<double, Layout>& a,
+                                         Sci::Array3D<double, Layout>& res)
+{
+    return batched_inv(a.to_mdspan(), res.to_mdspan());
+}
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_BATCHED_LAPACK_H
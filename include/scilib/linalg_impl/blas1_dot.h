@@ -32,6 +32,19 @@ dot(const Sci::MDArray<T_x, Kokkos::extents<IndexType_x, ext_x>, Layout_x, Conta
     return Kokkos::Experimental::linalg::dot(x.to_mdspan(), y.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E1, class E2>
+    requires((Sci::__Detail::Is_expression_v<E1> || Sci::__Detail::Is_expression_v<E2>) &&
+             Sci::__Detail::Is_mdarray_operand_v<E1> && Sci::__Detail::Is_mdarray_operand_v<E2> &&
+             requires(const E1& a, const E2& b) {
+                 dot(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+             })
+inline auto dot(const E1& a, const E2& b)
+{
+    return dot(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -21,6 +21,15 @@ idx_abs_max(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Conta
     return Kokkos::Experimental::linalg::vector_idx_abs_max(x.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto idx_abs_max(const E& e)
+{
+    return idx_abs_max(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -40,6 +40,15 @@ idx_abs_min(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Conta
     return idx_abs_min(x.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto idx_abs_min(const E& e)
+{
+    return idx_abs_min(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -19,6 +19,15 @@ inline T vector_abs_sum(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, L
     return Kokkos::Experimental::linalg::vector_abs_sum(x.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto vector_abs_sum(const E& e)
+{
+    return vector_abs_sum(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -19,6 +19,15 @@ inline T vector_norm2(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Lay
     return Kokkos::Experimental::linalg::vector_two_norm(x.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto vector_norm2(const E& e)
+{
+    return vector_norm2(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -8,6 +8,7 @@
 #define SCILIB_LINALG_BLAS2_MATRIX_VECTOR_PRODUCT_H
 
 #include "lapack_types.h"
+#include "static_kernels.h"
 #include <cassert>
 #include <complex>
 #include <experimental/linalg>
@@ -41,6 +42,10 @@ inline void matrix_vector_product(
     Kokkos::mdspan<T_x, Kokkos::extents<IndexType_x, ext_x>, Layout_x, Accessor_x> x,
     Kokkos::mdspan<T_y, Kokkos::extents<IndexType_y, ext_y>, Layout_y, Accessor_y> y)
 {
+    if constexpr (Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, ext_x, ext_y>) {
+        Sci::__Detail::static_matrix_vector_product(a, x, y);
+        return;
+    }
     Kokkos::Experimental::linalg::matrix_vector_product(a, x, y);
 }
 
@@ -66,6 +71,11 @@ inline void matrix_vector_product(
 {
     static_assert(x.static_extent(0) == a.static_extent(1));
 
+    if constexpr (Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, ext_x, ext_y>) {
+        Sci::__Detail::static_matrix_vector_product(a, x, y);
+        return;
+    }
+
     constexpr double alpha = 1.0;
     constexpr double beta = 0.0;
 
@@ -108,6 +118,11 @@ inline void matrix_vector_product(
 {
     static_assert(x.static_extent(0) == a.static_extent(1));
 
+    if constexpr (Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, ext_x, ext_y>) {
+        Sci::__Detail::static_matrix_vector_product(a, x, y);
+        return;
+    }
+
     constexpr double alpha = 1.0;
     constexpr double beta = 0.0;
 
@@ -152,6 +167,11 @@ inline void matrix_vector_product(
 {
     static_assert(x.static_extent(0) == a.static_extent(1));
 
+    if constexpr (Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, ext_x, ext_y>) {
+        Sci::__Detail::static_matrix_vector_product(a, x, y);
+        return;
+    }
+
     constexpr std::complex<double> alpha = {1.0, 0.0};
     constexpr std::complex<double> beta = {0.0, 0.0};
 
@@ -198,6 +218,11 @@ inline void matrix_vector_product(
 {
     static_assert(x.static_extent(0) == a.static_extent(1));
 
+    if constexpr (Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, ext_x, ext_y>) {
+        Sci::__Detail::static_matrix_vector_product(a, x, y);
+        return;
+    }
+
     constexpr std::complex<double> alpha = {1.0, 0.0};
     constexpr std::complex<double> beta = {0.0, 0.0};
 
@@ -254,6 +279,38 @@ inline Sci::Vector<T, Layout> matrix_vector_product(const Sci::Matrix<T, Layout>
     return res;
 }
 
+template <class T,
+          class IndexType,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Container_a,
+          class Container_x>
+    requires(Sci::__Detail::Is_small_static_v<nrows_a, ncols_a>)
+constexpr auto matrix_vector_product(
+    const Sci::MDArray<T, Kokkos::extents<IndexType, nrows_a, ncols_a>, Layout, Container_a>& a,
+    const Sci::MDArray<T, Kokkos::extents<IndexType, ncols_a>, Layout, Container_x>& x)
+{
+    using extents_type = Kokkos::extents<IndexType, nrows_a>;
+
+    Sci::MDArray<T, extents_type, Layout, std::array<T, nrows_a>> res(extents_type{});
+    Sci::__Detail::static_matrix_vector_product(a.to_mdspan(), x.to_mdspan(), res.to_mdspan());
+    return res;
+}
+
+// Expression operands are evaluated first.
+
+template <class E1, class E2>
+    requires((Sci::__Detail::Is_expression_v<E1> || Sci::__Detail::Is_expression_v<E2>) &&
+             Sci::__Detail::Is_mdarray_operand_v<E1> && Sci::__Detail::Is_mdarray_operand_v<E2> &&
+             requires(const E1& a, const E2& b) {
+                 matrix_vector_product(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+             })
+inline auto matrix_vector_product(const E1& a, const E2& b)
+{
+    return matrix_vector_product(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
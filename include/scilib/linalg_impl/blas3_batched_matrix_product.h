@@ -0,0 +1,408 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_BLAS3_BATCHED_MATRIX_PRODUCT_H
+#define SCILIB_LINALG_BLAS3_BATCHED_MATRIX_PRODUCT_H
+
+#include "lapack_types.h"
+#include <algorithm>
+#include <cstddef>
+#include <gsl/gsl>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// Batched matrix-matrix products:
+//
+// c[q] = a[q] * b[q] for a batch of independent, typically small, matrices.
+// The batch is given either as rank-3 arrays (batch x rows x cols), or as
+// ranges of matrix views which may differ in size. With MKL the products of
+// dense double precision matrices map to cblas_dgemm_batch_strided and
+// cblas_dgemm_batch. Otherwise the batch is split across the default thread
+// pool, and each product is computed by a kernel that accumulates blocks of
+// c in registers. Matrices with neither contiguous rows nor columns, such as
+// the slices of column-major rank-3 arrays, are first packed into row-major
+// buffers. The matrices c[q] must not overlap a[q] or b[q].
+
+namespace __Detail {
+
+// Number of columns of c in each block of the product kernel: 64 bytes, that
+// is one AVX-512 register or two AVX2 registers.
+template <class T>
+inline constexpr std::size_t Gemm_block_cols_v = std::max<std::size_t>(1, 64 / sizeof(T));
+
+// c(0:MR, 0:NR) = a(0:MR, :) * b(:, 0:NR). The block of c is accumulated in
+// registers; each step of k broadcasts one element of a for each row and
+// loads one row of b. For float and double the rows are GCC/Clang vector
+// types, since the loop vectorizer would instead vectorize the plain loops
+// over k with gathers from a, which is several times slower.
+template <std::size_t MR, std::size_t NR, class T_a, class T_b, class T_c, class IndexType>
+SCILIB_TARGET_CLONES inline void gemm_block(
+    IndexType p, const T_a* a, IndexType lda, const T_b* b, IndexType ldb, T_c* c, IndexType ldc)
+{
+#if defined(__GNUC__)
+    if constexpr (std::is_same_v<T_c, double> || std::is_same_v<T_c, float>) {
+        typedef T_c row_type __attribute__((vector_size(NR * sizeof(T_c))));
+
+        row_type acc[MR] = {};
+        for (IndexType k = 0; k < p; ++k) {
+            const T_b* bk = b + k * ldb;
+            row_type bv;
+            for (std::size_t j = 0; j < NR; ++j) {
+                bv[j] = static_cast<T_c>(bk[j]);
+            }
+            for (std::size_t i = 0; i < MR; ++i) {
+                acc[i] += static_cast<T_c>(a[static_cast<IndexType>(i) * lda + k]) * bv;
+            }
+        }
+        for (std::size_t i = 0; i < MR; ++i) {
+            for (std::size_t j = 0; j < NR; ++j) {
+                c[static_cast<IndexType>(i) * ldc + static_cast<IndexType>(j)] = acc[i][j];
+            }
+        }
+        return;
+    }
+#endif
+    T_c acc[MR][NR] = {};
+    for (IndexType k = 0; k < p; ++k) {
+        const T_b* bk = b + k * ldb;
+        for (std::size_t i = 0; i < MR; ++i) {
+            const T_c aik = a[static_cast<IndexType>(i) * lda + k];
+            for (std::size_t j = 0; j < NR; ++j) {
+                acc[i][j] += aik * bk[j];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t j = 0; j < NR; ++j) {
+            c[static_cast<IndexType>(i) * ldc + static_cast<IndexType>(j)] = acc[i][j];
+        }
+    }
+}
+
+// c = a * b for row-major m x p a, p x n b and m x n c.
+template <class T_a, class T_b, class T_c, class IndexType>
+void gemm_row_major(IndexType m,
+                    IndexType n,
+                    IndexType p,
+                    const T_a* a,
+                    IndexType lda,
+                    const T_b* b,
+                    IndexType ldb,
+                    T_c* c,
+                    IndexType ldc)
+{
+    constexpr std::size_t mr = 4;
+    constexpr std::size_t nr = Gemm_block_cols_v<T_c>;
+
+    const IndexType nb = n / static_cast<IndexType>(nr) * static_cast<IndexType>(nr);
+    for (IndexType j = 0; j < nb; j += static_cast<IndexType>(nr)) {
+        IndexType i = 0;
+        for (; i + static_cast<IndexType>(mr) <= m; i += static_cast<IndexType>(mr)) {
+            gemm_block<mr, nr>(p, a + i * lda, lda, b + j, ldb, c + i * ldc + j, ldc);
+        }
+        for (; i < m; ++i) {
+            gemm_block<1, nr>(p, a + i * lda, lda, b + j, ldb, c + i * ldc + j, ldc);
+        }
+    }
+    if (nb == n) {
+        return;
+    }
+    // Remaining columns, one row of c at a time.
+    for (IndexType i = 0; i < m; ++i) {
+        T_c* ci = c + i * ldc;
+        for (IndexType j = nb; j < n; ++j) {
+            ci[j] = T_c{0};
+        }
+        for (IndexType k = 0; k < p; ++k) {
+            const T_a aik = a[i * lda + k];
+            const T_b* bk = b + k * ldb;
+            SCILIB_VECTORIZE_LOOP
+            for (IndexType j = nb; j < n; ++j) {
+                ci[j] += aik * bk[j];
+            }
+        }
+    }
+}
+
+// c = a * b for one product of the batch. Views where neither the rows nor
+// the columns are contiguous, such as the slices of column-major rank-3
+// arrays, are packed into the row-major scratch buffer buf.
+template <class MDSpanA, class MDSpanB, class MDSpanC, class T>
+void gemm_item(MDSpanA a, MDSpanB b, MDSpanC c, std::vector<T>& buf)
+{
+    using index_type = typename MDSpanC::index_type;
+
+    const auto m = static_cast<index_type>(c.extent(0));
+    const auto n = static_cast<index_type>(c.extent(1));
+    const auto p = static_cast<index_type>(a.extent(1));
+
+    constexpr bool is_pointer_access =
+        std::is_same_v<typename MDSpanA::accessor_type,
+                       Kokkos::default_accessor<typename MDSpanA::element_type>> &&
+        std::is_same_v<typename MDSpanB::accessor_type,
+                       Kokkos::default_accessor<typename MDSpanB::element_type>> &&
+        std::is_same_v<typename MDSpanC::accessor_type,
+                       Kokkos::default_accessor<typename MDSpanC::element_type>>;
+
+    if constexpr (is_pointer_access && MDSpanA::is_always_strided() &&
+                  MDSpanB::is_always_strided() && MDSpanC::is_always_strided()) {
+        auto stride = [](const auto& x, std::size_t r) {
+            return static_cast<index_type>(x.stride(r));
+        };
+        if (stride(a, 1) == 1 && stride(b, 1) == 1 && stride(c, 1) == 1) {
+            gemm_row_major(m, n, p, a.data_handle(), stride(a, 0), b.data_handle(), stride(b, 0),
+                           c.data_handle(), stride(c, 0));
+            return;
+        }
+        if (stride(a, 0) == 1 && stride(b, 0) == 1 && stride(c, 0) == 1) { // c' = b' * a'
+            gemm_row_major(n, m, p, b.data_handle(), stride(b, 1), a.data_handle(), stride(a, 1),
+                           c.data_handle(), stride(c, 1));
+            return;
+        }
+        const auto mu = static_cast<std::size_t>(m);
+        const auto nu = static_cast<std::size_t>(n);
+        const auto pu = static_cast<std::size_t>(p);
+        buf.resize(mu * pu + pu * nu + mu * nu);
+        T* ap = buf.data();
+        T* bp = ap + mu * pu;
+        T* cp = bp + pu * nu;
+        for (index_type i = 0; i < m; ++i) {
+            for (index_type k = 0; k < p; ++k) {
+                ap[i * p + k] = static_cast<T>(a(i, k));
+            }
+        }
+        for (index_type k = 0; k < p; ++k) {
+            for (index_type j = 0; j < n; ++j) {
+                bp[k * n + j] = static_cast<T>(b(k, j));
+            }
+        }
+        gemm_row_major(m, n, p, ap, p, bp, n, cp, n);
+        for (index_type i = 0; i < m; ++i) {
+            for (index_type j = 0; j < n; ++j) {
+                c(i, j) = cp[i * n + j];
+            }
+        }
+        return;
+    }
+    using value_type = typename MDSpanC::value_type;
+    for (index_type i = 0; i < m; ++i) {
+        for (index_type j = 0; j < n; ++j) {
+            value_type s{0};
+            for (index_type k = 0; k < p; ++k) {
+                s += a(i, k) * b(k, j);
+            }
+            c(i, j) = s;
+        }
+    }
+}
+
+template <class MDSpanA, class MDSpanB, class MDSpanC>
+inline void gemm_item(MDSpanA a, MDSpanB b, MDSpanC c)
+{
+    std::vector<typename MDSpanC::value_type> buf;
+    gemm_item(a, b, c, buf);
+}
+
+template <class MDSpan>
+inline constexpr bool Is_blas_matrix_v =
+    std::is_same_v<std::remove_cv_t<typename MDSpan::element_type>, double> &&
+    std::is_same_v<typename MDSpan::accessor_type,
+                   Kokkos::default_accessor<typename MDSpan::element_type>> &&
+    (std::is_same_v<typename MDSpan::layout_type, Kokkos::layout_right> ||
+     std::is_same_v<typename MDSpan::layout_type, Kokkos::layout_left>);
+
+} // namespace __Detail
+
+// Strided batch: c(q, :, :) = a(q, :, :) * b(q, :, :).
+template <class T_a,
+          class IndexType_a,
+          std::size_t nb_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout_a,
+          class Accessor_a,
+          class T_b,
+          class IndexType_b,
+          std::size_t nb_b,
+          std::size_t nrows_b,
+          std::size_t ncols_b,
+          class Layout_b,
+          class Accessor_b,
+          class T_c,
+          class IndexType_c,
+          std::size_t nb_c,
+          std::size_t nrows_c,
+          std::size_t ncols_c,
+          class Layout_c,
+          class Accessor_c>
+    requires(!std::is_const_v<T_c> && std::is_integral_v<IndexType_a> &&
+             std::is_integral_v<IndexType_b> && std::is_integral_v<IndexType_c>)
+void batched_matrix_product(
+    Kokkos::mdspan<T_a, Kokkos::extents<IndexType_a, nb_a, nrows_a, ncols_a>, Layout_a, Accessor_a>
+        a,
+    Kokkos::mdspan<T_b, Kokkos::extents<IndexType_b, nb_b, nrows_b, ncols_b>, Layout_b, Accessor_b>
+        b,
+    Kokkos::mdspan<T_c, Kokkos::extents<IndexType_c, nb_c, nrows_c, ncols_c>, Layout_c, Accessor_c>
+        c)
+{
+    using index_type = IndexType_c;
+
+    Expects(a.extent(0) == c.extent(0) && b.extent(0) == c.extent(0));
+    Expects(a.extent(1) == c.extent(1));
+    Expects(a.extent(2) == b.extent(1));
+    Expects(b.extent(2) == c.extent(2));
+
+    const auto nbatch = static_cast<index_type>(c.extent(0));
+    const auto m = static_cast<index_type>(c.extent(1));
+    const auto n = static_cast<index_type>(c.extent(2));
+    const auto p = static_cast<index_type>(a.extent(2));
+    if (nbatch == 0 || m == 0 || n == 0) {
+        return;
+    }
+
+#ifdef USE_MKL
+    // Only the row-major layout stores each matrix contiguously.
+    if constexpr (std::is_same_v<std::remove_cv_t<T_a>, double> &&
+                  std::is_same_v<std::remove_cv_t<T_b>, double> && std::is_same_v<T_c, double> &&
+                  std::is_same_v<Layout_a, Kokkos::layout_right> &&
+                  std::is_same_v<Layout_b, Kokkos::layout_right> &&
+                  std::is_same_v<Layout_c, Kokkos::layout_right> &&
+                  std::is_same_v<Accessor_a, Kokkos::default_accessor<T_a>> &&
+                  std::is_same_v<Accessor_b, Kokkos::default_accessor<T_b>> &&
+                  std::is_same_v<Accessor_c, Kokkos::default_accessor<T_c>>) {
+        const BLAS_INT lda = gsl::narrow_cast<BLAS_INT>(p);
+        const BLAS_INT ldb = gsl::narrow_cast<BLAS_INT>(n);
+        const BLAS_INT ldc = gsl::narrow_cast<BLAS_INT>(n);
+        cblas_dgemm_batch_strided(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                                  gsl::narrow_cast<BLAS_INT>(m), gsl::narrow_cast<BLAS_INT>(n),
+                                  gsl::narrow_cast<BLAS_INT>(p), 1.0, a.data_handle(), lda,
+                                  gsl::narrow_cast<BLAS_INT>(m * p), b.data_handle(), ldb,
+                                  gsl::narrow_cast<BLAS_INT>(p * n), 0.0, c.data_handle(), ldc,
+                                  gsl::narrow_cast<BLAS_INT>(m * n),
+                                  gsl::narrow_cast<BLAS_INT>(nbatch));
+        return;
+    }
+#endif
+    const auto nelem = static_cast<std::size_t>(nbatch) * static_cast<std::size_t>(m) *
+                       static_cast<std::size_t>(n) * static_cast<std::size_t>(p);
+    Sci::__Detail::parallel_for(Sci::par, nbatch, nelem, [&](index_type first, index_type last) {
+        std::vector<std::remove_cv_t<T_c>> buf;
+        for (index_type q = first; q < last; ++q) {
+            __Detail::gemm_item(Kokkos::submdspan(a, q, Kokkos::full_extent, Kokkos::full_extent),
+                                Kokkos::submdspan(b, q, Kokkos::full_extent, Kokkos::full_extent),
+                                Kokkos::submdspan(c, q, Kokkos::full_extent, Kokkos::full_extent),
+                                buf);
+        }
+    });
+}
+
+// Pointer-array batch: c[q] = a[q] * b[q] for ranges of matrix views.
+template <class Range_a, class Range_b, class Range_c>
+    requires(std::ranges::random_access_range<Range_a> &&
+             std::ranges::random_access_range<Range_b> &&
+             std::ranges::random_access_range<Range_c> &&
+             std::ranges::range_value_t<Range_a>::rank() == 2 &&
+             std::ranges::range_value_t<Range_b>::rank() == 2 &&
+             std::ranges::range_value_t<Range_c>::rank() == 2)
+void batched_matrix_product(const Range_a& a, const Range_b& b, const Range_c& c)
+{
+    const auto nbatch = static_cast<std::ptrdiff_t>(std::ranges::size(c));
+    Expects(static_cast<std::ptrdiff_t>(std::ranges::size(a)) == nbatch);
+    Expects(static_cast<std::ptrdiff_t>(std::ranges::size(b)) == nbatch);
+
+    std::size_t nelem = 0;
+    for (std::ptrdiff_t q = 0; q < nbatch; ++q) {
+        const auto& aq = std::ranges::begin(a)[q];
+        const auto& bq = std::ranges::begin(b)[q];
+        const auto& cq = std::ranges::begin(c)[q];
+        Expects(aq.extent(0) == cq.extent(0));
+        Expects(aq.extent(1) == bq.extent(0));
+        Expects(bq.extent(1) == cq.extent(1));
+        nelem += static_cast<std::size_t>(cq.size()) * static_cast<std::size_t>(aq.extent(1));
+    }
+    if (nbatch == 0) {
+        return;
+    }
+
+#ifdef USE_MKL
+    using mdspan_a = std::ranges::range_value_t<Range_a>;
+    using mdspan_b = std::ranges::range_value_t<Range_b>;
+    using mdspan_c = std::ranges::range_value_t<Range_c>;
+
+    if constexpr (__Detail::Is_blas_matrix_v<mdspan_a> && __Detail::Is_blas_matrix_v<mdspan_b> &&
+                  __Detail::Is_blas_matrix_v<mdspan_c> &&
+                  std::is_same_v<typename mdspan_a::layout_type, typename mdspan_c::layout_type> &&
+                  std::is_same_v<typename mdspan_b::layout_type, typename mdspan_c::layout_type> &&
+                  !std::is_const_v<typename mdspan_c::element_type>) {
+        constexpr bool col_major =
+            std::is_same_v<typename mdspan_c::layout_type, Kokkos::layout_left>;
+
+        // One group per product, since the sizes may differ.
+        const auto nb = static_cast<std::size_t>(nbatch);
+        std::vector<CBLAS_TRANSPOSE> trans(nb, CblasNoTrans);
+        std::vector<BLAS_INT> m(nb), n(nb), k(nb), lda(nb), ldb(nb), ldc(nb), group_size(nb, 1);
+        std::vector<double> alpha(nb, 1.0), beta(nb, 0.0);
+        std::vector<const double*> pa(nb), pb(nb);
+        std::vector<double*> pc(nb);
+        for (std::size_t q = 0; q < nb; ++q) {
+            const auto& aq = std::ranges::begin(a)[q];
+            const auto& bq = std::ranges::begin(b)[q];
+            const auto& cq = std::ranges::begin(c)[q];
+            m[q] = gsl::narrow_cast<BLAS_INT>(cq.extent(0));
+            n[q] = gsl::narrow_cast<BLAS_INT>(cq.extent(1));
+            k[q] = gsl::narrow_cast<BLAS_INT>(aq.extent(1));
+            lda[q] = col_major ? std::max<BLAS_INT>(1, m[q]) : std::max<BLAS_INT>(1, k[q]);
+            ldb[q] = col_major ? std::max<BLAS_INT>(1, k[q]) : std::max<BLAS_INT>(1, n[q]);
+            ldc[q] = col_major ? std::max<BLAS_INT>(1, m[q]) : std::max<BLAS_INT>(1, n[q]);
+            pa[q] = aq.data_handle();
+            pb[q] = bq.data_handle();
+            pc[q] = cq.data_handle();
+        }
+        cblas_dgemm_batch(col_major ? CblasColMajor : CblasRowMajor, trans.data(), trans.data(),
+                          m.data(), n.data(), k.data(), alpha.data(), pa.data(), lda.data(),
+                          pb.data(), ldb.data(), beta.data(), pc.data(), ldc.data(),
+                          gsl::narrow_cast<BLAS_INT>(nb), group_size.data());
+        return;
+    }
+#endif
+    Sci::__Detail::parallel_for(
+        Sci::par, nbatch, nelem, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            std::vector<typename std::ranges::range_value_t<Range_c>::value_type> buf;
+            for (std::ptrdiff_t q = first; q < last; ++q) {
+                __Detail::gemm_item(std::ranges::begin(a)[q], std::ranges::begin(b)[q],
+                                    std::ranges::begin(c)[q], buf);
+            }
+        });
+}
+
+template <class MDArray_a, class MDArray_b, class MDArray_c>
+    requires(Sci::__Detail::Is_mdarray_v<MDArray_a> && Sci::__Detail::Is_mdarray_v<MDArray_b> &&
+             Sci::__Detail::Is_mdarray_v<MDArray_c> && MDArray_a::rank() == 3 &&
+             MDArray_b::rank() == 3 && MDArray_c::rank() == 3)
+inline void batched_matrix_product(const MDArray_a& a, const MDArray_b& b, MDArray_c& c)
+{
+    batched_matrix_product(a.to_mdspan(), b.to_mdspan(), c.to_mdspan());
+}
+
+template <class T, class Layout>
+inline Sci::Array3D<T, Layout> batched_matrix_product(const Sci::Array3D<T, Layout>& a,
+                                                      const Sci::Array3D<T, Layout>& b)
+{
+    Sci::Array3D<T, Layout> res(a.extent(0), a.extent(1), b.extent(2));
+    batched_matrix_product(a.to_mdspan(), b.to_mdspan(), res.to_mdspan());
+    return res;
+}
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_BLAS3_BATCHED_MATRIX_PRODUCT_H
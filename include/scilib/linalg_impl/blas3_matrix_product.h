@@ -8,6 +8,7 @@
 #define SCILIB_LINALG_BLAS3_MATRIX_PRODUCT_H
 
 #include "lapack_types.h"
+#include "static_kernels.h"
 #include <complex>
 #include <experimental/linalg>
 #include <type_traits>
@@ -41,6 +42,12 @@ inline void matrix_product(
     Kokkos::mdspan<T_b, Kokkos::extents<IndexType_b, nrows_b, ncols_b>, Layout_b, Accessor_b> b,
     Kokkos::mdspan<T_c, Kokkos::extents<IndexType_c, nrows_c, ncols_c>, Layout_c, Accessor_c> c)
 {
+    constexpr bool is_small =
+        Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, nrows_b, ncols_b, nrows_c, ncols_c>;
+    if constexpr (is_small) {
+        Sci::__Detail::static_matrix_product(a, b, c);
+        return;
+    }
     Kokkos::Experimental::linalg::matrix_product(a, b, c);
 }
 
@@ -64,6 +71,12 @@ inline void matrix_product(
     Kokkos::mdspan<double, Kokkos::extents<IndexType_b, nrows_b, ncols_b>, Layout, Accessor_b> b,
     Kokkos::mdspan<double, Kokkos::extents<IndexType_c, nrows_c, ncols_c>, Layout, Accessor_c> c)
 {
+    constexpr bool is_small =
+        Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, nrows_b, ncols_b, nrows_c, ncols_c>;
+    if constexpr (is_small) {
+        Sci::__Detail::static_matrix_product(a, b, c);
+        return;
+    }
     constexpr double alpha = 1.0;
     constexpr double beta = 0.0;
 
@@ -108,6 +121,12 @@ inline void matrix_product(
         b,
     Kokkos::mdspan<double, Kokkos::extents<IndexType_c, nrows_c, ncols_c>, Layout, Accessor_c> c)
 {
+    constexpr bool is_small =
+        Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, nrows_b, ncols_b, nrows_c, ncols_c>;
+    if constexpr (is_small) {
+        Sci::__Detail::static_matrix_product(a, b, c);
+        return;
+    }
     constexpr double alpha = 1.0;
     constexpr double beta = 0.0;
 
@@ -158,6 +177,12 @@ inline void matrix_product(Kokkos::mdspan<std::complex<double>,
                                          Layout,
                                          Accessor_c> c)
 {
+    constexpr bool is_small =
+        Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, nrows_b, ncols_b, nrows_c, ncols_c>;
+    if constexpr (is_small) {
+        Sci::__Detail::static_matrix_product(a, b, c);
+        return;
+    }
     constexpr std::complex<double> alpha = {1.0, 0.0};
     constexpr std::complex<double> beta = {0.0, 0.0};
 
@@ -208,6 +233,12 @@ inline void matrix_product(Kokkos::mdspan<const std::complex<double>,
                                          Layout,
                                          Accessor_c> c)
 {
+    constexpr bool is_small =
+        Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, nrows_b, ncols_b, nrows_c, ncols_c>;
+    if constexpr (is_small) {
+        Sci::__Detail::static_matrix_product(a, b, c);
+        return;
+    }
     constexpr std::complex<double> alpha = {1.0, 0.0};
     constexpr std::complex<double> beta = {0.0, 0.0};
 
@@ -274,6 +305,39 @@ inline Sci::Matrix<T, Layout> matrix_product(const Sci::Matrix<T, Layout>& a,
     return res;
 }
 
+template <class T,
+          class IndexType,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          std::size_t ncols_b,
+          class Layout,
+          class Container_a,
+          class Container_b>
+    requires(Sci::__Detail::Is_small_static_v<nrows_a, ncols_a, ncols_b>)
+constexpr auto matrix_product(
+    const Sci::MDArray<T, Kokkos::extents<IndexType, nrows_a, ncols_a>, Layout, Container_a>& a,
+    const Sci::MDArray<T, Kokkos::extents<IndexType, ncols_a, ncols_b>, Layout, Container_b>& b)
+{
+    using extents_type = Kokkos::extents<IndexType, nrows_a, ncols_b>;
+
+    Sci::MDArray<T, extents_type, Layout, std::array<T, nrows_a * ncols_b>> res(extents_type{});
+    Sci::__Detail::static_matrix_product(a.to_mdspan(), b.to_mdspan(), res.to_mdspan());
+    return res;
+}
+
+// Expression operands are evaluated first.
+
+template <class E1, class E2>
+    requires((Sci::__Detail::Is_expression_v<E1> || Sci::__Detail::Is_expression_v<E2>) &&
+             Sci::__Detail::Is_mdarray_operand_v<E1> && Sci::__Detail::Is_mdarray_operand_v<E2> &&
+             requires(const E1& a, const E2& b) {
+                 matrix_product(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+             })
+inline auto matrix_product(const E1& a, const E2& b)
+{
+    return matrix_product(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -9,6 +9,7 @@
 
 #include "auxiliary.h"
 #include "matrix_decomposition.h"
+#include "static_kernels.h"
 #include <cassert>
 #include <type_traits>
 
@@ -27,6 +28,10 @@ auto det(Kokkos::mdspan<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Acc
 {
     Expects(a.extent(0) == a.extent(1));
 
+    if constexpr (Sci::__Detail::Is_small_square_v<nrows, ncols>) {
+        return Sci::__Detail::static_det(a);
+    }
+
     using value_type = std::remove_cv_t<T>;
 
     value_type ddet = 0.0;
@@ -39,8 +44,9 @@ auto det(Kokkos::mdspan<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Acc
         ddet = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
     }
     else { // use LU decomposition
-        Sci::Matrix<value_type, Layout> tmp(a);
-        Sci::Vector<BLAS_INT, Layout> ipiv(n);
+        auto tmp = Sci::make_scratch<value_type, Layout>(n, n);
+        auto ipiv = Sci::make_scratch<BLAS_INT, Layout>(n);
+        Sci::copy(a, tmp.to_mdspan());
 
         Sci::Linalg::lu(tmp.to_mdspan(), ipiv.to_mdspan());
 
@@ -63,9 +69,24 @@ template <class T,
           class Layout,
           class Container>
     requires(std::is_same_v<std::remove_cv_t<T>, double>&& std::is_integral_v<IndexType>)
-inline T det(const Sci::MDArray<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Container>& a)
+constexpr T
+det(const Sci::MDArray<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Container>& a)
+{
+    if constexpr (Sci::__Detail::Is_small_square_v<nrows, ncols>) {
+        return Sci::__Detail::static_det(a.to_mdspan());
+    }
+    else {
+        return det(a.to_mdspan());
+    }
+}
+
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto det(const E& e)
 {
-    return det(a.to_mdspan());
+    return det(Sci::__Detail::eval(e));
 }
 
 } // namespace Linalg
@@ -8,10 +8,13 @@
 #define SCILIB_LINALG_EIGENVALUE_H
 
 #include "lapack_types.h"
+#include "static_kernels.h"
+#include <algorithm>
 #include <cassert>
 #include <complex>
 #include <exception>
 #include <type_traits>
+#include <utility>
 
 namespace Sci {
 namespace Linalg {
@@ -35,6 +38,11 @@ eigh(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layo
     Expects(a.extent(0) == a.extent(1));
     Expects(w.extent(0) == a.extent(0));
 
+    if constexpr (nrows_a == 3 && ncols_a == 3) {
+        Sci::__Detail::static_eigh3(a, w, uplo);
+        return;
+    }
+
     const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(0));
     const BLAS_INT nselect = n;
     const BLAS_INT lda = n;
@@ -48,8 +56,8 @@ eigh(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layo
     double vl = 0.0;
     double vu = 0.0;
 
-    Sci::Vector<BLAS_INT, Layout> isuppz(2 * n);
-    Sci::Matrix<double, Layout> z(ldz, n);
+    auto isuppz = Sci::make_scratch<BLAS_INT, Layout>(2 * n);
+    auto z = Sci::make_scratch<double, Layout>(ldz, n);
 
     auto matrix_layout = LAPACK_ROW_MAJOR;
     if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
@@ -98,8 +106,8 @@ inline void eigh(Kokkos::mdspan<std::complex<double>,
     double vl = 0.0;
     double vu = 0.0;
 
-    Sci::Vector<BLAS_INT, Layout> isuppz(2 * n);
-    Sci::Matrix<std::complex<double>, Layout> z(ldz, n);
+    auto isuppz = Sci::make_scratch<BLAS_INT, Layout>(2 * n);
+    auto z = Sci::make_scratch<std::complex<double>, Layout>(ldz, n);
 
     auto matrix_layout = LAPACK_ROW_MAJOR;
     if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
@@ -153,6 +161,255 @@ inline void eigh(Sci::MDArray<std::complex<double>,
     eigh(a.to_mdspan(), w.to_mdspan(), uplo, abstol);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Selective symmetric eigenvalue problems:
+//
+// eigvalsh computes eigenvalues only, and the eigh overload taking an output
+// matrix z writes the eigenvectors directly into z instead of into a. Both
+// may be restricted to a subset of the spectrum, which is much cheaper than
+// the full decomposition when only a few eigenpairs are needed, and both
+// return the number m of eigenvalues found. The eigenvalues are stored in
+// w(0:m) in ascending order and the eigenvectors in z(:, 0:m); w must have
+// n elements and z n columns, or iu - il + 1 columns for an index subset.
+// The matrix a is destroyed.
+//
+// Drivers:
+//   evr         MRRR (dsyevr); the default, supports subsets.
+//   evd         Divide and conquer (dsyevd); all eigenvalues only, often
+//               the fastest for the full decomposition of large matrices.
+//   evr_2stage  Two-stage tridiagonal reduction (dsyevr_2stage); faster
+//               reduction for large matrices, eigenvalues only.
+
+enum class Eigh_driver { evr, evd, evr_2stage };
+
+// Selection of eigenvalues: all, the il-th through the iu-th in ascending
+// order (zero-based, inclusive), or those in the half-open interval (vl, vu].
+struct Eigh_subset {
+    char range = 'A';
+    BLAS_INT il = 0;
+    BLAS_INT iu = 0;
+    double vl = 0.0;
+    double vu = 0.0;
+
+    static Eigh_subset all() { return {}; }
+    static Eigh_subset by_index(BLAS_INT il, BLAS_INT iu) { return {'I', il, iu, 0.0, 0.0}; }
+    static Eigh_subset by_value(double vl, double vu) { return {'V', 0, 0, vl, vu}; }
+};
+
+namespace __Detail {
+
+// Eigenvalues, and eigenvectors if jobz == 'V', of the selected subset.
+// Returns the number of eigenvalues found.
+template <class Layout>
+BLAS_INT syev_select(char jobz,
+                     BLAS_INT n,
+                     double* a,
+                     double* w,
+                     double* z,
+                     BLAS_INT ldz,
+                     const Eigh_subset& subset,
+                     char uplo,
+                     Eigh_driver driver,
+                     double abstol)
+{
+    auto matrix_layout = LAPACK_ROW_MAJOR;
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
+        matrix_layout = LAPACK_COL_MAJOR;
+    }
+    if (subset.range == 'I') {
+        Expects(0 <= subset.il && subset.il <= subset.iu && subset.iu < n);
+    }
+    if (subset.range == 'V') {
+        Expects(subset.vl < subset.vu);
+    }
+    // LAPACK counts the eigenvalues from one.
+    const BLAS_INT il = subset.range == 'I' ? subset.il + 1 : 1;
+    const BLAS_INT iu = subset.range == 'I' ? subset.iu + 1 : n;
+
+    BLAS_INT m = n;
+    BLAS_INT info = 0;
+    switch (driver) {
+    case Eigh_driver::evr: {
+        auto isuppz = Sci::make_scratch<BLAS_INT>(2 * std::max<BLAS_INT>(1, n));
+        info = LAPACKE_dsyevr(matrix_layout, jobz, subset.range, uplo, n, a, n, subset.vl,
+                              subset.vu, il, iu, abstol, &m, w, z, ldz, isuppz.container_data());
+        if (info != 0) {
+            throw std::runtime_error("dsyevr failed");
+        }
+        break;
+    }
+    case Eigh_driver::evd:
+        if (subset.range != 'A') {
+            throw std::runtime_error("eigh: the evd driver computes all eigenvalues");
+        }
+        // The eigenvectors overwrite the input, which has been copied to z.
+        info = LAPACKE_dsyevd(matrix_layout, jobz, uplo, n, jobz == 'V' ? z : a,
+                              jobz == 'V' ? ldz : n, w);
+        if (info != 0) {
+            throw std::runtime_error("dsyevd failed");
+        }
+        break;
+    case Eigh_driver::evr_2stage: {
+        if (jobz == 'V') {
+            throw std::runtime_error("eigh: the evr_2stage driver computes eigenvalues only");
+        }
+        auto isuppz = Sci::make_scratch<BLAS_INT>(2 * std::max<BLAS_INT>(1, n));
+        info = LAPACKE_dsyevr_2stage(matrix_layout, jobz, subset.range, uplo, n, a, n, subset.vl,
+                                     subset.vu, il, iu, abstol, &m, w, z, ldz,
+                                     isuppz.container_data());
+        if (info != 0) {
+            throw std::runtime_error("dsyevr_2stage failed");
+        }
+        break;
+    }
+    }
+    return m;
+}
+
+} // namespace __Detail
+
+// Compute selected eigenvalues of a real symmetric matrix.
+template <class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Accessor_a,
+          class IndexType_w,
+          std::size_t ext_w,
+          class Accessor_w>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_w>)
+inline BLAS_INT eigvalsh(
+    Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout, Accessor_a> a,
+    Kokkos::mdspan<double, Kokkos::extents<IndexType_w, ext_w>, Layout, Accessor_w> w,
+    const Eigh_subset& subset = Eigh_subset::all(),
+    char uplo = 'U',
+    Eigh_driver driver = Eigh_driver::evr,
+    double abstol = -1.0 /* use default value */)
+{
+    Expects(a.extent(0) == a.extent(1));
+    Expects(w.extent(0) == a.extent(0));
+
+    const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(0));
+    double z_dummy = 0.0;
+
+    return __Detail::syev_select<Layout>('N', n, a.data_handle(), w.data_handle(), &z_dummy, 1,
+                                         subset, uplo, driver, abstol);
+}
+
+// Compute selected eigenvalues and eigenvectors of a real symmetric matrix.
+template <class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Accessor_a,
+          class IndexType_w,
+          std::size_t ext_w,
+          class Accessor_w,
+          class IndexType_z,
+          std::size_t nrows_z,
+          std::size_t ncols_z,
+          class Accessor_z>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_w>&&
+                 std::is_integral_v<IndexType_z>)
+inline BLAS_INT
+eigh(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout, Accessor_a> a,
+     Kokkos::mdspan<double, Kokkos::extents<IndexType_w, ext_w>, Layout, Accessor_w> w,
+     Kokkos::mdspan<double, Kokkos::extents<IndexType_z, nrows_z, ncols_z>, Layout, Accessor_z> z,
+     const Eigh_subset& subset = Eigh_subset::all(),
+     char uplo = 'U',
+     Eigh_driver driver = Eigh_driver::evr,
+     double abstol = -1.0 /* use default value */)
+{
+    Expects(a.extent(0) == a.extent(1));
+    Expects(w.extent(0) == a.extent(0));
+    Expects(z.extent(0) == a.extent(0));
+    if (subset.range == 'I') {
+        Expects(z.extent(1) >= static_cast<IndexType_z>(subset.iu - subset.il + 1));
+    }
+    else {
+        Expects(z.extent(1) >= a.extent(0));
+    }
+
+    const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(0));
+
+    BLAS_INT ldz = gsl::narrow_cast<BLAS_INT>(z.extent(1));
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
+        ldz = gsl::narrow_cast<BLAS_INT>(z.extent(0));
+    }
+    if (driver == Eigh_driver::evd && subset.range == 'A') {
+        Sci::copy(a, Kokkos::submdspan(z, Kokkos::full_extent,
+                                       std::pair<IndexType_z, IndexType_z>{0, z.extent(0)}));
+    }
+    return __Detail::syev_select<Layout>('V', n, a.data_handle(), w.data_handle(), z.data_handle(),
+                                         ldz, subset, uplo, driver, abstol);
+}
+
+template <class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Container_a,
+          class IndexType_w,
+          std::size_t ext_w,
+          class Container_w>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_w>)
+inline BLAS_INT eigvalsh(
+    Sci::MDArray<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout, Container_a>& a,
+    Sci::MDArray<double, Kokkos::extents<IndexType_w, ext_w>, Layout, Container_w>& w,
+    const Eigh_subset& subset = Eigh_subset::all(),
+    char uplo = 'U',
+    Eigh_driver driver = Eigh_driver::evr,
+    double abstol = -1.0 /* use default value */)
+{
+    return eigvalsh(a.to_mdspan(), w.to_mdspan(), subset, uplo, driver, abstol);
+}
+
+template <class Layout>
+inline Sci::Vector<double, Layout> eigvalsh(const Sci::Matrix<double, Layout>& a,
+                                            const Eigh_subset& subset = Eigh_subset::all(),
+                                            char uplo = 'U',
+                                            Eigh_driver driver = Eigh_driver::evr)
+{
+    auto tmp = Sci::make_scratch<double, Layout>(a.extent(0), a.extent(1));
+    Sci::copy(a.to_mdspan(), tmp.to_mdspan());
+
+    Sci::Vector<double, Layout> w(a.extent(0));
+    const auto m = eigvalsh(tmp.to_mdspan(), w.to_mdspan(), subset, uplo, driver);
+    if (m < gsl::narrow_cast<BLAS_INT>(w.size())) {
+        Sci::Vector<double, Layout> res(m);
+        Sci::copy(Kokkos::submdspan(w.to_mdspan(), std::pair<Sci::index, Sci::index>{0, m}),
+                  res.to_mdspan());
+        return res;
+    }
+    return w;
+}
+
+template <class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Container_a,
+          class IndexType_w,
+          std::size_t ext_w,
+          class Container_w,
+          class IndexType_z,
+          std::size_t nrows_z,
+          std::size_t ncols_z,
+          class Container_z>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_w>&&
+                 std::is_integral_v<IndexType_z>)
+inline BLAS_INT
+eigh(Sci::MDArray<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout, Container_a>& a,
+     Sci::MDArray<double, Kokkos::extents<IndexType_w, ext_w>, Layout, Container_w>& w,
+     Sci::MDArray<double, Kokkos::extents<IndexType_z, nrows_z, ncols_z>, Layout, Container_z>& z,
+     const Eigh_subset& subset = Eigh_subset::all(),
+     char uplo = 'U',
+     Eigh_driver driver = Eigh_driver::evr,
+     double abstol = -1.0 /* use default value */)
+{
+    return eigh(a.to_mdspan(), w.to_mdspan(), z.to_mdspan(), subset, uplo, driver, abstol);
+}
+
 // Compute eigenvalues and eigenvectors of a real non-symmetric matrix.
 template <class IndexType_a,
           std::size_t nrows_a,
@@ -187,10 +444,10 @@ void eig(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>,
 
     const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(1));
 
-    Sci::Vector<double, Layout> wr(n);
-    Sci::Vector<double, Layout> wi(n);
-    Sci::Matrix<double, Layout> vr(n, n);
-    Sci::Matrix<double, Layout> vl(n, n);
+    auto wr = Sci::make_scratch<double, Layout>(n);
+    auto wi = Sci::make_scratch<double, Layout>(n);
+    auto vr = Sci::make_scratch<double, Layout>(n, n);
+    auto vl = Sci::make_scratch<double, Layout>(n, n);
 
     auto matrix_layout = LAPACK_ROW_MAJOR;
     if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
@@ -0,0 +1,390 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_ELEMENT_WISE_KERNELS_H
+#define SCILIB_LINALG_ELEMENT_WISE_KERNELS_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// Accuracy policies for element-wise functions:
+//
+// strict_math calls the std:: functions of the C++ library. fast_math uses
+// branch-free polynomial kernels for exp, log, log2, log10, sin and cos,
+// which the compiler vectorizes. The error is at most 2 ULP for double, and
+// float is evaluated in double precision. Other functions, and element
+// types other than float and double, use the std:: functions in both tiers.
+// The fast kernels are built for several instruction sets (see
+// SCILIB_TARGET_CLONES in execution.h).
+
+struct strict_math_t {
+    explicit strict_math_t() = default;
+};
+
+inline constexpr strict_math_t strict_math{};
+
+struct fast_math_t {
+    explicit fast_math_t() = default;
+};
+
+inline constexpr fast_math_t fast_math{};
+
+namespace __Detail {
+
+template <class T>
+inline constexpr bool Has_fast_math_v = std::is_same_v<T, double> || std::is_same_v<T, float>;
+
+//--------------------------------------------------------------------------------------------------
+// Scalar kernels. They must stay free of branches and library calls in order
+// to be vectorized.
+
+// exp(x) = 2^n exp(r) with |r| <= ln(2)/2, using a Taylor polynomial of
+// degree 13. 2^n is applied in two steps to get subnormal results right.
+MDSPAN_FORCE_INLINE_FUNCTION double fast_exp_scalar(double x) noexcept
+{
+    constexpr double log2e = 1.44269504088896338700e+00;
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    constexpr double shift = 0x1.8p52;
+
+    double xc = (x > 709.8) ? 709.8 : x;
+    xc = (xc < -745.2) ? -745.2 : xc;
+
+    const double z = xc * log2e + shift;
+    const double n = z - shift;
+    const double r = (xc - n * ln2_hi) - n * ln2_lo;
+
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    // The low bits of z hold n; k1 + k2 = n + 2048.
+    const std::uint64_t u = std::bit_cast<std::uint64_t>(z) - std::bit_cast<std::uint64_t>(shift);
+    const std::uint64_t k1 = (u + 2048) >> 1;
+    const std::uint64_t k2 = (u + 2048) - k1;
+    const double s1 = std::bit_cast<double>((k1 - 1) << 52);
+    const double s2 = std::bit_cast<double>((k2 - 1) << 52);
+    return (p * s1) * s2;
+}
+
+// Reduction x = 2^k (1 + f) with 1 + f in [sqrt(2)/2, sqrt(2)), and
+// log(1 + f) = f - hfsq + s * (hfsq + R(s^2)) with s = f / (2 + f) as in
+// fdlibm, with the Taylor coefficients of 2 atanh(s).
+struct Log_reduction {
+    double k;
+    double f;
+    double hfsq;
+    double sr;
+};
+
+MDSPAN_FORCE_INLINE_FUNCTION Log_reduction fast_log_reduce(double x) noexcept
+{
+    const bool subnormal = x < std::numeric_limits<double>::min();
+    const double xs = subnormal ? x * 0x1p54 : x;
+
+    std::uint64_t u = std::bit_cast<std::uint64_t>(xs);
+    u += 0x3ff0000000000000 - 0x3fe6a09e00000000;
+
+    Log_reduction res;
+    res.k = std::bit_cast<double>((u >> 52) | 0x4330000000000000) - (0x1p52 + 1023.0);
+    res.k -= subnormal ? 54.0 : 0.0;
+    res.f = std::bit_cast<double>((u & 0x000fffffffffffff) + 0x3fe6a09e00000000) - 1.0;
+    res.hfsq = 0.5 * res.f * res.f;
+
+    const double s = res.f / (2.0 + res.f);
+    const double z = s * s;
+    double R = 2.0 / 23.0;
+    R = R * z + 2.0 / 21.0;
+    R = R * z + 2.0 / 19.0;
+    R = R * z + 2.0 / 17.0;
+    R = R * z + 2.0 / 15.0;
+    R = R * z + 2.0 / 13.0;
+    R = R * z + 2.0 / 11.0;
+    R = R * z + 2.0 / 9.0;
+    R = R * z + 2.0 / 7.0;
+    R = R * z + 2.0 / 5.0;
+    R = R * z + 2.0 / 3.0;
+    R *= z;
+    res.sr = s * (res.hfsq + R);
+    return res;
+}
+
+// Results for zero, infinite, negative and NaN arguments.
+MDSPAN_FORCE_INLINE_FUNCTION double fast_log_special(double x, double res) noexcept
+{
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    res = (x == 0.0) ? -inf : res;
+    res = (x == inf) ? inf : res;
+    return (x >= 0.0) ? res : std::numeric_limits<double>::quiet_NaN();
+}
+
+MDSPAN_FORCE_INLINE_FUNCTION double fast_log_scalar(double x) noexcept
+{
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+    const auto t = fast_log_reduce(x);
+    const double res = t.k * ln2_hi - ((t.hfsq - (t.sr + t.k * ln2_lo)) - t.f);
+    return fast_log_special(x, res);
+}
+
+MDSPAN_FORCE_INLINE_FUNCTION double fast_log2_scalar(double x) noexcept
+{
+    constexpr double ivln2 = 1.44269504088896338700e+00;
+
+    const auto t = fast_log_reduce(x);
+    const double res = t.k + ((t.f - t.hfsq) + t.sr) * ivln2;
+    return fast_log_special(x, res);
+}
+
+MDSPAN_FORCE_INLINE_FUNCTION double fast_log10_scalar(double x) noexcept
+{
+    constexpr double ivln10 = 4.34294481903251816668e-01;
+    constexpr double log10_2hi = 3.01029995663611771306e-01;
+    constexpr double log10_2lo = 3.69423907715893078616e-13;
+
+    const auto t = fast_log_reduce(x);
+    const double lm = (t.f - t.hfsq) + t.sr;
+    const double res = t.k * log10_2hi + (lm * ivln10 + t.k * log10_2lo);
+    return fast_log_special(x, res);
+}
+
+// Arguments up to this size are reduced modulo pi/2 with a three-term
+// Cody-Waite splitting, which is exact for the quotients involved. Larger and
+// non-finite arguments are passed to std::sin and std::cos.
+inline constexpr double fast_trig_max = 0x1p19;
+
+// sin(x) for quadrant q = 0, or cos(x) for q = 1.
+MDSPAN_FORCE_INLINE_FUNCTION double fast_sincos_scalar(double x, std::uint64_t q0) noexcept
+{
+    constexpr double invpio2 = 6.36619772367581382433e-01;
+    constexpr double pio2_1 = 1.57079632673412561417e+00;
+    constexpr double pio2_2 = 6.07710050630396597660e-11;
+    constexpr double pio2_2t = 2.02226624879595063154e-21;
+    constexpr double shift = 0x1.8p52;
+
+    const double z = x * invpio2 + shift;
+    const double n = z - shift;
+    const double r = ((x - n * pio2_1) - n * pio2_2) - n * pio2_2t;
+    const double r2 = r * r;
+
+    double ps = -1.0 / 121645100408832000.0;
+    ps = ps * r2 + 1.0 / 355687428096000.0;
+    ps = ps * r2 - 1.0 / 1307674368000.0;
+    ps = ps * r2 + 1.0 / 6227020800.0;
+    ps = ps * r2 - 1.0 / 39916800.0;
+    ps = ps * r2 + 1.0 / 362880.0;
+    ps = ps * r2 - 1.0 / 5040.0;
+    ps = ps * r2 + 1.0 / 120.0;
+    ps = ps * r2 - 1.0 / 6.0;
+    const double sin_r = r + r * r2 * ps;
+
+    double pc = 1.0 / 20922789888000.0;
+    pc = pc * r2 - 1.0 / 87178291200.0;
+    pc = pc * r2 + 1.0 / 479001600.0;
+    pc = pc * r2 - 1.0 / 3628800.0;
+    pc = pc * r2 + 1.0 / 40320.0;
+    pc = pc * r2 - 1.0 / 720.0;
+    pc = pc * r2 + 1.0 / 24.0;
+    const double hz = 0.5 * r2;
+    const double w = 1.0 - hz;
+    const double cos_r = w + (((1.0 - w) - hz) + r2 * r2 * pc);
+
+    // Select sin(r) or cos(r) and the sign from the quadrant.
+    const std::uint64_t q = std::bit_cast<std::uint64_t>(z) + q0;
+    const std::uint64_t mask = std::uint64_t{0} - (q & 1);
+    const std::uint64_t bits = (std::bit_cast<std::uint64_t>(sin_r) & ~mask) |
+                               (std::bit_cast<std::uint64_t>(cos_r) & mask);
+    return std::bit_cast<double>(bits ^ ((q & 2) << 62));
+}
+
+//--------------------------------------------------------------------------------------------------
+// Array kernels:
+//
+// y[i] = f(x[i]) for i in [0, n), where x and y may be the same array. The
+// elements are processed in blocks that are copied to the stack first, so
+// the fixed-length loops over each block vectorize without alias checks.
+// fixup(x, y) may then recompute single elements with a library call.
+
+template <class T, class Callable, class Fixup>
+MDSPAN_FORCE_INLINE_FUNCTION void
+fast_transform(const T* x, T* y, std::size_t n, Callable f, Fixup fixup)
+{
+    constexpr std::size_t block = 256;
+    T buf[block];
+
+    for (std::size_t first = 0; first < n; first += block) {
+        const std::size_t len = std::min(block, n - first);
+        T* y_blk = y + first;
+        std::copy_n(x + first, len, buf);
+        if (len == block) {
+            SCILIB_VECTORIZE_LOOP
+            for (std::size_t i = 0; i < block; ++i) {
+                y_blk[i] = static_cast<T>(f(static_cast<double>(buf[i])));
+            }
+        }
+        else {
+            for (std::size_t i = 0; i < len; ++i) {
+                y_blk[i] = static_cast<T>(f(static_cast<double>(buf[i])));
+            }
+        }
+        for (std::size_t i = 0; i < len; ++i) {
+            fixup(buf[i], y_blk[i]);
+        }
+    }
+}
+
+inline constexpr auto no_fixup = [](auto, auto&) {};
+
+inline constexpr auto sin_fixup = [](auto x, auto& y) {
+    if (!(std::abs(x) < fast_trig_max)) {
+        y = std::sin(x);
+    }
+};
+
+inline constexpr auto cos_fixup = [](auto x, auto& y) {
+    if (!(std::abs(x) < fast_trig_max)) {
+        y = std::cos(x);
+    }
+};
+
+inline constexpr auto fast_sin_scalar = [](double x) { return fast_sincos_scalar(x, 0); };
+inline constexpr auto fast_cos_scalar = [](double x) { return fast_sincos_scalar(x, 1); };
+
+SCILIB_TARGET_CLONES inline void fast_exp(const double* x, double* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_exp_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_exp(const float* x, float* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_exp_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_log(const double* x, double* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_log_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_log(const float* x, float* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_log_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_log2(const double* x, double* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_log2_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_log2(const float* x, float* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_log2_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_log10(const double* x, double* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_log10_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_log10(const float* x, float* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_log10_scalar, no_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_sin(const double* x, double* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_sin_scalar, sin_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_sin(const float* x, float* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_sin_scalar, sin_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_cos(const double* x, double* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_cos_scalar, cos_fixup);
+}
+
+SCILIB_TARGET_CLONES inline void fast_cos(const float* x, float* y, std::size_t n)
+{
+    fast_transform(x, y, n, fast_cos_scalar, cos_fixup);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Driver for the element-wise functions:
+//
+// kernel(x, y, n) computes y[i] = f(x[i]) for a contiguous range. For
+// layout_left and layout_right the result is written directly to a new
+// MDArray, split over the thread pool if a parallel policy is given.
+
+template <class Callable>
+inline auto transform_kernel(Callable f)
+{
+    return [f](const auto* x, auto* y, std::size_t n) {
+        SCILIB_VECTORIZE_LOOP
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = f(x[i]);
+        }
+    };
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container, class Kernel>
+inline Sci::MDArray<T, Extents, Layout, Container>
+element_wise(ExecutionPolicy&& policy,
+             const Sci::MDArray<T, Extents, Layout, Container>& m,
+             Kernel&& kernel)
+{
+    using mdarray_type = Sci::MDArray<T, Extents, Layout, Container>;
+
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_left> ||
+                  std::is_same_v<Layout, Kokkos::layout_right>) {
+        mdarray_type res(Sci::uninitialized, m.extents());
+        const T* x = m.container_data();
+        T* y = res.container_data();
+        Sci::__Detail::parallel_for(policy, m.size(), m.size(),
+                                    [&](std::size_t first, std::size_t last) {
+                                        kernel(x + first, y + first, last - first);
+                                    });
+        return res;
+    }
+    else {
+        mdarray_type res(m);
+        if (res.is_exhaustive()) {
+            kernel(res.container_data(), res.container_data(), res.container_size());
+        }
+        else {
+            res.apply([&](T& x) { kernel(&x, &x, 1); });
+        }
+        return res;
+    }
+}
+
+} // namespace __Detail
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_ELEMENT_WISE_KERNELS_H
@@ -7,8 +7,10 @@
 #ifndef SCILIB_LINALG_ELEMENT_WISE_MATH_H
 #define SCILIB_LINALG_ELEMENT_WISE_MATH_H
 
+#include "element_wise_kernels.h"
 #include <cmath>
 #include <complex>
+#include <cstddef>
 #include <type_traits>
 
 namespace Sci {
@@ -17,14 +19,40 @@ namespace Linalg {
 //--------------------------------------------------------------------------------------------------
 //
 // Miscellaneous element-wise functions:
+//
+// The functions return a new MDArray. exp, log, log2, log10, sin and cos take
+// an optional accuracy policy (see element_wise_kernels.h):
+//
+//   auto y = Sci::Linalg::exp(Sci::Linalg::fast_math, x);
+//
+// The functions run on the calling thread. An execution policy can be passed
+// first to run them on the thread pool (see execution.h):
+//
+//   auto y = Sci::Linalg::exp(Sci::par, Sci::Linalg::fast_math, x);
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+abs(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::abs(x); }));
+}
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 abs(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::abs(x); });
-    return res;
+    return Sci::Linalg::abs(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_floating_point_v<T>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+pow(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m, const T& val)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([&val](const T& x) { return std::pow(x, val); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
@@ -32,226 +60,994 @@ template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 pow(const Sci::MDArray<T, Extents, Layout, Container>& m, const T& val)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x, const T& p) { x = std::pow(x, p); }, val);
-    return res;
+    return Sci::Linalg::pow(Sci::execution::seq, m, val);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+sqrt(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::sqrt(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 sqrt(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::sqrt(x); });
-    return res;
+    return Sci::Linalg::sqrt(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+cbrt(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::cbrt(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 cbrt(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::cbrt(x); });
-    return res;
+    return Sci::Linalg::cbrt(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+exp(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::exp(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 exp(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::exp(x); });
-    return res;
+    return Sci::Linalg::exp(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+exp(ExecutionPolicy&& policy, strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::exp(policy, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+exp(ExecutionPolicy&& policy, fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    if constexpr (__Detail::Has_fast_math_v<T>) {
+        return __Detail::element_wise(
+            policy, m, [](const T* x, T* y, std::size_t n) { __Detail::fast_exp(x, y, n); });
+    }
+    else {
+        return Sci::Linalg::exp(policy, m);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+exp(strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::exp(Sci::execution::seq, m);
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+exp(fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::exp(Sci::execution::seq, fast_math, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+expm1(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::expm1(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 expm1(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::expm1(x); });
-    return res;
+    return Sci::Linalg::expm1(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::log(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 log(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::log(x); });
-    return res;
+    return Sci::Linalg::log(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log(ExecutionPolicy&& policy, strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log(policy, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log(ExecutionPolicy&& policy, fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    if constexpr (__Detail::Has_fast_math_v<T>) {
+        return __Detail::element_wise(
+            policy, m, [](const T* x, T* y, std::size_t n) { __Detail::fast_log(x, y, n); });
+    }
+    else {
+        return Sci::Linalg::log(policy, m);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+log(strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log(Sci::execution::seq, m);
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+log(fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log(Sci::execution::seq, fast_math, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log10(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::log10(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 log10(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::log10(x); });
-    return res;
+    return Sci::Linalg::log10(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log10(ExecutionPolicy&& policy, strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log10(policy, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log10(ExecutionPolicy&& policy, fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    if constexpr (__Detail::Has_fast_math_v<T>) {
+        return __Detail::element_wise(
+            policy, m, [](const T* x, T* y, std::size_t n) { __Detail::fast_log10(x, y, n); });
+    }
+    else {
+        return Sci::Linalg::log10(policy, m);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+log10(strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log10(Sci::execution::seq, m);
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+log10(fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log10(Sci::execution::seq, fast_math, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log2(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::log2(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 log2(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::log2(x); });
-    return res;
+    return Sci::Linalg::log2(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log2(ExecutionPolicy&& policy, strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log2(policy, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+log2(ExecutionPolicy&& policy, fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    if constexpr (__Detail::Has_fast_math_v<T>) {
+        return __Detail::element_wise(
+            policy, m, [](const T* x, T* y, std::size_t n) { __Detail::fast_log2(x, y, n); });
+    }
+    else {
+        return Sci::Linalg::log2(policy, m);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+log2(strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log2(Sci::execution::seq, m);
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+log2(fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::log2(Sci::execution::seq, fast_math, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+erf(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::erf(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 erf(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::erf(x); });
-    return res;
+    return Sci::Linalg::erf(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+erfc(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::erfc(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 erfc(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::erfc(x); });
-    return res;
+    return Sci::Linalg::erfc(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+tgamma(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::tgamma(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 tgamma(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::tgamma(x); });
-    return res;
+    return Sci::Linalg::tgamma(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+lgamma(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::lgamma(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 lgamma(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::lgamma(x); });
-    return res;
+    return Sci::Linalg::lgamma(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+sin(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::sin(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 sin(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::sin(x); });
-    return res;
+    return Sci::Linalg::sin(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+sin(ExecutionPolicy&& policy, strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::sin(policy, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+sin(ExecutionPolicy&& policy, fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    if constexpr (__Detail::Has_fast_math_v<T>) {
+        return __Detail::element_wise(
+            policy, m, [](const T* x, T* y, std::size_t n) { __Detail::fast_sin(x, y, n); });
+    }
+    else {
+        return Sci::Linalg::sin(policy, m);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+sin(strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::sin(Sci::execution::seq, m);
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+sin(fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::sin(Sci::execution::seq, fast_math, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+cos(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::cos(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 cos(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::cos(x); });
-    return res;
+    return Sci::Linalg::cos(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+cos(ExecutionPolicy&& policy, strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::cos(policy, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+cos(ExecutionPolicy&& policy, fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    if constexpr (__Detail::Has_fast_math_v<T>) {
+        return __Detail::element_wise(
+            policy, m, [](const T* x, T* y, std::size_t n) { __Detail::fast_cos(x, y, n); });
+    }
+    else {
+        return Sci::Linalg::cos(policy, m);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+cos(strict_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::cos(Sci::execution::seq, m);
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline Sci::MDArray<T, Extents, Layout, Container>
+cos(fast_math_t, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return Sci::Linalg::cos(Sci::execution::seq, fast_math, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+tan(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::tan(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 tan(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::tan(x); });
-    return res;
+    return Sci::Linalg::tan(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+asin(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::asin(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 asin(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::asin(x); });
-    return res;
+    return Sci::Linalg::asin(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+acos(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::acos(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 acos(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::acos(x); });
-    return res;
+    return Sci::Linalg::acos(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+atan(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::atan(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 atan(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::atan(x); });
-    return res;
+    return Sci::Linalg::atan(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+sinh(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::sinh(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 sinh(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::sinh(x); });
-    return res;
+    return Sci::Linalg::sinh(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+cosh(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::cosh(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 cosh(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::cosh(x); });
-    return res;
+    return Sci::Linalg::cosh(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+tanh(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::tanh(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 tanh(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::tanh(x); });
-    return res;
+    return Sci::Linalg::tanh(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+asinh(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::asinh(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 asinh(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::asinh(x); });
-    return res;
+    return Sci::Linalg::asinh(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+acosh(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::acosh(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 acosh(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::acosh(x); });
-    return res;
+    return Sci::Linalg::acosh(Sci::execution::seq, m);
+}
+
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<T, Extents, Layout, Container>
+atanh(ExecutionPolicy&& policy, const Sci::MDArray<T, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m, __Detail::transform_kernel([](const T& x) { return std::atanh(x); }));
 }
 
 template <class T, class Extents, class Layout, class Container>
 inline Sci::MDArray<T, Extents, Layout, Container>
 atanh(const Sci::MDArray<T, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<T, Extents, Layout, Container> res(m);
-    res.apply([](T& x) { x = std::atanh(x); });
-    return res;
+    return Sci::Linalg::atanh(Sci::execution::seq, m);
 }
 
 // Complex conjugate.
+template <class ExecutionPolicy, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy>)
+inline Sci::MDArray<std::complex<double>, Extents, Layout, Container>
+conj(ExecutionPolicy&& policy, const Sci::MDArray<std::complex<double>, Extents, Layout, Container>& m)
+{
+    return __Detail::element_wise(
+        policy, m,
+        __Detail::transform_kernel([](const std::complex<double>& x) { return std::conj(x); }));
+}
+
 template <class Extents, class Layout, class Container>
 inline Sci::MDArray<std::complex<double>, Extents, Layout, Container>
 conj(const Sci::MDArray<std::complex<double>, Extents, Layout, Container>& m)
 {
-    Sci::MDArray<std::complex<double>, Extents, Layout, Container> res(m);
-    res.apply([](std::complex<double>& x) { x = std::conj(x); });
-    return res;
+    return Sci::Linalg::conj(Sci::execution::seq, m);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto abs(const E& e)
+{
+    return Sci::Linalg::abs(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::abs(p, Sci::__Detail::eval(e)); })
+inline auto abs(P&& p, const E& e)
+{
+    return Sci::Linalg::abs(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto sqrt(const E& e)
+{
+    return Sci::Linalg::sqrt(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::sqrt(p, Sci::__Detail::eval(e)); })
+inline auto sqrt(P&& p, const E& e)
+{
+    return Sci::Linalg::sqrt(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto cbrt(const E& e)
+{
+    return Sci::Linalg::cbrt(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::cbrt(p, Sci::__Detail::eval(e)); })
+inline auto cbrt(P&& p, const E& e)
+{
+    return Sci::Linalg::cbrt(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto exp(const E& e)
+{
+    return Sci::Linalg::exp(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::exp(p, Sci::__Detail::eval(e)); })
+inline auto exp(P&& p, const E& e)
+{
+    return Sci::Linalg::exp(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto expm1(const E& e)
+{
+    return Sci::Linalg::expm1(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::expm1(p, Sci::__Detail::eval(e)); })
+inline auto expm1(P&& p, const E& e)
+{
+    return Sci::Linalg::expm1(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto log(const E& e)
+{
+    return Sci::Linalg::log(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::log(p, Sci::__Detail::eval(e)); })
+inline auto log(P&& p, const E& e)
+{
+    return Sci::Linalg::log(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto log10(const E& e)
+{
+    return Sci::Linalg::log10(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::log10(p, Sci::__Detail::eval(e)); })
+inline auto log10(P&& p, const E& e)
+{
+    return Sci::Linalg::log10(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto log2(const E& e)
+{
+    return Sci::Linalg::log2(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::log2(p, Sci::__Detail::eval(e)); })
+inline auto log2(P&& p, const E& e)
+{
+    return Sci::Linalg::log2(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto erf(const E& e)
+{
+    return Sci::Linalg::erf(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::erf(p, Sci::__Detail::eval(e)); })
+inline auto erf(P&& p, const E& e)
+{
+    return Sci::Linalg::erf(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto erfc(const E& e)
+{
+    return Sci::Linalg::erfc(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::erfc(p, Sci::__Detail::eval(e)); })
+inline auto erfc(P&& p, const E& e)
+{
+    return Sci::Linalg::erfc(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto tgamma(const E& e)
+{
+    return Sci::Linalg::tgamma(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::tgamma(p, Sci::__Detail::eval(e)); })
+inline auto tgamma(P&& p, const E& e)
+{
+    return Sci::Linalg::tgamma(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto lgamma(const E& e)
+{
+    return Sci::Linalg::lgamma(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::lgamma(p, Sci::__Detail::eval(e)); })
+inline auto lgamma(P&& p, const E& e)
+{
+    return Sci::Linalg::lgamma(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto sin(const E& e)
+{
+    return Sci::Linalg::sin(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::sin(p, Sci::__Detail::eval(e)); })
+inline auto sin(P&& p, const E& e)
+{
+    return Sci::Linalg::sin(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto cos(const E& e)
+{
+    return Sci::Linalg::cos(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::cos(p, Sci::__Detail::eval(e)); })
+inline auto cos(P&& p, const E& e)
+{
+    return Sci::Linalg::cos(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto tan(const E& e)
+{
+    return Sci::Linalg::tan(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::tan(p, Sci::__Detail::eval(e)); })
+inline auto tan(P&& p, const E& e)
+{
+    return Sci::Linalg::tan(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto asin(const E& e)
+{
+    return Sci::Linalg::asin(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::asin(p, Sci::__Detail::eval(e)); })
+inline auto asin(P&& p, const E& e)
+{
+    return Sci::Linalg::asin(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto acos(const E& e)
+{
+    return Sci::Linalg::acos(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::acos(p, Sci::__Detail::eval(e)); })
+inline auto acos(P&& p, const E& e)
+{
+    return Sci::Linalg::acos(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto atan(const E& e)
+{
+    return Sci::Linalg::atan(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::atan(p, Sci::__Detail::eval(e)); })
+inline auto atan(P&& p, const E& e)
+{
+    return Sci::Linalg::atan(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto sinh(const E& e)
+{
+    return Sci::Linalg::sinh(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::sinh(p, Sci::__Detail::eval(e)); })
+inline auto sinh(P&& p, const E& e)
+{
+    return Sci::Linalg::sinh(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto cosh(const E& e)
+{
+    return Sci::Linalg::cosh(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::cosh(p, Sci::__Detail::eval(e)); })
+inline auto cosh(P&& p, const E& e)
+{
+    return Sci::Linalg::cosh(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto tanh(const E& e)
+{
+    return Sci::Linalg::tanh(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::tanh(p, Sci::__Detail::eval(e)); })
+inline auto tanh(P&& p, const E& e)
+{
+    return Sci::Linalg::tanh(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto asinh(const E& e)
+{
+    return Sci::Linalg::asinh(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::asinh(p, Sci::__Detail::eval(e)); })
+inline auto asinh(P&& p, const E& e)
+{
+    return Sci::Linalg::asinh(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto acosh(const E& e)
+{
+    return Sci::Linalg::acosh(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::acosh(p, Sci::__Detail::eval(e)); })
+inline auto acosh(P&& p, const E& e)
+{
+    return Sci::Linalg::acosh(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto atanh(const E& e)
+{
+    return Sci::Linalg::atanh(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::atanh(p, Sci::__Detail::eval(e)); })
+inline auto atanh(P&& p, const E& e)
+{
+    return Sci::Linalg::atanh(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto conj(const E& e)
+{
+    return Sci::Linalg::conj(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { Sci::Linalg::conj(p, Sci::__Detail::eval(e)); })
+inline auto conj(P&& p, const E& e)
+{
+    return Sci::Linalg::conj(p, Sci::__Detail::eval(e));
+}
+
+template <class E, class T>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto pow(const E& e, const T& val)
+{
+    return Sci::Linalg::pow(Sci::__Detail::eval(e), val);
 }
 
 } // namespace Linalg
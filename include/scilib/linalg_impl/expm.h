@@ -8,70 +8,227 @@
 #define SCILIB_LINALG_EXPM_H
 
 #include "auxiliary.h"
+#include "blas3_matrix_product.h"
+#include "lu.h"
 #include "matrix_norm.h"
-#include <experimental/linalg>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <gsl/gsl>
+#include <stdexcept>
 #include <type_traits>
-
+#include <utility>
 
 namespace Sci {
 namespace Linalg {
 
+//--------------------------------------------------------------------------------------------------
+// Matrix exponential by scaling and squaring:
+//
+// Algorithm 2.3 of Higham, N. J. (2005). The scaling and squaring method for
+// the matrix exponential revisited. SIAM J. Matrix Anal. Appl., 26,
+// 1179-1193. The degree m of the [m/m] Pade approximant r_m is the smallest
+// of 3, 5, 7, 9 and 13 for which the 1-norm of A is below theta_m, which
+// bounds the backward error by the unit roundoff. Larger matrices are scaled
+// by 2^-s to the norm theta_13 and the result is squared s times. The
+// approximant is r_m = (V - U)^-1 * (V + U), where U holds the odd and V the
+// even powers of A; only A^2, A^4 and A^6 are formed, and r_m is found by an
+// LU solve. All matrices live in buffers that are allocated once.
+
+namespace __Detail {
+
+// x = sum_k c[k] * y[k] over the elements of matrices with the same layout,
+// plus c_id on the diagonal. x may be one of the y[k].
+template <class MDSpan, std::size_t N>
+void expm_combine(MDSpan x,
+                  const std::array<double, N>& c,
+                  const std::array<const double*, N>& y,
+                  double c_id = 0.0)
+{
+    using index_type = typename MDSpan::index_type;
+
+    const auto n = x.extent(0);
+    const auto size = static_cast<index_type>(x.size());
+    double* px = x.data_handle();
+    for (index_type i = 0; i < size; ++i) {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < N; ++k) {
+            sum += c[k] * y[k][i];
+        }
+        px[i] = sum;
+    }
+    for (index_type i = 0; i < n; ++i) {
+        x(i, i) += c_id;
+    }
+}
+
+} // namespace __Detail
+
 template <class T,
           class IndexType,
           std::size_t nrows,
           std::size_t ncols,
           class Layout,
           class Accessor>
-    requires(std::is_same_v<std::remove_cv_t<T>, double>&& std::is_integral_v<IndexType>)
+    requires(std::is_same_v<std::remove_cv_t<T>, double>&& std::is_integral_v<IndexType> &&
+             (std::is_same_v<Layout, Kokkos::layout_left> ||
+              std::is_same_v<Layout, Kokkos::layout_right>))
 auto expm(Kokkos::mdspan<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Accessor> a)
 {
-    // Algorithm: Matlab expm1 (demo directory).
-    //
-    // See Moler, C. & Van Loan, C. (2003). Nineteen dubious ways to
-    // compute the exponential of a matrix, twenty-five years later.
-    // SIAM Review, 45, 3-000.
-
-    using namespace Sci;
-    using namespace Sci::Linalg;
-
-    using value_type = std::remove_cv_t<T>;
-
     Expects(a.extent(0) == a.extent(1));
 
-    int e = gsl::narrow_cast<int>(std::log2(matrix_norm(a, 'I')));
-    int s = std::max(0, e + 1);
-
-    Matrix<value_type, Layout> A = Kokkos::Experimental::linalg::scaled(1.0 / std::pow(2.0, s), a);
-    Matrix<value_type, Layout> X = A;
-
-    value_type c = 0.5;
-
-    auto E = identity<Matrix<value_type, Layout>>(a.extent(0)) + c * A;
-    auto D = identity<Matrix<value_type, Layout>>(a.extent(0)) - c * A;
+    using matrix_type = Sci::Matrix<double, Layout>;
+
+    // Pade coefficients b_k and the bounds theta_m of Higham (2005), Table 2.3.
+    constexpr std::array<double, 14> b13 = {64764752532480000.0,
+                                            32382376266240000.0,
+                                            7771770303897600.0,
+                                            1187353796428800.0,
+                                            129060195264000.0,
+                                            10559470521600.0,
+                                            670442572800.0,
+                                            33522128640.0,
+                                            1323241920.0,
+                                            40840800.0,
+                                            960960.0,
+                                            16380.0,
+                                            182.0,
+                                            1.0};
+    constexpr std::array<double, 10> b9 = {17643225600.0, 8821612800.0, 2075673600.0,
+                                           302702400.0,   30270240.0,   2162160.0,
+                                           110880.0,      3960.0,       90.0,
+                                           1.0};
+    constexpr std::array<double, 8> b7 = {
+        17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+    constexpr std::array<double, 6> b5 = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+    constexpr std::array<double, 4> b3 = {120.0, 60.0, 12.0, 1.0};
+
+    constexpr double theta3 = 1.495585217958292e-2;
+    constexpr double theta5 = 2.539398330063230e-1;
+    constexpr double theta7 = 9.504178996162932e-1;
+    constexpr double theta9 = 2.097847961257068e0;
+    constexpr double theta13 = 5.371920351148152e0;
+
+    const auto n = static_cast<Sci::index>(a.extent(0));
+    matrix_type res(n, n);
+    if (n == 0) {
+        return res;
+    }
+    const double anorm = matrix_norm(a, '1');
+    if (!std::isfinite(anorm)) {
+        throw std::runtime_error("expm: matrix has non-finite elements");
+    }
 
-    const int q = 6;
-    int p = 1;
+    int m = 13;
+    int s = 0;
+    if (anorm <= theta3) {
+        m = 3;
+    }
+    else if (anorm <= theta5) {
+        m = 5;
+    }
+    else if (anorm <= theta7) {
+        m = 7;
+    }
+    else if (anorm <= theta9) {
+        m = 9;
+    }
+    else {
+        s = std::max(0, gsl::narrow_cast<int>(std::ceil(std::log2(anorm / theta13))));
+    }
 
-    for (int k = 2; k <= q; ++k) {
-        c *= (q - k + 1) / gsl::narrow_cast<value_type>(k * (2 * q - k + 1));
-        X = A * X;
-        auto cX = c * X;
-        E += cX;
-        if (p) {
-            D += cX;
-        }
-        else {
-            D -= cX;
-        }
-        p = !p;
+    // Buffers: the scaled A, its even powers, U and V, and the result, which
+    // is also one of the two ping-pong buffers of the squaring phase.
+    matrix_type x(n, n);
+    matrix_type a2(n, n);
+    matrix_type a4(n, n);
+    matrix_type a6(n, n);
+    matrix_type u(n, n);
+    matrix_type v(n, n);
+
+    Sci::copy(a, x.to_mdspan());
+    if (s > 0) {
+        x *= std::ldexp(1.0, -s);
+    }
+    const double* pa2 = a2.container_data();
+    const double* pa4 = a4.container_data();
+    const double* pa6 = a6.container_data();
+    const double* pv = v.container_data();
+    const double* pres = res.container_data();
+
+    matrix_product(x.to_mdspan(), x.to_mdspan(), a2.to_mdspan());
+    if (m >= 5) {
+        matrix_product(a2.to_mdspan(), a2.to_mdspan(), a4.to_mdspan());
+    }
+    if (m >= 7) {
+        matrix_product(a2.to_mdspan(), a4.to_mdspan(), a6.to_mdspan());
     }
-    E = inv(D) * E;
 
-    for (int k = 1; k <= s; ++k) {
-        E = E * E;
+    // V and the odd part U / A, which is multiplied by A into u.
+    switch (m) {
+    case 3:
+        __Detail::expm_combine(res.to_mdspan(), std::array{b3[3]}, std::array{pa2}, b3[1]);
+        __Detail::expm_combine(v.to_mdspan(), std::array{b3[2]}, std::array{pa2}, b3[0]);
+        break;
+    case 5:
+        __Detail::expm_combine(
+            res.to_mdspan(), std::array{b5[5], b5[3]}, std::array{pa4, pa2}, b5[1]);
+        __Detail::expm_combine(
+            v.to_mdspan(), std::array{b5[4], b5[2]}, std::array{pa4, pa2}, b5[0]);
+        break;
+    case 7:
+        __Detail::expm_combine(res.to_mdspan(), std::array{b7[7], b7[5], b7[3]},
+                               std::array{pa6, pa4, pa2}, b7[1]);
+        __Detail::expm_combine(v.to_mdspan(), std::array{b7[6], b7[4], b7[2]},
+                               std::array{pa6, pa4, pa2}, b7[0]);
+        break;
+    case 9: {
+        // A^8 is kept in u until the odd part has been formed.
+        const double* pu = u.container_data();
+        matrix_product(a4.to_mdspan(), a4.to_mdspan(), u.to_mdspan());
+        __Detail::expm_combine(res.to_mdspan(), std::array{b9[9], b9[7], b9[5], b9[3]},
+                               std::array{pu, pa6, pa4, pa2}, b9[1]);
+        __Detail::expm_combine(v.to_mdspan(), std::array{b9[8], b9[6], b9[4], b9[2]},
+                               std::array{pu, pa6, pa4, pa2}, b9[0]);
+        break;
+    }
+    default:
+        // U / A = A6 * (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I
+        // V = A6 * (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I
+        __Detail::expm_combine(u.to_mdspan(), std::array{b13[13], b13[11], b13[9]},
+                               std::array{pa6, pa4, pa2});
+        matrix_product(a6.to_mdspan(), u.to_mdspan(), res.to_mdspan());
+        __Detail::expm_combine(res.to_mdspan(), std::array{1.0, b13[7], b13[5], b13[3]},
+                               std::array{pres, pa6, pa4, pa2}, b13[1]);
+
+        __Detail::expm_combine(u.to_mdspan(), std::array{b13[12], b13[10], b13[8]},
+                               std::array{pa6, pa4, pa2});
+        matrix_product(a6.to_mdspan(), u.to_mdspan(), v.to_mdspan());
+        __Detail::expm_combine(v.to_mdspan(), std::array{1.0, b13[6], b13[4], b13[2]},
+                               std::array{pv, pa6, pa4, pa2}, b13[0]);
+        break;
+    }
+    matrix_product(x.to_mdspan(), res.to_mdspan(), u.to_mdspan());
+
+    // Solve (V - U) * r = V + U; the powers of A are no longer needed.
+    const double* pu = u.container_data();
+    __Detail::expm_combine(a2.to_mdspan(), std::array{1.0, -1.0}, std::array{pv, pu});
+    __Detail::expm_combine(res.to_mdspan(), std::array{1.0, 1.0}, std::array{pv, pu});
+
+    LU lu(a2);
+    lu.solve(res);
+
+    // Undo the scaling by squaring, alternating between res and a4.
+    auto p = res.to_mdspan();
+    auto q = a4.to_mdspan();
+    for (int k = 0; k < s; ++k) {
+        matrix_product(p, p, q);
+        std::swap(p, q);
+    }
+    if (p.data_handle() != res.container_data()) {
+        Sci::copy(p, res.to_mdspan());
     }
-    return E;
+    return res;
 }
 
 template <class Layout>
@@ -80,6 +237,15 @@ inline Sci::Matrix<double, Layout> expm(const Sci::Matrix<double, Layout>& a)
     return expm(a.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto expm(const E& e)
+{
+    return expm(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
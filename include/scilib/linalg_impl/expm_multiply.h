@@ -0,0 +1,247 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_EXPM_MULTIPLY_H
+#define SCILIB_LINALG_EXPM_MULTIPLY_H
+
+#include "auxiliary.h"
+#include "blas2_matrix_vector_product.h"
+#include "trace.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <gsl/gsl>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// Action of the matrix exponential on a vector, exp(t * A) * v:
+//
+// Algorithm 3.2 of Al-Mohy, A. H. and Higham, N. J. (2011). Computing the
+// action of the matrix exponential, with an application to exponential
+// integrators. SIAM J. Sci. Comput., 33, 488-511. A is shifted by
+// mu = trace(A) / n, and exp(t * (A - mu * I)) * v is built from s steps
+// of a truncated Taylor series of degree m, where m and s minimize the
+// number m * s of matrix-vector products subject to the 1-norm of
+// t * (A - mu * I) / s being below theta_m. A Taylor series is cut short
+// once its last two terms are negligible. Only matrix-vector products with
+// A are needed, so exp(t * A) is never formed.
+
+namespace __Detail {
+
+// Bounds theta_m on the 1-norm of t * A / s for which the Taylor series of
+// degree m has a backward error below the unit roundoff 2^-53, from Table
+// 3.1 of Al-Mohy and Higham (2011).
+inline constexpr std::array<std::pair<int, double>, 35> expm_multiply_theta = {{
+    {1, 2.29e-16}, {2, 2.58e-8}, {3, 1.39e-5}, {4, 3.40e-4}, {5, 2.40e-3},  {6, 9.07e-3},
+    {7, 2.38e-2},  {8, 5.00e-2}, {9, 8.96e-2}, {10, 1.44e-1}, {11, 2.14e-1}, {12, 3.00e-1},
+    {13, 4.00e-1}, {14, 5.14e-1}, {15, 6.41e-1}, {16, 7.81e-1}, {17, 9.31e-1}, {18, 1.09},
+    {19, 1.26},    {20, 1.44},    {21, 1.62},    {22, 1.82},    {23, 2.01},    {24, 2.22},
+    {25, 2.43},    {26, 2.64},    {27, 2.86},    {28, 3.08},    {29, 3.31},    {30, 3.54},
+    {35, 4.7},     {40, 6.0},     {45, 7.2},     {50, 8.5},     {55, 9.9},
+}};
+
+// Taylor degree m and number of steps s for a matrix t * A with 1-norm tnorm.
+inline std::pair<int, Sci::index> expm_multiply_params(double tnorm)
+{
+    if (tnorm == 0.0) {
+        return {0, 1};
+    }
+    int m_opt = 0;
+    Sci::index s_opt = 1;
+    double cost_opt = std::numeric_limits<double>::max();
+    for (auto [m, theta] : expm_multiply_theta) {
+        const double s = std::max(1.0, std::ceil(tnorm / theta));
+        if (m * s < cost_opt) {
+            cost_opt = m * s;
+            m_opt = m;
+            s_opt = static_cast<Sci::index>(s);
+        }
+    }
+    return {m_opt, s_opt};
+}
+
+// 1-norm of A - mu * I.
+template <class T, class Extents, class Layout, class Accessor>
+double shifted_matrix_norm1(Kokkos::mdspan<T, Extents, Layout, Accessor> a, double mu)
+{
+    using index_type = typename Extents::index_type;
+
+    double res = 0.0;
+    for (index_type j = 0; j < a.extent(1); ++j) {
+        double sum = 0.0;
+        for (index_type i = 0; i < a.extent(0); ++i) {
+            sum += std::abs(i == j ? a(i, j) - mu : a(i, j));
+        }
+        res = std::max(res, sum);
+    }
+    return res;
+}
+
+inline double vector_norm_inf(const Sci::Vector<double>& x)
+{
+    double res = 0.0;
+    for (Sci::index i = 0; i < x.extent(0); ++i) {
+        res = std::max(res, std::abs(x(i)));
+    }
+    return res;
+}
+
+// f = exp(t * A) * f, with A shifted by mu and with 1-norm anorm after the
+// shift; b and tmp are work vectors of the same size as f.
+template <class T, class Extents, class Layout, class Accessor>
+void expm_multiply_step(Kokkos::mdspan<T, Extents, Layout, Accessor> a,
+                        double mu,
+                        double anorm,
+                        double t,
+                        Sci::Vector<double>& f,
+                        Sci::Vector<double>& b,
+                        Sci::Vector<double>& tmp)
+{
+    constexpr double tol = 0x1p-53;
+
+    const auto [m, s] = expm_multiply_params(std::abs(t) * anorm);
+    const double eta = std::exp(t * mu / static_cast<double>(s));
+    const Sci::index n = f.size();
+
+    for (Sci::index i = 0; i < s; ++i) {
+        b = f;
+        double c1 = vector_norm_inf(b);
+        for (int j = 1; j <= m; ++j) {
+            const double coeff = t / static_cast<double>(s * j);
+            matrix_vector_product(a, b.to_mdspan(), tmp.to_mdspan());
+            double c2 = 0.0;
+            double fnorm = 0.0;
+            for (Sci::index k = 0; k < n; ++k) {
+                b(k) = coeff * (tmp(k) - mu * b(k));
+                f(k) += b(k);
+                c2 = std::max(c2, std::abs(b(k)));
+                fnorm = std::max(fnorm, std::abs(f(k)));
+            }
+            if (c1 + c2 <= tol * fnorm) {
+                break;
+            }
+            c1 = c2;
+        }
+        f *= eta;
+    }
+}
+
+} // namespace __Detail
+
+// Returns exp(t * A) * v.
+template <class T_a,
+          class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout_a,
+          class Accessor_a,
+          class T_v,
+          class IndexType_v,
+          std::size_t ext_v,
+          class Layout_v,
+          class Accessor_v>
+    requires(std::is_same_v<std::remove_cv_t<T_a>, double> &&
+             std::is_same_v<std::remove_cv_t<T_v>, double>)
+Sci::Vector<double> expm_multiply(
+    Kokkos::mdspan<T_a, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout_a, Accessor_a> a,
+    Kokkos::mdspan<T_v, Kokkos::extents<IndexType_v, ext_v>, Layout_v, Accessor_v> v,
+    double t = 1.0)
+{
+    Expects(a.extent(0) == a.extent(1));
+    Expects(a.extent(1) == v.extent(0));
+
+    const auto n = static_cast<Sci::index>(a.extent(0));
+    Sci::Vector<double> res(n);
+    Sci::copy(v, res.to_mdspan());
+    if (n == 0) {
+        return res;
+    }
+    const double mu = trace(a) / static_cast<double>(n);
+    const double anorm = __Detail::shifted_matrix_norm1(a, mu);
+
+    Sci::Vector<double> b(n);
+    Sci::Vector<double> tmp(n);
+    __Detail::expm_multiply_step(a, mu, anorm, t, res, b, tmp);
+    return res;
+}
+
+template <class Layout>
+inline Sci::Vector<double> expm_multiply(const Sci::Matrix<double, Layout>& a,
+                                         const Sci::Vector<double, Layout>& v,
+                                         double t = 1.0)
+{
+    return expm_multiply(a.to_mdspan(), v.to_mdspan(), t);
+}
+
+// Returns exp(t_k * A) * v for each time point t_k, as the rows of a matrix.
+// The results are obtained by stepping from one time point to the next, so
+// the cost depends on the total length of the time interval and not on the
+// number of time points. The time points should be in increasing order when
+// A has eigenvalues with large positive real parts.
+template <class T_a,
+          class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout_a,
+          class Accessor_a,
+          class T_v,
+          class IndexType_v,
+          std::size_t ext_v,
+          class Layout_v,
+          class Accessor_v>
+    requires(std::is_same_v<std::remove_cv_t<T_a>, double> &&
+             std::is_same_v<std::remove_cv_t<T_v>, double>)
+Sci::Matrix<double> expm_multiply(
+    Kokkos::mdspan<T_a, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout_a, Accessor_a> a,
+    Kokkos::mdspan<T_v, Kokkos::extents<IndexType_v, ext_v>, Layout_v, Accessor_v> v,
+    const std::vector<double>& times)
+{
+    Expects(a.extent(0) == a.extent(1));
+    Expects(a.extent(1) == v.extent(0));
+
+    const auto n = static_cast<Sci::index>(a.extent(0));
+    const auto nt = static_cast<Sci::index>(times.size());
+    Sci::Matrix<double> res(nt, n);
+    if (n == 0 || nt == 0) {
+        return res;
+    }
+    const double mu = trace(a) / static_cast<double>(n);
+    const double anorm = __Detail::shifted_matrix_norm1(a, mu);
+
+    Sci::Vector<double> f(n);
+    Sci::Vector<double> b(n);
+    Sci::Vector<double> tmp(n);
+    Sci::copy(v, f.to_mdspan());
+
+    double t_prev = 0.0;
+    for (Sci::index k = 0; k < nt; ++k) {
+        __Detail::expm_multiply_step(a, mu, anorm, times[k] - t_prev, f, b, tmp);
+        t_prev = times[k];
+        for (Sci::index i = 0; i < n; ++i) {
+            res(k, i) = f(i);
+        }
+    }
+    return res;
+}
+
+template <class Layout>
+inline Sci::Matrix<double> expm_multiply(const Sci::Matrix<double, Layout>& a,
+                                         const Sci::Vector<double, Layout>& v,
+                                         const std::vector<double>& times)
+{
+    return expm_multiply(a.to_mdspan(), v.to_mdspan(), times);
+}
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_EXPM_MULTIPLY_H
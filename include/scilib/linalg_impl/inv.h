@@ -8,6 +8,8 @@
 #define SCILIB_LINALG_INV_H
 
 #include "lapack_types.h"
+#include "static_kernels.h"
+#include <algorithm>
 #include <exception>
 #include <gsl/gsl>
 #include <limits>
@@ -16,6 +18,88 @@
 namespace Sci {
 namespace Linalg {
 
+namespace __Detail {
+
+// Invert the n x n column-major matrix a in place with a single LU
+// factorization. The inversion is refused if the estimate of the reciprocal
+// condition number is below the machine precision, since the result would
+// have no correct digits.
+inline void inv_col_major(BLAS_INT n, double* a, BLAS_INT lda)
+{
+    if (n == 0) {
+        return;
+    }
+    double lwork;
+    LAPACKE_dgetri_work(LAPACK_COL_MAJOR, n, a, lda, nullptr, &lwork, -1);
+    const auto nwork = std::max(4 * n, static_cast<BLAS_INT>(lwork));
+
+    auto ipiv = Sci::make_scratch<BLAS_INT>(n);
+    auto iwork = Sci::make_scratch<BLAS_INT>(n);
+    auto work = Sci::make_scratch<double>(nwork);
+
+    const double anorm = LAPACKE_dlange_work(LAPACK_COL_MAJOR, '1', n, n, a, lda, nullptr);
+
+    BLAS_INT info = LAPACKE_dgetrf_work(LAPACK_COL_MAJOR, n, n, a, lda, ipiv.container_data());
+    if (info > 0) {
+        throw std::runtime_error("inv: matrix not invertible");
+    }
+    double rcond = 0.0;
+    info = LAPACKE_dgecon_work(LAPACK_COL_MAJOR, '1', n, a, lda, anorm, &rcond,
+                               work.container_data(), iwork.container_data());
+    if (info != 0 || !(rcond >= std::numeric_limits<double>::epsilon())) {
+        throw std::runtime_error("inv: matrix not invertible");
+    }
+    info = LAPACKE_dgetri_work(LAPACK_COL_MAJOR, n, a, lda, ipiv.container_data(),
+                               work.container_data(), nwork);
+    if (info != 0) {
+        throw std::runtime_error("dgetri: matrix inversion failed");
+    }
+}
+
+} // namespace __Detail
+
+// Matrix inversion in place.
+//
+// A row-major matrix is the column-major storage of its transpose, and
+// inv(a') = inv(a)', so both layouts are inverted by LAPACK in column-major
+// order without transposing.
+template <class IndexType,
+          std::size_t nrows,
+          std::size_t ncols,
+          class Layout,
+          class Accessor>
+    requires(std::is_integral_v<IndexType>)
+inline void inv_inplace(
+    Kokkos::mdspan<double, Kokkos::extents<IndexType, nrows, ncols>, Layout, Accessor> a)
+{
+    Expects(a.extent(0) == a.extent(1));
+
+    if constexpr (Sci::__Detail::Is_small_square_v<nrows, ncols>) {
+        Sci::__Detail::static_inv(a, a);
+        return;
+    }
+    const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(0));
+
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_left> ||
+                  std::is_same_v<Layout, Kokkos::layout_right>) {
+        __Detail::inv_col_major(n, a.data_handle(), std::max<BLAS_INT>(1, n));
+    }
+    else {
+        auto tmp = Sci::make_scratch<double, Kokkos::layout_left>(n, n);
+        Sci::copy(a, tmp.to_mdspan());
+        __Detail::inv_col_major(n, tmp.container_data(), std::max<BLAS_INT>(1, n));
+        Sci::copy(tmp.to_mdspan(), a);
+    }
+}
+
+template <class IndexType, std::size_t nrows, std::size_t ncols, class Layout, class Container>
+    requires(std::is_integral_v<IndexType>)
+inline void
+inv_inplace(Sci::MDArray<double, Kokkos::extents<IndexType, nrows, ncols>, Layout, Container>& a)
+{
+    inv_inplace(a.to_mdspan());
+}
+
 // Matrix inversion.
 template <class T_a,
           class IndexType,
@@ -32,28 +116,12 @@ inv(Kokkos::mdspan<T_a, Kokkos::extents<IndexType, nrows, ncols>, Layout, Access
 {
     Expects(a.extent(0) == a.extent(1));
 
-    auto det_a = det(a);
-    if (std::abs(det_a) <= std::abs(det_a) * std::numeric_limits<T_a>::epsilon()) {
-        throw std::runtime_error("inv: matrix not invertible");
+    if constexpr (Sci::__Detail::Is_small_square_v<nrows, ncols>) {
+        Sci::__Detail::static_inv(a, res);
+        return;
     }
-    const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(0));
-
-    auto matrix_layout = LAPACK_ROW_MAJOR;
-    BLAS_INT lda = n;
-
-    if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
-        matrix_layout = LAPACK_COL_MAJOR;
-    }
-
     Sci::copy(a, res);
-
-    Sci::Vector<BLAS_INT, Layout> ipiv(n);
-    Sci::Linalg::lu(res, ipiv.to_mdspan()); // perform LU factorization
-
-    BLAS_INT info = LAPACKE_dgetri(matrix_layout, n, res.data_handle(), lda, ipiv.container_data());
-    if (info != 0) {
-        throw std::runtime_error("dgetri: matrix inversion failed");
-    }
+    inv_inplace(res);
 }
 
 template <class Layout>
@@ -64,6 +132,27 @@ inline Sci::Matrix<double, Layout> inv(const Sci::Matrix<double, Layout>& a)
     return res;
 }
 
+template <class IndexType, std::size_t n, class Layout, class Container>
+    requires(Sci::__Detail::Is_small_square_v<n, n>)
+constexpr auto
+inv(const Sci::MDArray<double, Kokkos::extents<IndexType, n, n>, Layout, Container>& a)
+{
+    using extents_type = Kokkos::extents<IndexType, n, n>;
+
+    Sci::MDArray<double, extents_type, Layout, std::array<double, n * n>> res(extents_type{});
+    Sci::__Detail::static_inv(a.to_mdspan(), res.to_mdspan());
+    return res;
+}
+
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto inv(const E& e)
+{
+    return inv(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -35,8 +35,10 @@ lstsq(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Lay
     BLAS_INT nrhs = gsl::narrow_cast<BLAS_INT>(b.extent(1));
     BLAS_INT rank;
 
-    double rcond = -1.0;                           // use machine epsilon
-    Sci::Vector<double, Layout> s(std::min(m, n)); // singular values of a
+    double rcond = -1.0; // use machine epsilon
+
+    // Singular values of a:
+    auto s = Sci::make_scratch<double, Layout>(std::min(m, n));
 
     auto matrix_layout = LAPACK_ROW_MAJOR;
     BLAS_INT lda = n;
@@ -0,0 +1,291 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_LU_H
+#define SCILIB_LINALG_LU_H
+
+#include "lapack_types.h"
+#include "matrix_norm.h"
+#include <algorithm>
+#include <exception>
+#include <gsl/gsl>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// LU factorization of a square matrix, A = P * L * U, for repeated solves:
+//
+// The matrix is factorized once with dgetrf, and the factors and pivots are
+// kept, so each subsequent solve costs O(n^2) per right-hand side instead of
+// the O(n^3) of solve(). The factors are stored in column-major order
+// regardless of the layout of A. Right-hand sides are solved in place and
+// may be vectors or matrices in either layout; contiguous ones are solved
+// without allocating memory.
+//
+// Example:
+//
+//   Sci::Linalg::LU lu(jacobian);
+//   for (...) {
+//       lu.solve(residual); // residual is overwritten by the solution
+//   }
+//
+class LU {
+public:
+    LU() = default;
+
+    template <class T, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2)
+    explicit LU(Kokkos::mdspan<T, Extents, Layout, Accessor> a)
+    {
+        factorize(a);
+    }
+
+    template <class T, class Extents, class Layout, class Container>
+        requires(Extents::rank() == 2)
+    explicit LU(const Sci::MDArray<T, Extents, Layout, Container>& a)
+    {
+        factorize(a.to_mdspan());
+    }
+
+    // Factorize a, reusing the storage of any previous factorization of
+    // the same size. A singular matrix is not an error until it is used
+    // for solving; see singular().
+    template <class T, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2 && std::is_same_v<std::remove_cv_t<T>, double>)
+    void factorize(Kokkos::mdspan<T, Extents, Layout, Accessor> a)
+    {
+        Expects(a.extent(0) == a.extent(1));
+
+        const auto n = static_cast<Sci::index>(a.extent(0));
+        if (lu.extent(0) != n) {
+            lu.resize(n, n);
+            ipiv.resize(n);
+        }
+        Sci::copy(a, lu.to_mdspan());
+
+        anorm = n > 0 ? matrix_norm(lu.to_mdspan(), '1') : 0.0;
+        info = LAPACKE_dgetrf_work(LAPACK_COL_MAJOR, ld(), ld(), lu.container_data(), ld(),
+                                   ipiv.container_data());
+        if (info < 0) {
+            throw std::runtime_error("dgetrf: illegal input parameter");
+        }
+    }
+
+    template <class T, class Extents, class Layout, class Container>
+        requires(Extents::rank() == 2)
+    void factorize(const Sci::MDArray<T, Extents, Layout, Container>& a)
+    {
+        factorize(a.to_mdspan());
+    }
+
+    Sci::index size() const noexcept { return lu.extent(0); }
+
+    // True if U has an exact zero on the diagonal.
+    bool singular() const noexcept { return info > 0; }
+
+    // The factors L (unit diagonal, not stored) and U, and the pivots in
+    // LAPACK convention: row i was interchanged with row ipiv(i) - 1.
+    const Sci::Matrix<double, Kokkos::layout_left>& factors() const noexcept { return lu; }
+    const Sci::Vector<BLAS_INT>& pivots() const noexcept { return ipiv; }
+
+    // Solve A * x = b in place; b is a vector or an n x nrhs matrix.
+    template <class Extents, class Layout, class Accessor>
+    void solve(Kokkos::mdspan<double, Extents, Layout, Accessor> b) const
+    {
+        solve_impl('N', b);
+    }
+
+    template <class Extents, class Layout, class Container>
+    void solve(Sci::MDArray<double, Extents, Layout, Container>& b) const
+    {
+        solve_impl('N', b.to_mdspan());
+    }
+
+    // Solve A' * x = b in place.
+    template <class Extents, class Layout, class Accessor>
+    void solve_transposed(Kokkos::mdspan<double, Extents, Layout, Accessor> b) const
+    {
+        solve_impl('T', b);
+    }
+
+    template <class Extents, class Layout, class Container>
+    void solve_transposed(Sci::MDArray<double, Extents, Layout, Container>& b) const
+    {
+        solve_impl('T', b.to_mdspan());
+    }
+
+    // Determinant of A.
+    double det() const noexcept
+    {
+        double res = 1.0;
+        for (Sci::index i = 0; i < size(); ++i) {
+            res *= (ipiv(i) != i + 1) ? -lu(i, i) : lu(i, i);
+        }
+        return res;
+    }
+
+    // Inverse of A.
+    template <class Layout = Kokkos::layout_right>
+    Sci::Matrix<double, Layout> inverse() const
+    {
+        check_nonsingular("LU::inverse");
+
+        Sci::Matrix<double, Kokkos::layout_left> tmp = lu;
+        double lwork;
+        LAPACKE_dgetri_work(LAPACK_COL_MAJOR, ld(), tmp.container_data(), ld(),
+                            ipiv.container_data(), &lwork, -1);
+        auto work = Sci::make_scratch<double>(std::max<BLAS_INT>(1, static_cast<BLAS_INT>(lwork)));
+
+        BLAS_INT res_info =
+            LAPACKE_dgetri_work(LAPACK_COL_MAJOR, ld(), tmp.container_data(), ld(),
+                                ipiv.container_data(), work.container_data(),
+                                gsl::narrow_cast<BLAS_INT>(work.size()));
+        if (res_info != 0) {
+            throw std::runtime_error("dgetri: matrix inversion failed");
+        }
+        if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
+            return tmp;
+        }
+        else {
+            return Sci::Matrix<double, Layout>(tmp.to_mdspan());
+        }
+    }
+
+    // Estimate of the reciprocal condition number of A in the 1-norm.
+    double rcond() const
+    {
+        if (singular()) {
+            return 0.0;
+        }
+        if (size() == 0) {
+            return 1.0;
+        }
+        double res = 0.0;
+        BLAS_INT res_info =
+            LAPACKE_dgecon(LAPACK_COL_MAJOR, '1', ld(), lu.container_data(), ld(), anorm, &res);
+        if (res_info != 0) {
+            throw std::runtime_error("dgecon failed");
+        }
+        return res;
+    }
+
+private:
+    BLAS_INT ld() const { return std::max<BLAS_INT>(1, gsl::narrow_cast<BLAS_INT>(size())); }
+
+    void check_nonsingular(const char* fn) const
+    {
+        if (singular()) {
+            throw std::runtime_error(std::string(fn) + ": factor U is singular");
+        }
+    }
+
+    // Solve op(A) * x = b for the column-major n x nrhs array b.
+    void getrs(char trans, BLAS_INT nrhs, double* b, BLAS_INT ldb) const
+    {
+        BLAS_INT res_info = LAPACKE_dgetrs_work(
+            LAPACK_COL_MAJOR, trans, gsl::narrow_cast<BLAS_INT>(size()), nrhs, lu.container_data(),
+            ld(), ipiv.container_data(), b, std::max<BLAS_INT>(1, ldb));
+        if (res_info != 0) {
+            throw std::runtime_error("dgetrs failed");
+        }
+    }
+
+    // Apply the row interchanges of the factorization to the rows of a
+    // row-major matrix, in forward or reverse order.
+    void swap_rows(double* b, Sci::index ldb, Sci::index nrhs, bool forward) const
+    {
+        for (Sci::index k = 0; k < size(); ++k) {
+            const Sci::index i = forward ? k : size() - 1 - k;
+            const Sci::index p = static_cast<Sci::index>(ipiv(i)) - 1;
+            if (p != i) {
+                std::swap_ranges(b + i * ldb, b + i * ldb + nrhs, b + p * ldb);
+            }
+        }
+    }
+
+    template <class Extents, class Layout, class Accessor>
+    void solve_impl(char trans, Kokkos::mdspan<double, Extents, Layout, Accessor> b) const
+    {
+        static_assert(Extents::rank() == 1 || Extents::rank() == 2);
+        Expects(static_cast<Sci::index>(b.extent(0)) == size());
+
+        check_nonsingular(trans == 'N' ? "LU::solve" : "LU::solve_transposed");
+
+        const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(size());
+        BLAS_INT nrhs = 1;
+        if constexpr (Extents::rank() == 2) {
+            nrhs = gsl::narrow_cast<BLAS_INT>(b.extent(1));
+        }
+        if (n == 0 || nrhs == 0) {
+            return;
+        }
+        constexpr bool is_pointer_access =
+            std::is_same_v<Accessor, Kokkos::default_accessor<double>>;
+
+        if constexpr (is_pointer_access && Extents::rank() == 1) {
+            if (b.stride(0) == 1) {
+                getrs(trans, 1, b.data_handle(), ld());
+                return;
+            }
+        }
+        else if constexpr (is_pointer_access && Extents::rank() == 2) {
+            // A single column has unit stride in both extents, so the strides
+            // must also be checked against the extents.
+            if (b.stride(0) == 1 && b.stride(1) >= b.extent(0)) {
+                getrs(trans, nrhs, b.data_handle(), gsl::narrow_cast<BLAS_INT>(b.stride(1)));
+                return;
+            }
+            if (b.stride(1) == 1 && b.stride(0) >= b.extent(1)) {
+                // A row-major b is the column-major b', so solve x' * op(A)' = b'
+                // from the right.
+                const auto ldb = std::max<BLAS_INT>(1, gsl::narrow_cast<BLAS_INT>(b.stride(0)));
+                double* pb = b.data_handle();
+                if (trans == 'N') {
+                    swap_rows(pb, ldb, nrhs, true);
+                    cblas_dtrsm(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasUnit, nrhs,
+                                n, 1.0, lu.container_data(), ld(), pb, ldb);
+                    cblas_dtrsm(CblasColMajor, CblasRight, CblasUpper, CblasTrans, CblasNonUnit,
+                                nrhs, n, 1.0, lu.container_data(), ld(), pb, ldb);
+                }
+                else {
+                    cblas_dtrsm(CblasColMajor, CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit,
+                                nrhs, n, 1.0, lu.container_data(), ld(), pb, ldb);
+                    cblas_dtrsm(CblasColMajor, CblasRight, CblasLower, CblasNoTrans, CblasUnit,
+                                nrhs, n, 1.0, lu.container_data(), ld(), pb, ldb);
+                    swap_rows(pb, ldb, nrhs, false);
+                }
+                return;
+            }
+        }
+        // Other layouts are solved in a column-major scratch copy.
+        if constexpr (Extents::rank() == 1) {
+            auto tmp = Sci::make_scratch<double>(n);
+            Sci::copy(b, tmp.to_mdspan());
+            getrs(trans, 1, tmp.container_data(), ld());
+            Sci::copy(tmp.to_mdspan(), b);
+        }
+        else {
+            auto tmp = Sci::make_scratch<double, Kokkos::layout_left>(n, nrhs);
+            Sci::copy(b, tmp.to_mdspan());
+            getrs(trans, nrhs, tmp.container_data(), ld());
+            Sci::copy(tmp.to_mdspan(), b);
+        }
+    }
+
+    Sci::Matrix<double, Kokkos::layout_left> lu;
+    Sci::Vector<BLAS_INT> ipiv;
+    double anorm = 0.0;
+    BLAS_INT info = 0;
+};
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_LU_H
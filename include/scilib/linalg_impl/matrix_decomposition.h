@@ -9,6 +9,8 @@
 
 #include "auxiliary.h"
 #include "lapack_types.h"
+#include "qr.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <exception>
@@ -110,6 +112,10 @@ lu(Sci::MDArray<double, Kokkos::extents<IndexType_a, nrows, ncols>, Layout, Cont
 }
 
 // QR factorization.
+//
+// q is m x k (thin) or m x m (complete), and r is k x n or has up to m rows,
+// where k = min(m, n). R is read from the output of dgeqrf, and Q is formed
+// with dorgqr. Use QRFactorization to apply Q without forming it.
 template <class IndexType_a,
           std::size_t nrows_a,
           std::size_t ncols_a,
@@ -130,40 +136,9 @@ qr(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout
    Kokkos::mdspan<double, Kokkos::extents<IndexType_q, nrows_q, ncols_q>, Layout, Accessor_q> q,
    Kokkos::mdspan<double, Kokkos::extents<IndexType_r, nrows_r, ncols_r>, Layout, Accessor_r> r)
 {
-    Expects(q.extent(0) == a.extent(0) && q.extent(1) == a.extent(1));
-    Expects(r.extent(0) == a.extent(0) && r.extent(1) == a.extent(1));
-
-    const BLAS_INT m = gsl::narrow_cast<BLAS_INT>(a.extent(0));
-    const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(1));
-
-    auto matrix_layout = LAPACK_ROW_MAJOR;
-    BLAS_INT lda = n;
-
-    if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
-        matrix_layout = LAPACK_COL_MAJOR;
-        lda = m;
-    }
-    Sci::copy(a, q);
-    Sci::Vector<double, Layout> tau(std::min(m, n));
-
-    // Compute QR factorization:
-
-    BLAS_INT info = LAPACKE_dgeqrf(matrix_layout, m, n, q.data_handle(), lda, tau.container_data());
-    if (info != 0) {
-        throw std::runtime_error("dgeqrf failed");
-    }
-
-    // Compute Q:
-
-    info = LAPACKE_dorgqr(matrix_layout, m, n, n, q.data_handle(), lda, tau.container_data());
-    if (info != 0) {
-        throw std::runtime_error("dorgqr failed");
-    }
-
-    // Compute R:
-
-    matrix_product(Kokkos::Experimental::linalg::transposed(q), a, r);
-    Kokkos::Experimental::linalg::transposed(q);
+    QRFactorization fact(a);
+    fact.q(q);
+    fact.r(r);
 }
 
 template <class IndexType_a,
@@ -190,6 +165,87 @@ qr(Sci::MDArray<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout,
 }
 
 // Singular value decomposition.
+//
+// Computes A = U * diag(s) * Vt for an m x n matrix A, with k = min(m, n)
+// singular values in descending order. The job selects which singular
+// vectors are formed, following LAPACK:
+//
+//   'A': all; u is m x m and vt is n x n.
+//   'S': the first k (thin); u is m x k and vt is k x n.
+//   'O': the first k, with the k left singular vectors overwriting a when
+//        m >= n (including square a), and the k right singular vectors
+//        otherwise; vt (k x n) or u (m x k) receives the others, and the
+//        remaining argument is unused.
+//   'N': none; u and vt are unused.
+//
+// In all other cases a is destroyed. The divide-and-conquer driver gesdd is
+// typically several times faster than gesvd for large matrices when singular
+// vectors are wanted.
+enum class Svd_driver { gesvd, gesdd };
+
+namespace __Detail {
+
+// SVD of the column-major m x n matrix a with the drivers' own job codes.
+// For job 'O', overwrite_u selects whether U or Vt overwrites a; it must
+// agree with the shape unless a is square.
+inline void gesvd_col_major(char job,
+                            bool overwrite_u,
+                            Svd_driver driver,
+                            BLAS_INT m,
+                            BLAS_INT n,
+                            double* a,
+                            BLAS_INT lda,
+                            double* s,
+                            double* u,
+                            BLAS_INT ldu,
+                            double* vt,
+                            BLAS_INT ldvt)
+{
+    BLAS_INT info;
+    double lwork;
+    Expects(job != 'O' || m == n || overwrite_u == (m > n));
+    if (driver == Svd_driver::gesdd) {
+        if (job == 'O' && m == n && !overwrite_u) {
+            // dgesdd always overwrites a square a with U, so form Vt in
+            // scratch with the thin job and copy it back over a.
+            auto vt_tmp = Sci::make_scratch<double>(n * n);
+            gesvd_col_major('S', false, driver, m, n, a, lda, s, u, ldu, vt_tmp.container_data(),
+                            n);
+            for (BLAS_INT j = 0; j < n; ++j) {
+                std::copy_n(vt_tmp.container_data() + j * n, n, a + j * lda);
+            }
+            return;
+        }
+        auto iwork = Sci::make_scratch<BLAS_INT>(std::max<BLAS_INT>(1, 8 * std::min(m, n)));
+        LAPACKE_dgesdd_work(LAPACK_COL_MAJOR, job, m, n, a, lda, s, u, ldu, vt, ldvt, &lwork, -1,
+                            iwork.container_data());
+        auto work = Sci::make_scratch<double>(std::max<BLAS_INT>(1, static_cast<BLAS_INT>(lwork)));
+        info = LAPACKE_dgesdd_work(LAPACK_COL_MAJOR, job, m, n, a, lda, s, u, ldu, vt, ldvt,
+                                   work.container_data(), gsl::narrow_cast<BLAS_INT>(work.size()),
+                                   iwork.container_data());
+        if (info != 0) {
+            throw std::runtime_error("dgesdd failed");
+        }
+        return;
+    }
+    char jobu = job;
+    char jobvt = job;
+    if (job == 'O') {
+        jobu = overwrite_u ? 'O' : 'S';
+        jobvt = overwrite_u ? 'S' : 'O';
+    }
+    LAPACKE_dgesvd_work(LAPACK_COL_MAJOR, jobu, jobvt, m, n, a, lda, s, u, ldu, vt, ldvt, &lwork,
+                        -1);
+    auto work = Sci::make_scratch<double>(std::max<BLAS_INT>(1, static_cast<BLAS_INT>(lwork)));
+    info = LAPACKE_dgesvd_work(LAPACK_COL_MAJOR, jobu, jobvt, m, n, a, lda, s, u, ldu, vt, ldvt,
+                               work.container_data(), gsl::narrow_cast<BLAS_INT>(work.size()));
+    if (info != 0) {
+        throw std::runtime_error("dgesvd failed");
+    }
+}
+
+} // namespace __Detail
+
 template <class IndexType_a,
           std::size_t nrows_a,
           std::size_t ncols_a,
@@ -212,34 +268,51 @@ inline void
 svd(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout, Accessor_a> a,
     Kokkos::mdspan<double, Kokkos::extents<IndexType_s, ext_s>, Layout, Accessor_s> s,
     Kokkos::mdspan<double, Kokkos::extents<IndexType_u, nrows_u, ncols_u>, Layout, Accessor_u> u,
-    Kokkos::mdspan<double, Kokkos::extents<IndexType_vt, nrows_vt, ncols_vt>, Layout, Accessor_vt> vt)
+    Kokkos::mdspan<double, Kokkos::extents<IndexType_vt, nrows_vt, ncols_vt>, Layout, Accessor_vt> vt,
+    char job = 'A',
+    Svd_driver driver = Svd_driver::gesvd)
 {
+    static_assert(std::is_same_v<Layout, Kokkos::layout_left> ||
+                  std::is_same_v<Layout, Kokkos::layout_right>);
+
     const BLAS_INT m = gsl::narrow_cast<BLAS_INT>(a.extent(0));
     const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(1));
-    const BLAS_INT ldu = m;
-    const BLAS_INT ldvt = n;
+    const BLAS_INT k = std::min(m, n);
 
-    Expects(gsl::narrow_cast<BLAS_INT>(s.extent(0)) == std::min(m, n));
-    Expects(gsl::narrow_cast<BLAS_INT>(u.extent(0)) == m);
-    Expects(gsl::narrow_cast<BLAS_INT>(u.extent(1)) == ldu);
-    Expects(gsl::narrow_cast<BLAS_INT>(vt.extent(0)) == n);
-    Expects(gsl::narrow_cast<BLAS_INT>(vt.extent(1)) == ldvt);
+    Expects(job == 'A' || job == 'S' || job == 'O' || job == 'N');
+    Expects(gsl::narrow_cast<BLAS_INT>(s.extent(0)) == k);
 
-    auto matrix_layout = LAPACK_ROW_MAJOR;
-    BLAS_INT lda = n;
+    const bool want_u = job == 'A' || job == 'S' || (job == 'O' && m < n);
+    const bool want_vt = job == 'A' || job == 'S' || (job == 'O' && m >= n);
+    if (want_u) {
+        Expects(gsl::narrow_cast<BLAS_INT>(u.extent(0)) == m);
+        Expects(gsl::narrow_cast<BLAS_INT>(u.extent(1)) == (job == 'A' ? m : k));
+    }
+    if (want_vt) {
+        Expects(gsl::narrow_cast<BLAS_INT>(vt.extent(0)) == (job == 'A' ? n : k));
+        Expects(gsl::narrow_cast<BLAS_INT>(vt.extent(1)) == n);
+    }
+    if (k == 0) {
+        return;
+    }
+    double dummy = 0.0;
+    double* pu = want_u ? u.data_handle() : &dummy;
+    double* pvt = want_vt ? vt.data_handle() : &dummy;
 
     if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
-        matrix_layout = LAPACK_COL_MAJOR;
-        lda = m;
+        const BLAS_INT ldu = want_u ? m : 1;
+        const BLAS_INT ldvt = want_vt ? gsl::narrow_cast<BLAS_INT>(vt.extent(0)) : 1;
+        __Detail::gesvd_col_major(job, m >= n, driver, m, n, a.data_handle(), m, s.data_handle(),
+                                  pu, ldu, pvt, ldvt);
     }
-
-    Sci::Vector<double, Layout> superb(std::min(m, n) - 1);
-
-    BLAS_INT info =
-        LAPACKE_dgesvd(matrix_layout, 'A', 'A', m, n, a.data_handle(), lda, s.data_handle(),
-                       u.data_handle(), ldu, vt.data_handle(), ldvt, superb.container_data());
-    if (info != 0) {
-        throw std::runtime_error("dgesvd failed");
+    else {
+        // A row-major A is the column-major A' = V * diag(s) * U', so the
+        // roles of U and Vt are swapped. For job 'O' the overwritten side
+        // follows the original shape, which matters when a is square.
+        const BLAS_INT ldu = want_u ? gsl::narrow_cast<BLAS_INT>(u.extent(1)) : 1;
+        const BLAS_INT ldvt = want_vt ? n : 1;
+        __Detail::gesvd_col_major(job, m < n, driver, n, m, a.data_handle(), n, s.data_handle(),
+                                  pvt, ldvt, pu, ldu);
     }
 }
 
@@ -266,9 +339,40 @@ svd(Sci::MDArray<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout,
     Sci::MDArray<double, Kokkos::extents<IndexType_s, ext_s>, Layout, Container_s>& s,
     Sci::MDArray<double, Kokkos::extents<IndexType_u, nrows_u, ncols_u>, Layout, Container_u>& u,
     Sci::MDArray<double, Kokkos::extents<IndexType_vt, nrows_vt, ncols_vt>, Layout, Container_vt>&
-        vt)
+        vt,
+    char job = 'A',
+    Svd_driver driver = Svd_driver::gesvd)
+{
+    svd(a.to_mdspan(), s.to_mdspan(), u.to_mdspan(), vt.to_mdspan(), job, driver);
+}
+
+// Singular values of a, which is destroyed.
+template <class IndexType_a,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Accessor_a,
+          class IndexType_s,
+          std::size_t ext_s,
+          class Accessor_s>
+    requires(std::is_integral_v<IndexType_a>&& std::is_integral_v<IndexType_s>)
+inline void
+svdvals(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Layout, Accessor_a> a,
+        Kokkos::mdspan<double, Kokkos::extents<IndexType_s, ext_s>, Layout, Accessor_s> s,
+        Svd_driver driver = Svd_driver::gesvd)
+{
+    Kokkos::mdspan<double, Kokkos::dextents<IndexType_a, 2>, Layout> unused(nullptr, 0, 0);
+    svd(a, s, unused, unused, 'N', driver);
+}
+
+template <class Layout>
+inline Sci::Vector<double, Layout> svdvals(const Sci::Matrix<double, Layout>& a,
+                                           Svd_driver driver = Svd_driver::gesvd)
 {
-    svd(a.to_mdspan(), s.to_mdspan(), u.to_mdspan(), vt.to_mdspan());
+    Sci::Matrix<double, Layout> tmp(a);
+    Sci::Vector<double, Layout> s(std::min(a.extent(0), a.extent(1)));
+    svdvals(tmp.to_mdspan(), s.to_mdspan(), driver);
+    return s;
 }
 
 } // namespace Linalg
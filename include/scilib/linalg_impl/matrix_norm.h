@@ -74,6 +74,15 @@ matrix_norm(const Sci::MDArray<T, Kokkos::extents<IndexType, nrows, ncols>, Layo
     return matrix_norm(a.to_mdspan(), norm);
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline double matrix_norm(const E& e, char norm)
+{
+    return matrix_norm(Sci::__Detail::eval(e), norm);
+}
+
 } // namespace Linalg
 } // namespace Sci
 
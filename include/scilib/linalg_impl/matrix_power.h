@@ -7,12 +7,100 @@
 #ifndef SCILIB_LINALG_MATRIX_POWER_H
 #define SCILIB_LINALG_MATRIX_POWER_H
 
-namespace Sci {
-namespace Linalg {
-
+#include "auxiliary.h"
+#include "blas3_matrix_product.h"
+#include "eigenvalue.h"
+#include "inv.h"
+#include "lu.h"
+#include <bit>
 #include <cmath>
 #include <gsl/gsl>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// Integer powers of a square matrix:
+//
+// A^n is computed by binary exponentiation, which needs floor(log2(n)) squarings
+// and one product per further set bit of n instead of n - 1 products. The
+// products alternate between three preallocated buffers. Negative powers
+// raise the inverse, which is found from a single LU factorization.
+//
+// For large real symmetric matrices and large powers, A^n = Q * diag(w^n) * Q'
+// is cheaper, where A = Q * diag(w) * Q' is the eigendecomposition of A. The
+// result then carries the rounding errors of the eigendecomposition, relative
+// to the largest |w|^n, so small integer matrices whose powers are exactly
+// representable are no longer raised exactly. Matrices below
+// matrix_power_eigh_min_size are therefore always raised by products, for
+// which the eigendecomposition would not save much time anyway.
+
+namespace __Detail {
+
+// Number of matrix products in binary exponentiation to the power n > 0.
+inline int matrix_power_products(unsigned n)
+{
+    return std::bit_width(n) - 1 + std::popcount(n) - 1;
+}
+
+// The eigendecomposition of a symmetric matrix costs about as much as this
+// many matrix products.
+inline constexpr int matrix_power_eigh_products = 6;
+
+// Smallest dimension for which the eigendecomposition is used.
+inline constexpr Sci::index matrix_power_eigh_min_size = 64;
+
+template <class T, class Extents, class Layout, class Accessor>
+bool is_symmetric(Kokkos::mdspan<T, Extents, Layout, Accessor> a)
+{
+    for (Sci::index i = 0; i < static_cast<Sci::index>(a.extent(0)); ++i) {
+        for (Sci::index j = i + 1; j < static_cast<Sci::index>(a.extent(1)); ++j) {
+            if (a(i, j) != a(j, i)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A^n = Q * diag(w^n) * Q' for a real symmetric matrix A.
+template <class Layout, class Extents, class Accessor>
+Sci::Matrix<double, Layout>
+symmetric_matrix_power(Kokkos::mdspan<const double, Extents, Layout, Accessor> a, int n)
+{
+    const auto nn = static_cast<Sci::index>(a.extent(0));
+
+    Sci::Matrix<double, Layout> tmp(a);
+    Sci::Vector<double, Layout> w(nn);
+    Sci::Matrix<double, Layout> q(nn, nn);
+    eigh(tmp.to_mdspan(), w.to_mdspan(), q.to_mdspan());
+
+    for (Sci::index j = 0; j < nn; ++j) {
+        if (n < 0 && w(j) == 0.0) {
+            throw std::runtime_error("matrix_power: matrix is singular");
+        }
+        w(j) = std::pow(w(j), n);
+    }
+    for (Sci::index i = 0; i < nn; ++i) {
+        for (Sci::index j = 0; j < nn; ++j) {
+            tmp(i, j) = q(i, j) * w(j);
+        }
+    }
+    auto order = CblasRowMajor;
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_left>) {
+        order = CblasColMajor;
+    }
+    const BLAS_INT ld = std::max<BLAS_INT>(1, gsl::narrow_cast<BLAS_INT>(nn));
+    Sci::Matrix<double, Layout> res(nn, nn);
+    cblas_dgemm(order, CblasNoTrans, CblasTrans, ld, ld, ld, 1.0, tmp.container_data(), ld,
+                q.container_data(), ld, 0.0, res.container_data(), ld);
+    return res;
+}
+
+} // namespace __Detail
 
 // Raise a square matrix to the (integer) power n.
 template <class T,
@@ -25,35 +113,63 @@ template <class T,
 inline auto
 matrix_power(Kokkos::mdspan<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Accessor> m, int n)
 {
-    using namespace Sci;
-    using namespace Sci::Linalg;
-
     using value_type = std::remove_cv_t<T>;
+    using matrix_type = Sci::Matrix<value_type, Layout>;
 
     Expects(m.extent(0) == m.extent(1));
 
-    Matrix<value_type, Layout> tmp(m);
-
-    if (n < 0) {
-        inv(tmp.to_mdspan(), tmp.to_mdspan());
+    // |n| as unsigned, which also holds for INT_MIN.
+    const unsigned nn = (n < 0) ? 0u - static_cast<unsigned>(n) : static_cast<unsigned>(n);
+    if (nn == 0) {
+        return identity<matrix_type>(m.extent(0));
     }
-    int nn = std::abs(n);
-
-    Matrix<value_type, Layout> res(m.extent(0), m.extent(1));
 
-    if (nn == 0) {
-        res = identity<Matrix<value_type, Layout>>(m.extent(0));
+    constexpr bool is_blas_double =
+        std::is_same_v<value_type, double> && (std::is_same_v<Layout, Kokkos::layout_left> ||
+                                               std::is_same_v<Layout, Kokkos::layout_right>);
+    if constexpr (is_blas_double) {
+        if (static_cast<Sci::index>(m.extent(0)) >= __Detail::matrix_power_eigh_min_size &&
+            __Detail::matrix_power_products(nn) >= __Detail::matrix_power_eigh_products &&
+            __Detail::is_symmetric(m)) {
+            Kokkos::mdspan<const double, Kokkos::extents<IndexType, nrows, ncols>, Layout,
+                           Kokkos::default_accessor<const double>>
+                cm(m.data_handle(), m.mapping());
+            return __Detail::symmetric_matrix_power<Layout>(cm, n);
+        }
     }
-    else if (nn == 1) {
-        res = tmp;
+
+    matrix_type base(m);
+    if (n < 0) {
+        if constexpr (std::is_same_v<value_type, double>) {
+            base = LU(base).template inverse<Layout>();
+        }
+        else {
+            inv(base.to_mdspan(), base.to_mdspan());
+        }
     }
-    else if (nn == 2) {
-        res = tmp * tmp;
+    if (nn == 1) {
+        return base;
     }
-    else {
-        res = tmp;
-        for (int ni = 1; ni < nn; ++ni) {
-            res = res * tmp;
+
+    // Square base for each bit of n, and multiply it into res for each set
+    // bit; tmp receives the products, and is swapped with the operand.
+    matrix_type res;
+    matrix_type tmp(m.extent(0), m.extent(1));
+    bool res_set = false;
+    for (unsigned k = nn; k > 0; k >>= 1) {
+        if (k & 1) {
+            if (!res_set) {
+                res = base;
+                res_set = true;
+            }
+            else {
+                matrix_product(res.to_mdspan(), base.to_mdspan(), tmp.to_mdspan());
+                std::swap(res, tmp);
+            }
+        }
+        if (k > 1) {
+            matrix_product(base.to_mdspan(), base.to_mdspan(), tmp.to_mdspan());
+            std::swap(base, tmp);
         }
     }
     return res;
@@ -65,6 +181,15 @@ inline Sci::Matrix<T, Layout> matrix_power(const Sci::Matrix<T, Layout>& m, int
     return matrix_power(m.to_mdspan(), n);
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto matrix_power(const E& e, int n)
+{
+    return matrix_power(Sci::__Detail::eval(e), n);
+}
+
 } // namespace Linalg
 } // namespace Sci
 
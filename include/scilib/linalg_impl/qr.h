@@ -0,0 +1,359 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_QR_H
+#define SCILIB_LINALG_QR_H
+
+#include "auxiliary.h"
+#include "lapack_types.h"
+#include <algorithm>
+#include <exception>
+#include <gsl/gsl>
+#include <type_traits>
+#include <utility>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// QR factorization of an m x n matrix, A = Q * R, with Q held implicitly:
+//
+// The matrix is factorized with dgeqrf, and the Householder reflectors and
+// their scalar factors tau are kept in place of Q. R is read directly from
+// the upper triangle of the factored matrix. Q or Q' is applied to vectors
+// and matrices with dormqr at the cost of O(m * k) per column, where
+// k = min(m, n), and Q itself is only formed, thin (m x k) or complete
+// (m x m), when asked for. The factors are stored in column-major order
+// regardless of the layout of A.
+//
+// Example:
+//
+//   Sci::Linalg::QRFactorization qr(a); // a is tall and skinny
+//   auto x = qr.solve(b);               // least-squares solution
+//
+class QRFactorization {
+public:
+    QRFactorization() = default;
+
+    template <class T, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2)
+    explicit QRFactorization(Kokkos::mdspan<T, Extents, Layout, Accessor> a)
+    {
+        factorize(a);
+    }
+
+    template <class T, class Extents, class Layout, class Container>
+        requires(Extents::rank() == 2)
+    explicit QRFactorization(const Sci::MDArray<T, Extents, Layout, Container>& a)
+    {
+        factorize(a.to_mdspan());
+    }
+
+    // Factorize a, reusing the storage of any previous factorization of
+    // the same size.
+    template <class T, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2 && std::is_same_v<std::remove_cv_t<T>, double>)
+    void factorize(Kokkos::mdspan<T, Extents, Layout, Accessor> a)
+    {
+        const auto m = static_cast<Sci::index>(a.extent(0));
+        const auto n = static_cast<Sci::index>(a.extent(1));
+        if (qr.extent(0) != m || qr.extent(1) != n) {
+            qr.resize(m, n);
+            tau.resize(std::min(m, n));
+        }
+        Sci::copy(a, qr.to_mdspan());
+        if (m == 0 || n == 0) {
+            return;
+        }
+        double lwork;
+        LAPACKE_dgeqrf_work(LAPACK_COL_MAJOR, nrows(), ncols(), qr.container_data(), ld(),
+                            tau.container_data(), &lwork, -1);
+        auto work = Sci::make_scratch<double>(std::max<BLAS_INT>(1, static_cast<BLAS_INT>(lwork)));
+
+        BLAS_INT info = LAPACKE_dgeqrf_work(LAPACK_COL_MAJOR, nrows(), ncols(),
+                                            qr.container_data(), ld(), tau.container_data(),
+                                            work.container_data(),
+                                            gsl::narrow_cast<BLAS_INT>(work.size()));
+        if (info != 0) {
+            throw std::runtime_error("dgeqrf failed");
+        }
+    }
+
+    template <class T, class Extents, class Layout, class Container>
+        requires(Extents::rank() == 2)
+    void factorize(const Sci::MDArray<T, Extents, Layout, Container>& a)
+    {
+        factorize(a.to_mdspan());
+    }
+
+    Sci::index rows() const noexcept { return qr.extent(0); }
+    Sci::index cols() const noexcept { return qr.extent(1); }
+
+    // The Householder reflectors below the diagonal with R on and above it,
+    // and the scalar factors of the reflectors, as returned by dgeqrf.
+    const Sci::Matrix<double, Kokkos::layout_left>& factors() const noexcept { return qr; }
+    const Sci::Vector<double>& reflector_scales() const noexcept { return tau; }
+
+    // Write R to r; r is k x n (thin) or has up to m rows, which are zero
+    // below row k.
+    template <class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2)
+    void r(Kokkos::mdspan<double, Extents, Layout, Accessor> res) const
+    {
+        const Sci::index k = std::min(rows(), cols());
+        Expects(static_cast<Sci::index>(res.extent(1)) == cols());
+        Expects(static_cast<Sci::index>(res.extent(0)) >= k &&
+                static_cast<Sci::index>(res.extent(0)) <= rows());
+
+        for (Sci::index i = 0; i < static_cast<Sci::index>(res.extent(0)); ++i) {
+            for (Sci::index j = 0; j < cols(); ++j) {
+                res(i, j) = (i < k && j >= i) ? qr(i, j) : 0.0;
+            }
+        }
+    }
+
+    // Returns the k x n upper triangular factor R.
+    template <class Layout = Kokkos::layout_right>
+    Sci::Matrix<double, Layout> r() const
+    {
+        Sci::Matrix<double, Layout> res(std::min(rows(), cols()), cols());
+        r(res.to_mdspan());
+        return res;
+    }
+
+    // Write the first p columns of Q to q, where k <= p <= m; p = k gives
+    // the thin and p = m the complete Q.
+    template <class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2)
+    void q(Kokkos::mdspan<double, Extents, Layout, Accessor> res) const
+    {
+        const Sci::index k = std::min(rows(), cols());
+        const auto p = static_cast<Sci::index>(res.extent(1));
+        Expects(static_cast<Sci::index>(res.extent(0)) == rows());
+        Expects(p >= k && p <= rows());
+
+        if (rows() == 0 || p == 0) {
+            return;
+        }
+        constexpr bool is_pointer_access =
+            std::is_same_v<Accessor, Kokkos::default_accessor<double>>;
+        if constexpr (is_pointer_access) {
+            // A single column has unit stride in both extents, so the strides
+            // must also be checked against the extents.
+            if (res.stride(0) == 1 && res.stride(1) >= res.extent(0)) {
+                form_q(res.data_handle(), static_cast<Sci::index>(res.stride(1)), p);
+                return;
+            }
+        }
+        auto tmp = Sci::make_scratch<double, Kokkos::layout_left>(rows(), p);
+        form_q(tmp.container_data(), rows(), p);
+        Sci::copy(tmp.to_mdspan(), res);
+    }
+
+    // Returns the thin (m x k) or, if complete is true, the m x m factor Q.
+    template <class Layout = Kokkos::layout_right>
+    Sci::Matrix<double, Layout> q(bool complete = false) const
+    {
+        Sci::Matrix<double, Layout> res(rows(), complete ? rows() : std::min(rows(), cols()));
+        q(res.to_mdspan());
+        return res;
+    }
+
+    // Compute Q * c in place; c is a vector or an m x p matrix.
+    template <class Extents, class Layout, class Accessor>
+    void apply_q(Kokkos::mdspan<double, Extents, Layout, Accessor> c) const
+    {
+        apply_impl('N', c);
+    }
+
+    template <class Extents, class Layout, class Container>
+    void apply_q(Sci::MDArray<double, Extents, Layout, Container>& c) const
+    {
+        apply_impl('N', c.to_mdspan());
+    }
+
+    // Compute Q' * c in place.
+    template <class Extents, class Layout, class Accessor>
+    void apply_qt(Kokkos::mdspan<double, Extents, Layout, Accessor> c) const
+    {
+        apply_impl('T', c);
+    }
+
+    template <class Extents, class Layout, class Container>
+    void apply_qt(Sci::MDArray<double, Extents, Layout, Container>& c) const
+    {
+        apply_impl('T', c.to_mdspan());
+    }
+
+    // Least-squares solution of A * x = b for m >= n and A of full rank; b
+    // is a vector or an m x p matrix, and x has n rows.
+    template <class T, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 1 && std::is_same_v<std::remove_cv_t<T>, double>)
+    Sci::Vector<double> solve(Kokkos::mdspan<T, Extents, Layout, Accessor> b) const
+    {
+        Expects(static_cast<Sci::index>(b.extent(0)) == rows());
+        auto tmp = Sci::make_scratch<double>(rows());
+        Sci::copy(b, tmp.to_mdspan());
+        solve_r(tmp.container_data(), 1);
+
+        Sci::Vector<double> res(cols());
+        Sci::copy(Kokkos::submdspan(tmp.to_mdspan(), std::pair<Sci::index, Sci::index>{0, cols()}),
+                  res.to_mdspan());
+        return res;
+    }
+
+    template <class T, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2 && std::is_same_v<std::remove_cv_t<T>, double>)
+    auto solve(Kokkos::mdspan<T, Extents, Layout, Accessor> b) const
+    {
+        using result_layout = std::conditional_t<std::is_same_v<Layout, Kokkos::layout_left>,
+                                                 Kokkos::layout_left, Kokkos::layout_right>;
+        Expects(static_cast<Sci::index>(b.extent(0)) == rows());
+
+        const auto p = static_cast<Sci::index>(b.extent(1));
+        auto tmp = Sci::make_scratch<double, Kokkos::layout_left>(rows(), p);
+        Sci::copy(b, tmp.to_mdspan());
+        solve_r(tmp.container_data(), p);
+
+        Sci::Matrix<double, result_layout> res(cols(), p);
+        Sci::copy(Kokkos::submdspan(tmp.to_mdspan(), std::pair<Sci::index, Sci::index>{0, cols()},
+                                    Kokkos::full_extent),
+                  res.to_mdspan());
+        return res;
+    }
+
+    template <class T, class Extents, class Layout, class Container>
+    auto solve(const Sci::MDArray<T, Extents, Layout, Container>& b) const
+    {
+        return solve(b.to_mdspan());
+    }
+
+private:
+    BLAS_INT nrows() const { return gsl::narrow_cast<BLAS_INT>(rows()); }
+    BLAS_INT ncols() const { return gsl::narrow_cast<BLAS_INT>(cols()); }
+    BLAS_INT nrefl() const { return std::min(nrows(), ncols()); }
+    BLAS_INT ld() const { return std::max<BLAS_INT>(1, nrows()); }
+
+    // Form the first p columns of Q in the column-major array q.
+    void form_q(double* q, Sci::index ldq, Sci::index p) const
+    {
+        const auto ldq_ = std::max<BLAS_INT>(1, gsl::narrow_cast<BLAS_INT>(ldq));
+        for (Sci::index j = 0; j < p; ++j) {
+            for (Sci::index i = 0; i < rows(); ++i) {
+                q[i + j * ldq] = (j < nrefl()) ? qr(i, j) : 0.0;
+            }
+        }
+        const auto np = gsl::narrow_cast<BLAS_INT>(p);
+        double lwork;
+        LAPACKE_dorgqr_work(LAPACK_COL_MAJOR, nrows(), np, nrefl(), q, ldq_, tau.container_data(),
+                            &lwork, -1);
+        auto work = Sci::make_scratch<double>(std::max<BLAS_INT>(1, static_cast<BLAS_INT>(lwork)));
+
+        BLAS_INT info = LAPACKE_dorgqr_work(LAPACK_COL_MAJOR, nrows(), np, nrefl(), q, ldq_,
+                                            tau.container_data(), work.container_data(),
+                                            gsl::narrow_cast<BLAS_INT>(work.size()));
+        if (info != 0) {
+            throw std::runtime_error("dorgqr failed");
+        }
+    }
+
+    // Apply Q or Q' to the column-major m x n array c from the left, or to
+    // the column-major n x m array c from the right.
+    void ormqr(char side, char trans, BLAS_INT m, BLAS_INT n, double* c, BLAS_INT ldc) const
+    {
+        double lwork;
+        LAPACKE_dormqr_work(LAPACK_COL_MAJOR, side, trans, m, n, nrefl(), qr.container_data(), ld(),
+                            tau.container_data(), c, ldc, &lwork, -1);
+        auto work = Sci::make_scratch<double>(std::max<BLAS_INT>(1, static_cast<BLAS_INT>(lwork)));
+
+        BLAS_INT info = LAPACKE_dormqr_work(LAPACK_COL_MAJOR, side, trans, m, n, nrefl(),
+                                            qr.container_data(), ld(), tau.container_data(), c,
+                                            ldc, work.container_data(),
+                                            gsl::narrow_cast<BLAS_INT>(work.size()));
+        if (info != 0) {
+            throw std::runtime_error("dormqr failed");
+        }
+    }
+
+    template <class Extents, class Layout, class Accessor>
+    void apply_impl(char trans, Kokkos::mdspan<double, Extents, Layout, Accessor> c) const
+    {
+        static_assert(Extents::rank() == 1 || Extents::rank() == 2);
+        Expects(static_cast<Sci::index>(c.extent(0)) == rows());
+
+        BLAS_INT p = 1;
+        if constexpr (Extents::rank() == 2) {
+            p = gsl::narrow_cast<BLAS_INT>(c.extent(1));
+        }
+        if (rows() == 0 || p == 0 || nrefl() == 0) {
+            return;
+        }
+        constexpr bool is_pointer_access =
+            std::is_same_v<Accessor, Kokkos::default_accessor<double>>;
+
+        if constexpr (is_pointer_access && Extents::rank() == 1) {
+            if (c.stride(0) == 1) {
+                ormqr('L', trans, nrows(), 1, c.data_handle(), ld());
+                return;
+            }
+        }
+        else if constexpr (is_pointer_access && Extents::rank() == 2) {
+            // A single column has unit stride in both extents, so the strides
+            // must also be checked against the extents.
+            if (c.stride(0) == 1 && c.stride(1) >= c.extent(0)) {
+                const auto ldc = std::max<BLAS_INT>(1, gsl::narrow_cast<BLAS_INT>(c.stride(1)));
+                ormqr('L', trans, nrows(), p, c.data_handle(), ldc);
+                return;
+            }
+            if (c.stride(1) == 1 && c.stride(0) >= c.extent(1)) {
+                // A row-major c is the column-major c', and (op(Q) * c)' = c' * op(Q)'.
+                const auto ldc = std::max<BLAS_INT>(1, gsl::narrow_cast<BLAS_INT>(c.stride(0)));
+                ormqr('R', trans == 'N' ? 'T' : 'N', p, nrows(), c.data_handle(), ldc);
+                return;
+            }
+        }
+        // Other layouts are handled in a column-major scratch copy.
+        if constexpr (Extents::rank() == 1) {
+            auto tmp = Sci::make_scratch<double>(rows());
+            Sci::copy(c, tmp.to_mdspan());
+            ormqr('L', trans, nrows(), 1, tmp.container_data(), ld());
+            Sci::copy(tmp.to_mdspan(), c);
+        }
+        else {
+            auto tmp = Sci::make_scratch<double, Kokkos::layout_left>(rows(), p);
+            Sci::copy(c, tmp.to_mdspan());
+            ormqr('L', trans, nrows(), p, tmp.container_data(), ld());
+            Sci::copy(tmp.to_mdspan(), c);
+        }
+    }
+
+    // Overwrite the first n rows of the column-major m x p array b with
+    // R^-1 * (Q' * b)(0:n, :).
+    void solve_r(double* b, Sci::index p) const
+    {
+        Expects(rows() >= cols());
+        for (Sci::index i = 0; i < cols(); ++i) {
+            if (qr(i, i) == 0.0) {
+                throw std::runtime_error("QRFactorization::solve: matrix is rank deficient");
+            }
+        }
+        if (cols() == 0 || p == 0) {
+            return;
+        }
+        const auto np = gsl::narrow_cast<BLAS_INT>(p);
+        ormqr('L', 'T', nrows(), np, b, ld());
+        cblas_dtrsm(CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, ncols(), np,
+                    1.0, qr.container_data(), ld(), b, ld());
+    }
+
+    Sci::Matrix<double, Kokkos::layout_left> qr;
+    Sci::Vector<double> tau;
+};
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_QR_H
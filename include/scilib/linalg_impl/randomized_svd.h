@@ -0,0 +1,177 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_RANDOMIZED_SVD_H
+#define SCILIB_LINALG_RANDOMIZED_SVD_H
+
+#include "auxiliary.h"
+#include "blas3_matrix_product.h"
+#include "lapack_types.h"
+#include "matrix_decomposition.h"
+#include "qr.h"
+#include <algorithm>
+#include <cstdint>
+#include <gsl/gsl>
+#include <random>
+#include <type_traits>
+
+namespace Sci {
+namespace Linalg {
+
+//--------------------------------------------------------------------------------------------------
+// Randomized truncated singular value decomposition:
+//
+// Algorithms 4.4 and 5.1 of Halko, N., Martinsson, P. G. and Tropp, J. A.
+// (2011). Finding structure with randomness: Probabilistic algorithms for
+// constructing approximate matrix decompositions. SIAM Rev., 53, 217-288.
+// The range of an m x n matrix A is sampled by l = k + oversample Gaussian
+// vectors, sharpened by power_iters steps of subspace iteration with
+// re-orthonormalization, and the k leading singular triplets are found from
+// the SVD of the small l x n matrix Q' * A. The cost is O(m * n * l) per
+// pass over A instead of the O(m * n^2) of svd().
+//
+// The matrix-free variant only needs the products Y = A * X (X is n x l) and
+// Y = A' * X (X is m x l), given as callables on row-major mdspans.
+
+// The k leading singular values s, and the left (m x k) and right (k x n)
+// singular vectors u and vt, with A ~ u * diag(s) * vt.
+struct Truncated_svd {
+    Sci::Vector<double> s;
+    Sci::Matrix<double> u;
+    Sci::Matrix<double> vt;
+};
+
+namespace __Detail {
+
+using Rsvd_const_span = Kokkos::mdspan<const double, Kokkos::dextents<Sci::index, 2>>;
+using Rsvd_span = Kokkos::mdspan<double, Kokkos::dextents<Sci::index, 2>>;
+
+// Replace the columns of y with an orthonormal basis for their span.
+inline void orthonormalize(Sci::Matrix<double>& y)
+{
+    QRFactorization qr(y);
+    qr.q(y.to_mdspan());
+}
+
+} // namespace __Detail
+
+template <class ApplyA, class ApplyAt>
+    requires(std::is_invocable_v<ApplyA, __Detail::Rsvd_const_span, __Detail::Rsvd_span> &&
+             std::is_invocable_v<ApplyAt, __Detail::Rsvd_const_span, __Detail::Rsvd_span>)
+Truncated_svd randomized_svd(Sci::index m,
+                             Sci::index n,
+                             ApplyA&& apply_a,
+                             ApplyAt&& apply_at,
+                             Sci::index k,
+                             Sci::index oversample = 10,
+                             int power_iters = 2,
+                             std::uint64_t seed = std::random_device{}())
+{
+    Expects(k > 0 && k <= std::min(m, n));
+    Expects(oversample >= 0 && power_iters >= 0);
+
+    const Sci::index l = std::min(k + oversample, std::min(m, n));
+
+    Sci::Matrix<double> omega(Sci::uninitialized, n, l);
+    std::mt19937_64 gen{seed};
+    std::normal_distribution<double> nd{};
+    omega.apply([&](double& x) { x = nd(gen); });
+
+    // Range finder: Q is an orthonormal basis for (A * A')^q * A * Omega.
+    Sci::Matrix<double> q(m, l);
+    Sci::Matrix<double> z(n, l);
+    apply_a(__Detail::Rsvd_const_span(omega.container_data(), n, l), q.to_mdspan());
+    __Detail::orthonormalize(q);
+    for (int i = 0; i < power_iters; ++i) {
+        apply_at(__Detail::Rsvd_const_span(q.container_data(), m, l), z.to_mdspan());
+        __Detail::orthonormalize(z);
+        apply_a(__Detail::Rsvd_const_span(z.container_data(), n, l), q.to_mdspan());
+        __Detail::orthonormalize(q);
+    }
+
+    // Z = A' * Q = B' with B = Q' * A, so B = Vz * diag(s) * Uz' for the
+    // SVD Z = Uz * diag(s) * Vz'.
+    apply_at(__Detail::Rsvd_const_span(q.container_data(), m, l), z.to_mdspan());
+    Sci::Vector<double> sz(l);
+    Sci::Matrix<double> uz(n, l);
+    Sci::Matrix<double> vzt(l, l);
+    svd(z, sz, uz, vzt, 'S', Svd_driver::gesdd);
+
+    Truncated_svd res{Sci::Vector<double>(k), Sci::Matrix<double>(m, k),
+                      Sci::Matrix<double>(k, n)};
+    for (Sci::index j = 0; j < k; ++j) {
+        res.s(j) = sz(j);
+    }
+    // u = Q * Vz(:, 0:k) and vt = Uz(:, 0:k)'.
+    Sci::Matrix<double> vz(l, k);
+    for (Sci::index i = 0; i < l; ++i) {
+        for (Sci::index j = 0; j < k; ++j) {
+            vz(i, j) = vzt(j, i);
+        }
+    }
+    matrix_product(q, vz, res.u);
+    for (Sci::index i = 0; i < k; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            res.vt(i, j) = uz(j, i);
+        }
+    }
+    return res;
+}
+
+template <class T,
+          class IndexType,
+          std::size_t nrows,
+          std::size_t ncols,
+          class Layout,
+          class Accessor>
+    requires(std::is_same_v<std::remove_cv_t<T>, double> && std::is_integral_v<IndexType>)
+Truncated_svd
+randomized_svd(Kokkos::mdspan<T, Kokkos::extents<IndexType, nrows, ncols>, Layout, Accessor> a,
+               Sci::index k,
+               Sci::index oversample = 10,
+               int power_iters = 2,
+               std::uint64_t seed = std::random_device{}())
+{
+    static_assert(std::is_same_v<Layout, Kokkos::layout_left> ||
+                  std::is_same_v<Layout, Kokkos::layout_right>);
+
+    const auto m = gsl::narrow_cast<BLAS_INT>(a.extent(0));
+    const auto n = gsl::narrow_cast<BLAS_INT>(a.extent(1));
+
+    // The products are row-major, in which a column-major A is A'.
+    constexpr bool is_row_major = std::is_same_v<Layout, Kokkos::layout_right>;
+    const auto trans_a = is_row_major ? CblasNoTrans : CblasTrans;
+    const auto trans_at = is_row_major ? CblasTrans : CblasNoTrans;
+    const BLAS_INT lda = std::max<BLAS_INT>(1, is_row_major ? n : m);
+
+    auto apply_a = [&](__Detail::Rsvd_const_span x, __Detail::Rsvd_span y) {
+        const auto l = gsl::narrow_cast<BLAS_INT>(x.extent(1));
+        cblas_dgemm(CblasRowMajor, trans_a, CblasNoTrans, m, l, n, 1.0, a.data_handle(), lda,
+                    x.data_handle(), l, 0.0, y.data_handle(), l);
+    };
+    auto apply_at = [&](__Detail::Rsvd_const_span x, __Detail::Rsvd_span y) {
+        const auto l = gsl::narrow_cast<BLAS_INT>(x.extent(1));
+        cblas_dgemm(CblasRowMajor, trans_at, CblasNoTrans, n, l, m, 1.0, a.data_handle(), lda,
+                    x.data_handle(), l, 0.0, y.data_handle(), l);
+    };
+    return randomized_svd(a.extent(0), a.extent(1), apply_a, apply_at, k, oversample, power_iters,
+                          seed);
+}
+
+template <class Layout>
+inline Truncated_svd randomized_svd(const Sci::Matrix<double, Layout>& a,
+                                    Sci::index k,
+                                    Sci::index oversample = 10,
+                                    int power_iters = 2,
+                                    std::uint64_t seed = std::random_device{}())
+{
+    return randomized_svd(a.to_mdspan(), k, oversample, power_iters, seed);
+}
+
+} // namespace Linalg
+} // namespace Sci
+
+#endif // SCILIB_LINALG_RANDOMIZED_SVD_H
@@ -8,6 +8,7 @@
 #define SCILIB_LINALG_SOLVE_H
 
 #include "lapack_types.h"
+#include "static_kernels.h"
 #include <exception>
 #include <gsl/gsl>
 #include <type_traits>
@@ -33,11 +34,16 @@ solve(Kokkos::mdspan<double, Kokkos::extents<IndexType_a, nrows_a, ncols_a>, Lay
     Expects(a.extent(0) == a.extent(1));
     Expects(b.extent(0) == a.extent(1));
 
+    if constexpr (Sci::__Detail::Is_small_square_v<nrows_a, ncols_a>) {
+        Sci::__Detail::static_solve(a, b);
+        return;
+    }
+
     const BLAS_INT n = gsl::narrow_cast<BLAS_INT>(a.extent(1));
     const BLAS_INT nrhs = gsl::narrow_cast<BLAS_INT>(b.extent(1));
     const BLAS_INT lda = n;
 
-    Sci::Vector<BLAS_INT, Layout> ipiv(n);
+    auto ipiv = Sci::make_scratch<BLAS_INT, Layout>(n);
 
     auto matrix_layout = LAPACK_ROW_MAJOR;
     BLAS_INT ldb = nrhs;
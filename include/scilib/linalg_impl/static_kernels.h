@@ -0,0 +1,518 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_LINALG_STATIC_KERNELS_H
+#define SCILIB_LINALG_STATIC_KERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Largest static extent for which the unrolled kernels are used.
+#ifndef SCILIB_STATIC_KERNEL_MAX
+#define SCILIB_STATIC_KERNEL_MAX 4
+#endif
+
+namespace Sci {
+
+//--------------------------------------------------------------------------------------------------
+// Kernels for small static matrices:
+//
+// Products, determinants, inverses and linear solves of matrices whose
+// extents are all static and at most SCILIB_STATIC_KERNEL_MAX (e.g.
+// StaticMatrix<double, 3, 3>) are fully unrolled at compile time. They do
+// not allocate or call BLAS/LAPACK, and can be evaluated in constant
+// expressions. Determinants and inverses use cofactor expansion, which is
+// limited to 4 x 4 matrices. The eigenvalues and eigenvectors of symmetric
+// 3 x 3 matrices are computed analytically. The generic functions dispatch
+// to these kernels.
+
+namespace __Detail {
+
+template <std::size_t... Exts>
+inline constexpr bool Is_small_static_v =
+    ((Exts != Kokkos::dynamic_extent && Exts <= SCILIB_STATIC_KERNEL_MAX) && ...);
+
+// Square matrices handled by the cofactor kernels.
+template <std::size_t nrows, std::size_t ncols>
+inline constexpr bool Is_small_square_v =
+    Is_small_static_v<nrows, ncols> && nrows == ncols && nrows <= 4;
+
+// Call f(i) for i in [0, N), unrolled.
+template <class IndexType, std::size_t N, class Callable>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr void static_for(Callable&& f)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(static_cast<IndexType>(I)), ...);
+    }(std::make_index_sequence<N>());
+}
+
+template <class T>
+constexpr T static_abs(const T& x)
+{
+    return x < T{0} ? -x : x;
+}
+
+// c = a * b, where c may alias a or b.
+template <class MDSpanA, class MDSpanB, class MDSpanC>
+constexpr void static_matrix_product(MDSpanA a, MDSpanB b, MDSpanC c)
+{
+    using value_type = typename MDSpanC::value_type;
+    using index_type = typename MDSpanC::index_type;
+
+    constexpr std::size_t m = MDSpanA::static_extent(0);
+    constexpr std::size_t p = MDSpanA::static_extent(1);
+    constexpr std::size_t n = MDSpanB::static_extent(1);
+    static_assert(MDSpanB::static_extent(0) == p);
+    static_assert(MDSpanC::static_extent(0) == m && MDSpanC::static_extent(1) == n);
+
+    std::array<value_type, m * n> res{};
+    static_for<index_type, m>([&](auto i) {
+        static_for<index_type, n>([&](auto j) {
+            value_type s{};
+            static_for<index_type, p>([&](auto k) { s += a(i, k) * b(k, j); });
+            res[i * n + j] = s;
+        });
+    });
+    static_for<index_type, m>([&](auto i) {
+        static_for<index_type, n>([&](auto j) { c(i, j) = res[i * n + j]; });
+    });
+}
+
+// y = a * x, where y may alias x.
+template <class MDSpanA, class MDSpanX, class MDSpanY>
+constexpr void static_matrix_vector_product(MDSpanA a, MDSpanX x, MDSpanY y)
+{
+    using value_type = typename MDSpanY::value_type;
+    using index_type = typename MDSpanY::index_type;
+
+    constexpr std::size_t m = MDSpanA::static_extent(0);
+    constexpr std::size_t n = MDSpanA::static_extent(1);
+    static_assert(MDSpanX::static_extent(0) == n && MDSpanY::static_extent(0) == m);
+
+    std::array<value_type, m> res{};
+    static_for<index_type, m>([&](auto i) {
+        value_type s{};
+        static_for<index_type, n>([&](auto k) { s += a(i, k) * x(k); });
+        res[i] = s;
+    });
+    static_for<index_type, m>([&](auto i) { y(i) = res[i]; });
+}
+
+// Copy the square matrix a into a row-major array.
+template <class MDSpan>
+constexpr auto static_load(MDSpan a)
+{
+    using value_type = std::remove_cv_t<typename MDSpan::element_type>;
+    using index_type = typename MDSpan::index_type;
+    constexpr std::size_t n = MDSpan::static_extent(0);
+
+    std::array<value_type, n * n> res{};
+    static_for<index_type, n>([&](auto i) {
+        static_for<index_type, n>([&](auto j) { res[i * n + j] = a(i, j); });
+    });
+    return res;
+}
+
+// Determinant by cofactor expansion. For 4 x 4 matrices the expansion is
+// along the 2 x 2 minors of the first two and the last two rows.
+template <std::size_t n, class T>
+constexpr T static_det(const std::array<T, n * n>& a)
+{
+    if constexpr (n == 0) {
+        return T{1};
+    }
+    else if constexpr (n == 1) {
+        return a[0];
+    }
+    else if constexpr (n == 2) {
+        return a[0] * a[3] - a[1] * a[2];
+    }
+    else if constexpr (n == 3) {
+        return a[0] * (a[4] * a[8] - a[5] * a[7]) - a[1] * (a[3] * a[8] - a[5] * a[6]) +
+               a[2] * (a[3] * a[7] - a[4] * a[6]);
+    }
+    else {
+        static_assert(n == 4);
+        const T s0 = a[0] * a[5] - a[4] * a[1];
+        const T s1 = a[0] * a[6] - a[4] * a[2];
+        const T s2 = a[0] * a[7] - a[4] * a[3];
+        const T s3 = a[1] * a[6] - a[5] * a[2];
+        const T s4 = a[1] * a[7] - a[5] * a[3];
+        const T s5 = a[2] * a[7] - a[6] * a[3];
+        const T c5 = a[10] * a[15] - a[14] * a[11];
+        const T c4 = a[9] * a[15] - a[13] * a[11];
+        const T c3 = a[9] * a[14] - a[13] * a[10];
+        const T c2 = a[8] * a[15] - a[12] * a[11];
+        const T c1 = a[8] * a[14] - a[12] * a[10];
+        const T c0 = a[8] * a[13] - a[12] * a[9];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+}
+
+template <class MDSpan>
+constexpr auto static_det(MDSpan a)
+{
+    return static_det<MDSpan::static_extent(0)>(static_load(a));
+}
+
+// res = inv(a) from the adjugate, where res may alias a.
+template <class MDSpanA, class MDSpanRes>
+constexpr void static_inv(MDSpanA a, MDSpanRes res)
+{
+    using value_type = std::remove_cv_t<typename MDSpanA::element_type>;
+    using index_type = typename MDSpanRes::index_type;
+    constexpr std::size_t n = MDSpanA::static_extent(0);
+
+    const auto x = static_load(a);
+    const value_type d = static_det<n>(x);
+    if (d == value_type{0}) {
+        throw std::runtime_error("inv: matrix not invertible");
+    }
+    std::array<value_type, n * n> adj{};
+    if constexpr (n == 1) {
+        adj = {1};
+    }
+    else if constexpr (n == 2) {
+        adj = {x[3], -x[1], -x[2], x[0]};
+    }
+    else if constexpr (n == 3) {
+        adj = {x[4] * x[8] - x[5] * x[7], x[2] * x[7] - x[1] * x[8], x[1] * x[5] - x[2] * x[4],
+               x[5] * x[6] - x[3] * x[8], x[0] * x[8] - x[2] * x[6], x[2] * x[3] - x[0] * x[5],
+               x[3] * x[7] - x[4] * x[6], x[1] * x[6] - x[0] * x[7], x[0] * x[4] - x[1] * x[3]};
+    }
+    else if constexpr (n == 4) {
+        const value_type s0 = x[0] * x[5] - x[4] * x[1];
+        const value_type s1 = x[0] * x[6] - x[4] * x[2];
+        const value_type s2 = x[0] * x[7] - x[4] * x[3];
+        const value_type s3 = x[1] * x[6] - x[5] * x[2];
+        const value_type s4 = x[1] * x[7] - x[5] * x[3];
+        const value_type s5 = x[2] * x[7] - x[6] * x[3];
+        const value_type c5 = x[10] * x[15] - x[14] * x[11];
+        const value_type c4 = x[9] * x[15] - x[13] * x[11];
+        const value_type c3 = x[9] * x[14] - x[13] * x[10];
+        const value_type c2 = x[8] * x[15] - x[12] * x[11];
+        const value_type c1 = x[8] * x[14] - x[12] * x[10];
+        const value_type c0 = x[8] * x[13] - x[12] * x[9];
+        adj = {x[5] * c5 - x[6] * c4 + x[7] * c3,    -x[1] * c5 + x[2] * c4 - x[3] * c3,
+               x[13] * s5 - x[14] * s4 + x[15] * s3, -x[9] * s5 + x[10] * s4 - x[11] * s3,
+               -x[4] * c5 + x[6] * c2 - x[7] * c1,   x[0] * c5 - x[2] * c2 + x[3] * c1,
+               -x[12] * s5 + x[14] * s2 - x[15] * s1, x[8] * s5 - x[10] * s2 + x[11] * s1,
+               x[4] * c4 - x[5] * c2 + x[7] * c0,    -x[0] * c4 + x[1] * c2 - x[3] * c0,
+               x[12] * s4 - x[13] * s2 + x[15] * s0, -x[8] * s4 + x[9] * s2 - x[11] * s0,
+               -x[4] * c3 + x[5] * c1 - x[6] * c0,   x[0] * c3 - x[1] * c1 + x[2] * c0,
+               -x[12] * s3 + x[13] * s1 - x[14] * s0, x[8] * s3 - x[9] * s1 + x[10] * s0};
+    }
+    const value_type dinv = value_type{1} / d;
+    static_for<index_type, n>([&](auto i) {
+        static_for<index_type, n>([&](auto j) { res(i, j) = adj[i * n + j] * dinv; });
+    });
+}
+
+// Solve a * x = b by Gaussian elimination with partial pivoting. On exit a
+// holds the LU factors as from getrf and b the solution.
+template <class MDSpanA, class MDSpanB>
+constexpr void static_solve(MDSpanA a, MDSpanB b)
+{
+    using value_type = typename MDSpanA::value_type;
+    using index_type = typename MDSpanA::index_type;
+    constexpr auto n = static_cast<index_type>(MDSpanA::static_extent(0));
+
+    const auto nrhs = static_cast<index_type>(b.extent(1));
+    for (index_type k = 0; k < n; ++k) {
+        index_type p = k;
+        for (index_type i = k + 1; i < n; ++i) {
+            if (static_abs(a(i, k)) > static_abs(a(p, k))) {
+                p = i;
+            }
+        }
+        if (a(p, k) == value_type{0}) {
+            throw std::runtime_error("solve: factor U is singular");
+        }
+        if (p != k) {
+            for (index_type j = 0; j < n; ++j) {
+                std::swap(a(k, j), a(p, j));
+            }
+            for (index_type j = 0; j < nrhs; ++j) {
+                std::swap(b(k, j), b(p, j));
+            }
+        }
+        for (index_type i = k + 1; i < n; ++i) {
+            const value_type l = a(i, k) / a(k, k);
+            a(i, k) = l;
+            for (index_type j = k + 1; j < n; ++j) {
+                a(i, j) -= l * a(k, j);
+            }
+            for (index_type j = 0; j < nrhs; ++j) {
+                b(i, j) -= l * b(k, j);
+            }
+        }
+    }
+    for (index_type j = 0; j < nrhs; ++j) {
+        for (index_type i = n; i-- > 0;) {
+            value_type s = b(i, j);
+            for (index_type k = i + 1; k < n; ++k) {
+                s -= a(i, k) * b(k, j);
+            }
+            b(i, j) = s / a(i, i);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Eigenvalues and eigenvectors of symmetric 3 x 3 matrices:
+//
+// The eigenvalues are the roots of the characteristic polynomial, computed
+// with the trigonometric solution of the cubic. The eigenvector of the most
+// separated eigenvalue is the largest cross product of two rows of
+// a - lambda * I, the second eigenvector is computed in its orthogonal
+// complement, and the third is the cross product of the other two. This
+// keeps the eigenvectors orthonormal for repeated eigenvalues (see D. Eberly,
+// A Robust Eigensolver for 3 x 3 Symmetric Matrices, 2014). The eigenpairs
+// are then refined by Jacobi rotations, since acos is ill-conditioned for
+// nearly repeated eigenvalues.
+
+using Vec3 = std::array<double, 3>;
+
+constexpr Vec3 cross3(const Vec3& u, const Vec3& v)
+{
+    return {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+}
+
+constexpr double dot3(const Vec3& u, const Vec3& v)
+{
+    return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+}
+
+// a is stored as {a00, a01, a02, a11, a12, a22}.
+inline Vec3 sym3_eigenvector0(const std::array<double, 6>& a, double lambda)
+{
+    const Vec3 r0 = {a[0] - lambda, a[1], a[2]};
+    const Vec3 r1 = {a[1], a[3] - lambda, a[4]};
+    const Vec3 r2 = {a[2], a[4], a[5] - lambda};
+    const std::array<Vec3, 3> c = {cross3(r0, r1), cross3(r0, r2), cross3(r1, r2)};
+    const Vec3 d = {dot3(c[0], c[0]), dot3(c[1], c[1]), dot3(c[2], c[2])};
+
+    std::size_t imax = 0;
+    if (d[1] > d[imax]) {
+        imax = 1;
+    }
+    if (d[2] > d[imax]) {
+        imax = 2;
+    }
+    const double s = 1.0 / std::sqrt(d[imax]);
+    return {c[imax][0] * s, c[imax][1] * s, c[imax][2] * s};
+}
+
+inline Vec3 sym3_eigenvector1(const std::array<double, 6>& a, const Vec3& v0, double lambda)
+{
+    // Orthonormal basis {u, v} of the complement of v0.
+    Vec3 u;
+    if (std::abs(v0[0]) > std::abs(v0[1])) {
+        const double s = 1.0 / std::sqrt(v0[0] * v0[0] + v0[2] * v0[2]);
+        u = {-v0[2] * s, 0.0, v0[0] * s};
+    }
+    else {
+        const double s = 1.0 / std::sqrt(v0[1] * v0[1] + v0[2] * v0[2]);
+        u = {0.0, v0[2] * s, -v0[1] * s};
+    }
+    const Vec3 v = cross3(v0, u);
+
+    auto mul = [&](const Vec3& x) -> Vec3 {
+        return {a[0] * x[0] + a[1] * x[1] + a[2] * x[2], a[1] * x[0] + a[3] * x[1] + a[4] * x[2],
+                a[2] * x[0] + a[4] * x[1] + a[5] * x[2]};
+    };
+    // The 2 x 2 matrix of a - lambda * I in the basis {u, v} is singular;
+    // its null vector gives the eigenvector.
+    const Vec3 au = mul(u);
+    const Vec3 av = mul(v);
+    double m00 = dot3(u, au) - lambda;
+    double m01 = dot3(u, av);
+    double m11 = dot3(v, av) - lambda;
+
+    const double abs00 = std::abs(m00);
+    const double abs01 = std::abs(m01);
+    const double abs11 = std::abs(m11);
+    double x;
+    double y;
+    if (abs00 >= abs11) {
+        if (std::max(abs00, abs01) == 0.0) {
+            return u;
+        }
+        if (abs00 >= abs01) {
+            m01 /= m00;
+            m00 = 1.0 / std::sqrt(1.0 + m01 * m01);
+            m01 *= m00;
+        }
+        else {
+            m00 /= m01;
+            m01 = 1.0 / std::sqrt(1.0 + m00 * m00);
+            m00 *= m01;
+        }
+        x = m01;
+        y = -m00;
+    }
+    else {
+        if (std::max(abs11, abs01) == 0.0) {
+            return u;
+        }
+        if (abs11 >= abs01) {
+            m01 /= m11;
+            m11 = 1.0 / std::sqrt(1.0 + m01 * m01);
+            m01 *= m11;
+        }
+        else {
+            m11 /= m01;
+            m01 = 1.0 / std::sqrt(1.0 + m11 * m11);
+            m11 *= m01;
+        }
+        x = m11;
+        y = -m01;
+    }
+    return {x * u[0] + y * v[0], x * u[1] + y * v[1], x * u[2] + y * v[2]};
+}
+
+// Refine the eigenpairs (eval, evec) of a by Jacobi rotations of
+// b = z' * a * z, where z holds the eigenvectors in columns. Since z is
+// orthonormal to working precision, b is nearly diagonal and the rotations
+// converge quadratically. The eigenpairs are sorted in ascending order.
+inline void sym3_refine(const std::array<double, 6>& a, Vec3& eval, std::array<Vec3, 3>& evec)
+{
+    const std::array<Vec3, 3> rows = {
+        Vec3{a[0], a[1], a[2]}, Vec3{a[1], a[3], a[4]}, Vec3{a[2], a[4], a[5]}};
+
+    std::array<Vec3, 3> b;
+    for (std::size_t l = 0; l < 3; ++l) {
+        const Vec3 az = {dot3(rows[0], evec[l]), dot3(rows[1], evec[l]), dot3(rows[2], evec[l])};
+        for (std::size_t k = 0; k < 3; ++k) {
+            b[k][l] = dot3(evec[k], az);
+        }
+    }
+    constexpr std::array<std::pair<std::size_t, std::size_t>, 3> pairs = {
+        std::pair<std::size_t, std::size_t>{0, 1}, {0, 2}, {1, 2}};
+
+    for (int sweep = 0; sweep < 4; ++sweep) {
+        bool converged = true;
+        for (const auto& [p, q] : pairs) {
+            const double bpq = 0.5 * (b[p][q] + b[q][p]);
+            if (bpq == 0.0) {
+                continue;
+            }
+            converged = false;
+            const double theta = (b[q][q] - b[p][p]) / (2.0 * bpq);
+            double t = 1.0 / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+            if (theta < 0.0) {
+                t = -t;
+            }
+            const double c = 1.0 / std::sqrt(t * t + 1.0);
+            const double s = t * c;
+            const std::size_t r = 3 - p - q;
+            const double brp = b[r][p];
+            const double brq = b[r][q];
+            b[p][p] -= t * bpq;
+            b[q][q] += t * bpq;
+            b[p][q] = b[q][p] = 0.0;
+            b[r][p] = b[p][r] = c * brp - s * brq;
+            b[r][q] = b[q][r] = s * brp + c * brq;
+            for (std::size_t i = 0; i < 3; ++i) {
+                const double zp = evec[p][i];
+                const double zq = evec[q][i];
+                evec[p][i] = c * zp - s * zq;
+                evec[q][i] = s * zp + c * zq;
+            }
+        }
+        if (converged) {
+            break;
+        }
+    }
+    eval = {b[0][0], b[1][1], b[2][2]};
+    for (std::size_t k = 1; k < 3; ++k) {
+        for (std::size_t l = k; l > 0 && eval[l - 1] > eval[l]; --l) {
+            std::swap(eval[l - 1], eval[l]);
+            std::swap(evec[l - 1], evec[l]);
+        }
+    }
+}
+
+// Overwrite a with the eigenvectors (in columns) and store the eigenvalues
+// in ascending order in w. Only the uplo triangle of a is referenced.
+template <class MDSpanA, class MDSpanW>
+void static_eigh3(MDSpanA a, MDSpanW w, char uplo)
+{
+    using index_type = typename MDSpanA::index_type;
+
+    auto elem = [&](index_type i, index_type j) {
+        return (uplo == 'U' || uplo == 'u') ? a(i, j) : a(j, i);
+    };
+    std::array<double, 6> s = {elem(0, 0), elem(0, 1), elem(0, 2),
+                               elem(1, 1), elem(1, 2), elem(2, 2)};
+
+    // Scale to avoid overflow and underflow.
+    double smax = 0.0;
+    for (double x : s) {
+        smax = std::max(smax, std::abs(x));
+    }
+    Vec3 eval = {0.0, 0.0, 0.0};
+    std::array<Vec3, 3> evec = {Vec3{1.0, 0.0, 0.0}, Vec3{0.0, 1.0, 0.0}, Vec3{0.0, 0.0, 1.0}};
+
+    if (smax > 0.0) {
+        for (double& x : s) {
+            x /= smax;
+        }
+        const double q = (s[0] + s[3] + s[5]) / 3.0;
+        const double b00 = s[0] - q;
+        const double b11 = s[3] - q;
+        const double b22 = s[5] - q;
+        const double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 +
+                                    2.0 * (s[1] * s[1] + s[2] * s[2] + s[4] * s[4])) /
+                                   6.0);
+        if (p == 0.0) { // multiple of the identity
+            eval = {q, q, q};
+        }
+        else {
+            const double c00 = b11 * b22 - s[4] * s[4];
+            const double c01 = s[1] * b22 - s[4] * s[2];
+            const double c02 = s[1] * s[4] - b11 * s[2];
+            const double half_det =
+                std::clamp((b00 * c00 - s[1] * c01 + s[2] * c02) / (2.0 * p * p * p), -1.0, 1.0);
+
+            const double angle = std::acos(half_det) / 3.0;
+            const double beta2 = 2.0 * std::cos(angle);
+            const double beta0 = 2.0 * std::cos(angle + 2.0 * std::numbers::pi / 3.0);
+            const double beta1 = -(beta0 + beta2);
+            eval = {q + p * beta0, q + p * beta1, q + p * beta2};
+
+            if (half_det >= 0.0) {
+                evec[2] = sym3_eigenvector0(s, eval[2]);
+                evec[1] = sym3_eigenvector1(s, evec[2], eval[1]);
+                evec[0] = cross3(evec[1], evec[2]);
+            }
+            else {
+                evec[0] = sym3_eigenvector0(s, eval[0]);
+                evec[1] = sym3_eigenvector1(s, evec[0], eval[1]);
+                evec[2] = cross3(evec[0], evec[1]);
+            }
+            sym3_refine(s, eval, evec);
+        }
+    }
+    for (index_type k = 0; k < 3; ++k) {
+        w(k) = eval[k] * smax;
+        for (index_type i = 0; i < 3; ++i) {
+            a(i, k) = evec[k][i];
+        }
+    }
+}
+
+} // namespace __Detail
+
+} // namespace Sci
+
+#endif // SCILIB_LINALG_STATIC_KERNELS_H
@@ -29,6 +29,15 @@ inline T trace(const Sci::MDArray<T, Kokkos::extents<IndexType, ext, ext>, Layou
     return trace(m.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto trace(const E& e)
+{
+    return trace(Sci::__Detail::eval(e));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -7,8 +7,11 @@
 #ifndef SCILIB_LINALG_TRANSPOSED_H
 #define SCILIB_LINALG_TRANSPOSED_H
 
+#include <algorithm>
 #include <experimental/linalg>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Sci {
 namespace Linalg {
@@ -27,6 +30,201 @@ transposed(const Sci::MDArray<T, Kokkos::extents<IndexType, nrows, ncols>, Layou
         Kokkos::Experimental::linalg::transposed(a.to_mdspan()));
 }
 
+//--------------------------------------------------------------------------------------------------
+// In-place transpose:
+//
+// Square matrices are transposed by swapping pairs of blocks across the
+// diagonal. Rectangular m x n matrices are transposed by following the
+// cycles of the permutation k -> k * m mod (m * n - 1) of the storage. If
+// one extent is a multiple of the other, the matrix is instead split into
+// square blocks that are transposed in place, and whole rows of the blocks
+// are moved along the cycles, which needs a buffer of min(m, n) elements.
+// Otherwise elements are moved one at a time, which needs O(1) memory but
+// is much slower than the blocked cases due to the random access.
+//
+// The transpose runs on the calling thread. With a parallel execution
+// policy the square blocks are swapped on the thread pool:
+//
+//   Sci::Linalg::transpose_inplace(Sci::par, a);
+
+namespace __Detail {
+
+// Swap a(i, j) and a(j, i) for i in [i0, i1) and j in [j0, j1), j > i, of
+// the row-major n x n matrix a.
+template <class T, class IndexType>
+inline void swap_transposed_blocks(
+    T* a, IndexType n, IndexType i0, IndexType i1, IndexType j0, IndexType j1)
+{
+    for (IndexType i = i0; i < i1; ++i) {
+        for (IndexType j = std::max(j0, i + 1); j < j1; ++j) {
+            std::swap(a[i * n + j], a[j * n + i]);
+        }
+    }
+}
+
+template <class Policy, class T, class IndexType>
+inline void transpose_square(Policy policy, T* a, IndexType n)
+{
+    constexpr IndexType b = SCILIB_TRANSPOSE_BLOCK;
+
+    // Block row p is paired with block row nb - 1 - p to balance the work
+    // of the chunks of the triangle.
+    const IndexType nb = (n + b - 1) / b;
+    auto block_row = [&](IndexType bi) {
+        const IndexType i0 = bi * b;
+        const IndexType i1 = std::min(n, i0 + b);
+        for (IndexType j0 = i0; j0 < n; j0 += b) {
+            swap_transposed_blocks(a, n, i0, i1, j0, std::min(n, j0 + b));
+        }
+    };
+    const auto nelem = static_cast<std::size_t>(n) * static_cast<std::size_t>(n) / 2;
+    Sci::__Detail::parallel_for(
+        policy, (nb + 1) / 2, nelem, [&](IndexType first, IndexType last) {
+            for (IndexType p = first; p < last; ++p) {
+                block_row(p);
+                if (nb - 1 - p != p) {
+                    block_row(nb - 1 - p);
+                }
+            }
+        });
+}
+
+// Transpose the row-major rows x cols matrix of chunks of len elements.
+// Each cycle is moved once, starting from its smallest position.
+template <class T, class IndexType>
+inline void transpose_chunks(T* a, IndexType rows, IndexType cols, IndexType len)
+{
+    if (rows <= 1 || cols <= 1) {
+        return;
+    }
+    const IndexType q = rows * cols - 1;
+    auto prev = [&](IndexType p) { return (p * cols) % q; }; // position moved to p
+
+    std::vector<T> buf(static_cast<std::size_t>(len));
+    for (IndexType s = 1; s < q; ++s) {
+        IndexType p = prev(s);
+        while (p > s) {
+            p = prev(p);
+        }
+        if (p < s) { // s is not the smallest position of its cycle
+            continue;
+        }
+        std::move(a + s * len, a + (s + 1) * len, buf.begin());
+        p = s;
+        for (IndexType src = prev(p); src != s; p = src, src = prev(src)) {
+            std::move(a + src * len, a + (src + 1) * len, a + p * len);
+        }
+        std::move(buf.begin(), buf.end(), a + p * len);
+    }
+}
+
+// Transpose the row-major m x n matrix a into a row-major n x m matrix.
+template <class Policy, class T, class IndexType>
+inline void transpose_storage(Policy policy, T* a, IndexType m, IndexType n)
+{
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (m == n) {
+        transpose_square(policy, a, n);
+    }
+    else if (m % n == 0) { // k stacked n x n blocks
+        for (IndexType t = 0; t < m / n; ++t) {
+            transpose_square(policy, a + t * n * n, n);
+        }
+        transpose_chunks(a, m / n, n, n);
+    }
+    else if (n % m == 0) { // k m x m blocks side by side
+        transpose_chunks(a, m, n / m, m);
+        for (IndexType t = 0; t < n / m; ++t) {
+            transpose_square(policy, a + t * m * m, m);
+        }
+    }
+    else {
+        transpose_chunks(a, m, n, IndexType{1});
+    }
+}
+
+template <class Layout>
+inline constexpr bool Is_dense_layout_v =
+    std::is_same_v<Layout, Kokkos::layout_left> || std::is_same_v<Layout, Kokkos::layout_right>;
+
+} // namespace __Detail
+
+// Transpose a matrix without allocating a second matrix. The extents are
+// swapped, hence both extents must be dynamic unless the matrix is square.
+template <class ExecutionPolicy, class T, class Extents, class Layout, class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && Extents::rank() == 2 &&
+             __Detail::Is_dense_layout_v<Layout> &&
+             Extents::static_extent(0) == Extents::static_extent(1))
+inline void transpose_inplace(ExecutionPolicy&& policy,
+                              Sci::MDArray<T, Extents, Layout, Container>& a)
+{
+    using index_type = typename Extents::index_type;
+
+    const index_type m = a.extent(0);
+    const index_type n = a.extent(1);
+    if constexpr (std::is_same_v<Layout, Kokkos::layout_right>) {
+        __Detail::transpose_storage(policy, a.container_data(), m, n);
+    }
+    else {
+        __Detail::transpose_storage(policy, a.container_data(), n, m);
+    }
+    if constexpr (Extents::rank_dynamic() == 2) {
+        if (m != n) {
+            a = Sci::MDArray<T, Extents, Layout, Container>(Extents(n, m), a.extract_container());
+        }
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+    requires(Extents::rank() == 2 && __Detail::Is_dense_layout_v<Layout> &&
+             Extents::static_extent(0) == Extents::static_extent(1))
+inline void transpose_inplace(Sci::MDArray<T, Extents, Layout, Container>& a)
+{
+    transpose_inplace(Sci::execution::seq, a);
+}
+
+// Switch the storage order of a matrix between layout_right and layout_left
+// without allocating a second matrix, e.g. before handing it to LAPACK:
+//
+//   auto b = Sci::Linalg::change_layout<Sci::layout_left>(std::move(a));
+template <class OtherLayout,
+          class ExecutionPolicy,
+          class T,
+          class Extents,
+          class Layout,
+          class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && Extents::rank() == 2 &&
+             __Detail::Is_dense_layout_v<Layout> && __Detail::Is_dense_layout_v<OtherLayout>)
+inline Sci::MDArray<T, Extents, OtherLayout, Container>
+change_layout(ExecutionPolicy&& policy, Sci::MDArray<T, Extents, Layout, Container>&& a)
+{
+    using index_type = typename Extents::index_type;
+
+    const Extents exts = a.extents();
+    if constexpr (!std::is_same_v<Layout, OtherLayout>) {
+        const index_type m = a.extent(0);
+        const index_type n = a.extent(1);
+        if constexpr (std::is_same_v<Layout, Kokkos::layout_right>) {
+            __Detail::transpose_storage(policy, a.container_data(), m, n);
+        }
+        else {
+            __Detail::transpose_storage(policy, a.container_data(), n, m);
+        }
+    }
+    return Sci::MDArray<T, Extents, OtherLayout, Container>(exts, a.extract_container());
+}
+
+template <class OtherLayout, class T, class Extents, class Layout, class Container>
+    requires(Extents::rank() == 2 && __Detail::Is_dense_layout_v<Layout> &&
+             __Detail::Is_dense_layout_v<OtherLayout>)
+inline Sci::MDArray<T, Extents, OtherLayout, Container>
+change_layout(Sci::MDArray<T, Extents, Layout, Container>&& a)
+{
+    return change_layout<OtherLayout>(Sci::execution::seq, std::move(a));
+}
+
 } // namespace Linalg
 } // namespace Sci
 
@@ -26,7 +26,12 @@
 #pragma warning(default : 4702)
 #endif // _MSC_VER
 
+#include "mdarray_impl/aligned_allocator.h"
+#include "mdarray_impl/init_allocator.h"
+#include "mdarray_impl/layout_tiled.h"
+#include "mdarray_impl/mmap_container.h"
 #include <gsl/gsl>
+#include <memory_resource>
 #include <utility>
 #include <valarray>
 #include <vector>
@@ -140,6 +145,172 @@ using Array7D = MDArray<ElementType,
                         LayoutPolicy,
                         std::vector<ElementType>>;
 
+//--------------------------------------------------------------------------------------------------
+// Heap-allocated MDArrays with aligned storage:
+
+template <class ElementType, std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using Aligned_container = std::vector<ElementType, aligned_allocator<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedVector = MDArray<ElementType,
+                              Kokkos::dextents<index, 1>,
+                              LayoutPolicy,
+                              Aligned_container<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedMatrix = MDArray<ElementType,
+                              Kokkos::dextents<index, 2>,
+                              LayoutPolicy,
+                              Aligned_container<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedArray3D = MDArray<ElementType,
+                               Kokkos::dextents<index, 3>,
+                               LayoutPolicy,
+                               Aligned_container<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedArray4D = MDArray<ElementType,
+                               Kokkos::dextents<index, 4>,
+                               LayoutPolicy,
+                               Aligned_container<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedArray5D = MDArray<ElementType,
+                               Kokkos::dextents<index, 5>,
+                               LayoutPolicy,
+                               Aligned_container<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedArray6D = MDArray<ElementType,
+                               Kokkos::dextents<index, 6>,
+                               LayoutPolicy,
+                               Aligned_container<ElementType, Alignment>>;
+
+template <class ElementType,
+          class LayoutPolicy = Kokkos::layout_right,
+          std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+using AlignedArray7D = MDArray<ElementType,
+                               Kokkos::dextents<index, 7>,
+                               LayoutPolicy,
+                               Aligned_container<ElementType, Alignment>>;
+
+//--------------------------------------------------------------------------------------------------
+// Heap-allocated MDArrays with tiled storage (see layout_tiled.h):
+
+template <class ElementType, std::size_t TileRows = 32, std::size_t TileCols = 32>
+using TiledMatrix = MDArray<ElementType,
+                            Kokkos::dextents<index, 2>,
+                            layout_tiled<TileRows, TileCols>,
+                            std::vector<ElementType>>;
+
+template <class ElementType, std::size_t Tile0 = 16, std::size_t Tile1 = 16, std::size_t Tile2 = 16>
+using TiledArray3D = MDArray<ElementType,
+                             Kokkos::dextents<index, 3>,
+                             layout_tiled<Tile0, Tile1, Tile2>,
+                             std::vector<ElementType>>;
+
+//--------------------------------------------------------------------------------------------------
+// File-backed MDArrays (see mmap_container.h):
+
+#ifdef SCILIB_HAS_MMAP
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using MappedVector =
+    MDArray<ElementType, Kokkos::dextents<index, 1>, LayoutPolicy, mmap_container<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using MappedMatrix =
+    MDArray<ElementType, Kokkos::dextents<index, 2>, LayoutPolicy, mmap_container<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using MappedArray3D =
+    MDArray<ElementType, Kokkos::dextents<index, 3>, LayoutPolicy, mmap_container<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using MappedArray4D =
+    MDArray<ElementType, Kokkos::dextents<index, 4>, LayoutPolicy, mmap_container<ElementType>>;
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// Containers for the construction tags (see init_allocator.h):
+
+template <class ElementType, class Allocator = std::allocator<ElementType>>
+using Default_init_container =
+    std::vector<ElementType, default_init_allocator<ElementType, Allocator>>;
+
+template <class ElementType>
+using Zero_page_container = std::vector<ElementType, zero_page_allocator<ElementType>>;
+
+//--------------------------------------------------------------------------------------------------
+// Heap-allocated MDArrays using polymorphic memory resources:
+//
+// The memory resource is passed as the allocator argument, e.g.
+//
+//   Sci::Workspace ws(1 << 20);
+//   Sci::pmr::Matrix<double> a(Kokkos::dextents<Sci::index, 2>(n, n), &ws);
+
+namespace pmr {
+
+template <class ElementType>
+using Default_init_container =
+    Sci::Default_init_container<ElementType, std::pmr::polymorphic_allocator<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Vector = MDArray<ElementType,
+                       Kokkos::dextents<index, 1>,
+                       LayoutPolicy,
+                       std::pmr::vector<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Matrix = MDArray<ElementType,
+                       Kokkos::dextents<index, 2>,
+                       LayoutPolicy,
+                       std::pmr::vector<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Array3D = MDArray<ElementType,
+                        Kokkos::dextents<index, 3>,
+                        LayoutPolicy,
+                        std::pmr::vector<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Array4D = MDArray<ElementType,
+                        Kokkos::dextents<index, 4>,
+                        LayoutPolicy,
+                        std::pmr::vector<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Array5D = MDArray<ElementType,
+                        Kokkos::dextents<index, 5>,
+                        LayoutPolicy,
+                        std::pmr::vector<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Array6D = MDArray<ElementType,
+                        Kokkos::dextents<index, 6>,
+                        LayoutPolicy,
+                        std::pmr::vector<ElementType>>;
+
+template <class ElementType, class LayoutPolicy = Kokkos::layout_right>
+using Array7D = MDArray<ElementType,
+                        Kokkos::dextents<index, 7>,
+                        LayoutPolicy,
+                        std::pmr::vector<ElementType>>;
+
+} // namespace pmr
+
 } // namespace Sci
 
 // clang-format off
@@ -151,7 +322,10 @@ using Array7D = MDArray<ElementType,
 #include "mdarray_impl/swap_elements.h"
 #include "mdarray_impl/slice.h"
 #include "mdarray_impl/mdarray_bits.h"
+#include "mdarray_impl/expression.h"
 #include "mdarray_impl/operations.h"
+#include "mdarray_impl/workspace.h"
+#include "mdarray_impl/npy.h"
 // clang-format on
 
 #endif // SCILIB_MDARRAY_H
@@ -0,0 +1,82 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_ALIGNED_ALLOCATOR_H
+#define SCILIB_MDARRAY_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifndef SCILIB_MEM_ALIGNMENT
+#define SCILIB_MEM_ALIGNMENT 64
+#endif
+
+namespace Sci {
+
+// Allocator returning storage aligned to the given boundary (64 bytes by
+// default, i.e. a cache line and an AVX-512 register). Only the standard
+// library is used, hence it is available for all BLAS backends.
+template <class T, std::size_t Alignment = SCILIB_MEM_ALIGNMENT>
+class aligned_allocator {
+public:
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0,
+                  "alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "alignment must not be weaker than alignof(T)");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment = Alignment;
+
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    constexpr aligned_allocator() noexcept = default;
+    constexpr aligned_allocator(const aligned_allocator&) noexcept = default;
+
+    template <class U>
+    constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(size_type n)
+    {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, size_type n) noexcept
+    {
+        ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+    }
+};
+
+template <class T1, class T2, std::size_t Alignment>
+constexpr bool operator==(const aligned_allocator<T1, Alignment>&,
+                          const aligned_allocator<T2, Alignment>&) noexcept
+{
+    return true;
+}
+
+template <class T1, class T2, std::size_t Alignment>
+constexpr bool operator!=(const aligned_allocator<T1, Alignment>& lhs,
+                          const aligned_allocator<T2, Alignment>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_ALIGNED_ALLOCATOR_H
@@ -7,35 +7,263 @@
 #ifndef SCILIB_MDARRAY_COPY_H
 #define SCILIB_MDARRAY_COPY_H
 
+#include "execution.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <gsl/gsl>
 #include <type_traits>
+#include <utility>
+
+// Edge of the square blocks at which the recursive transpose stops.
+#ifndef SCILIB_TRANSPOSE_BLOCK
+#define SCILIB_TRANSPOSE_BLOCK 32
+#endif
 
 namespace Sci {
 
+//--------------------------------------------------------------------------------------------------
+// Copy engine:
+//
+// Used by Sci::copy and the converting constructors of MDArray. Views of
+// contiguous memory are copied as follows:
+//
+// - With the same exhaustive mapping: a single memcpy (or std::copy_n if the
+//   element types differ).
+// - Matrices where one view is row-major and the other column-major: a
+//   cache-oblivious transpose, which recursively halves the larger extent
+//   until the blocks fit in L1 cache. Each block touches few pages, hence
+//   large transposes are not limited by TLB misses.
+// - Other strided views: nested loops ordered by the destination strides,
+//   so that writes are as contiguous as possible.
+//
+// Other views are copied element by element in the storage order of the
+// source, or in tile order if one of the views is tiled.
+//
+// Copies run on the calling thread, as do the MDArray operators. Large
+// transposes are split over the thread pool only if Sci::copy is given a
+// parallel execution policy (see execution.h):
+//
+//   Sci::copy(Sci::par, a.to_mdspan(), b.to_mdspan());
 
-template <class T_x,
+namespace __Detail {
+
+template <class T, class U>
+constexpr void copy_contiguous(const T* x, std::size_t n, U* y)
+{
+    if constexpr (std::is_same_v<std::remove_cv_t<T>, U> && std::is_trivially_copyable_v<U>) {
+        if (!std::is_constant_evaluated()) {
+            if (n > 0) {
+                std::memcpy(y, x, n * sizeof(U));
+            }
+            return;
+        }
+    }
+    std::copy_n(x, n, y);
+}
+
+// y[j * ldy + i] = x[i * ldx + j] for a B x B block. The rows of x are
+// loaded into a local buffer, and each row of y is written by an unrolled
+// sequence of stores that the compiler assembles from the buffer with
+// shuffles.
+template <std::size_t B, class T, class U, class IndexType>
+MDSPAN_FORCE_INLINE_FUNCTION void
+transpose_kernel(const T* x, IndexType ldx, U* y, IndexType ldy)
+{
+    T buf[B][B];
+    for (std::size_t i = 0; i < B; ++i) {
+        for (std::size_t j = 0; j < B; ++j) {
+            buf[i][j] = x[i * ldx + j];
+        }
+    }
+    for (std::size_t j = 0; j < B; ++j) {
+        U* yj = y + j * ldy;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((yj[I] = buf[I][j]), ...);
+        }(std::make_index_sequence<B>());
+    }
+}
+
+// Transpose rows [i0, i1) and columns [j0, j1) of the row-major x into y.
+template <class T, class U, class IndexType>
+void transpose_recursive(const T* x,
+                         IndexType ldx,
+                         U* y,
+                         IndexType ldy,
+                         IndexType i0,
+                         IndexType i1,
+                         IndexType j0,
+                         IndexType j1)
+{
+    constexpr IndexType b = SCILIB_TRANSPOSE_BLOCK;
+    constexpr IndexType kb = 8; // kernel block
+
+    const IndexType m = i1 - i0;
+    const IndexType n = j1 - j0;
+    if (m <= b && n <= b) {
+        const IndexType ie = i0 + m / kb * kb;
+        const IndexType je = j0 + n / kb * kb;
+        for (IndexType i = i0; i < ie; i += kb) {
+            for (IndexType j = j0; j < je; j += kb) {
+                transpose_kernel<kb>(x + i * ldx + j, ldx, y + j * ldy + i, ldy);
+            }
+        }
+        for (IndexType j = j0; j < j1; ++j) {
+            for (IndexType i = (j < je) ? ie : i0; i < i1; ++i) {
+                y[j * ldy + i] = x[i * ldx + j];
+            }
+        }
+        return;
+    }
+    // Split at a multiple of the block size to keep the leaves full.
+    if (m >= n) {
+        const IndexType mid = i0 + (m / 2 + b - 1) / b * b;
+        transpose_recursive(x, ldx, y, ldy, i0, mid, j0, j1);
+        transpose_recursive(x, ldx, y, ldy, mid, i1, j0, j1);
+    }
+    else {
+        const IndexType mid = j0 + (n / 2 + b - 1) / b * b;
+        transpose_recursive(x, ldx, y, ldy, i0, i1, j0, mid);
+        transpose_recursive(x, ldx, y, ldy, i0, i1, mid, j1);
+    }
+}
+
+// y(j, i) = x(i, j) for the m x n row-major x. The rows of x are split into
+// chunks of whole blocks for the thread pool.
+template <class Policy, class T, class U, class IndexType>
+void transpose(
+    Policy policy, const T* x, IndexType ldx, U* y, IndexType ldy, IndexType m, IndexType n)
+{
+    constexpr IndexType b = SCILIB_TRANSPOSE_BLOCK;
+
+    const IndexType nblocks = (m + b - 1) / b;
+    const auto nelem = static_cast<std::size_t>(m) * static_cast<std::size_t>(n);
+    parallel_for(policy, nblocks, nelem, [&](IndexType first, IndexType last) {
+        transpose_recursive(x, ldx, y, ldy, first * b, std::min(m, last * b), IndexType{0}, n);
+    });
+}
+
+template <std::size_t K, std::size_t Rank, class T, class U, class IndexType>
+MDSPAN_FORCE_INLINE_FUNCTION void strided_copy_impl(const T* x,
+                                                    U* y,
+                                                    const std::array<IndexType, Rank>& n,
+                                                    const std::array<IndexType, Rank>& sx,
+                                                    const std::array<IndexType, Rank>& sy)
+{
+    if constexpr (K == Rank - 1) {
+        if (sx[K] == 1 && sy[K] == 1) {
+            copy_contiguous(x, static_cast<std::size_t>(n[K]), y);
+        }
+        else {
+            for (IndexType i = 0; i < n[K]; ++i) {
+                y[i * sy[K]] = x[i * sx[K]];
+            }
+        }
+    }
+    else {
+        for (IndexType i = 0; i < n[K]; ++i) {
+            strided_copy_impl<K + 1>(x + i * sx[K], y + i * sy[K], n, sx, sy);
+        }
+    }
+}
+
+template <class Policy, class MDSpanX, class MDSpanY>
+void strided_copy(Policy policy, const MDSpanX& x, const MDSpanY& y)
+{
+    using index_type = typename MDSpanY::index_type;
+    constexpr std::size_t rank = MDSpanY::rank();
+
+    if (x.size() == 0) {
+        return;
+    }
+    std::array<index_type, rank> n;
+    std::array<index_type, rank> sx;
+    std::array<index_type, rank> sy;
+    for (std::size_t r = 0; r < rank; ++r) {
+        n[r] = static_cast<index_type>(y.extent(r));
+        sx[r] = static_cast<index_type>(x.stride(r));
+        sy[r] = static_cast<index_type>(y.stride(r));
+    }
+    if (sx == sy && x.is_exhaustive()) {
+        copy_contiguous(x.data_handle(), x.size(), y.data_handle());
+        return;
+    }
+    if constexpr (rank == 2) {
+        if (n[0] > 1 && n[1] > 1) {
+            if (sx[1] == 1 && sy[0] == 1) {
+                transpose(policy, x.data_handle(), sx[0], y.data_handle(), sy[1], n[0], n[1]);
+                return;
+            }
+            if (sx[0] == 1 && sy[1] == 1) {
+                transpose(policy, x.data_handle(), sx[1], y.data_handle(), sy[0], n[1], n[0]);
+                return;
+            }
+        }
+    }
+    // Loop over the extents in decreasing order of destination stride.
+    std::array<std::size_t, rank> order;
+    for (std::size_t r = 0; r < rank; ++r) {
+        order[r] = r;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return sy[a] > sy[b];
+    });
+    std::array<index_type, rank> pn;
+    std::array<index_type, rank> psx;
+    std::array<index_type, rank> psy;
+    for (std::size_t r = 0; r < rank; ++r) {
+        pn[r] = n[order[r]];
+        psx[r] = sx[order[r]];
+        psy[r] = sy[order[r]];
+    }
+    strided_copy_impl<0>(x.data_handle(), y.data_handle(), pn, psx, psy);
+}
+
+template <class Policy,
+          class T_x,
           class Extent_x,
           class Layout_x,
           class Accessor_x,
-          class Extent_y,
           class T_y,
+          class Extent_y,
           class Layout_y,
           class Accessor_y>
-    requires(!std::is_const_v<T_y>)
-inline void copy(Kokkos::mdspan<T_x, Extent_x, Layout_x, Accessor_x> x,
-                 Kokkos::mdspan<T_y, Extent_y, Layout_y, Accessor_y> y)
+constexpr void copy_elements(Policy policy,
+                             Kokkos::mdspan<T_x, Extent_x, Layout_x, Accessor_x> x,
+                             Kokkos::mdspan<T_y, Extent_y, Layout_y, Accessor_y> y)
 {
-    using IndexType_x = typename Extent_x::index_type;
-    using IndexType_y = typename Extent_y::index_type;
-    using index_type = std::common_type_t<IndexType_x, IndexType_y>;
+    using mapping_x = typename Layout_x::template mapping<Extent_x>;
+    using mapping_y = typename Layout_y::template mapping<Extent_y>;
+    using index_type = std::common_type_t<typename Extent_x::index_type,
+                                          typename Extent_y::index_type>;
 
-    for (std::size_t r = 0; r < x.rank(); ++r) {
-        Expects(gsl::narrow_cast<index_type>(x.extent(r)) ==
-                gsl::narrow_cast<index_type>(y.extent(r)));
+    constexpr bool is_pointer_access =
+        std::is_same_v<Accessor_x, Kokkos::default_accessor<T_x>> &&
+        std::is_same_v<Accessor_y, Kokkos::default_accessor<T_y>>;
+
+    if constexpr (is_pointer_access && Extent_y::rank() > 0) {
+        if (!std::is_constant_evaluated()) {
+            if constexpr (std::is_same_v<Layout_x, Layout_y> &&
+                          mapping_x::is_always_exhaustive() && mapping_y::is_always_exhaustive()) {
+                copy_contiguous(x.data_handle(), x.size(), y.data_handle());
+                return;
+            }
+            else if constexpr (mapping_x::is_always_strided() && mapping_y::is_always_strided()) {
+                strided_copy(policy, x, y);
+                return;
+            }
+            else if constexpr (std::is_same_v<Layout_x, Layout_y> && Is_layout_tiled_v<Layout_x>) {
+                if (x.mapping() == mapping_x(x.extents()) && y.mapping() == mapping_y(y.extents())) {
+                    copy_contiguous(x.data_handle(), x.size(), y.data_handle());
+                    return;
+                }
+            }
+        }
     }
     auto copy_fn = [&]<class... IndexTypes>(IndexTypes... indices)
     {
-#if __cpp_multidimensional_subscript
+#if MDSPAN_USE_BRACKET_OPERATOR
         y[gsl::narrow_cast<index_type>(std::move(indices))...] =
             x[gsl::narrow_cast<index_type>(std::move(indices))...];
 #else
@@ -43,7 +271,70 @@ inline void copy(Kokkos::mdspan<T_x, Extent_x, Layout_x, Accessor_x> x,
             x(gsl::narrow_cast<index_type>(std::move(indices))...);
 #endif
     };
-    for_each_in_extents(copy_fn, x);
+    // Traverse tiled views tile by tile, which accesses the other view in
+    // cache-sized blocks.
+    if constexpr (Is_layout_tiled_v<Layout_y>) {
+        for_each_in_extents(copy_fn, y.extents(), Layout_y{});
+    }
+    else {
+        for_each_in_extents(copy_fn, x);
+    }
+}
+
+template <class T_x,
+          class Extent_x,
+          class Layout_x,
+          class Accessor_x,
+          class T_y,
+          class Extent_y,
+          class Layout_y,
+          class Accessor_y>
+constexpr void copy_elements(Kokkos::mdspan<T_x, Extent_x, Layout_x, Accessor_x> x,
+                             Kokkos::mdspan<T_y, Extent_y, Layout_y, Accessor_y> y)
+{
+    copy_elements(Sci::execution::seq, x, y);
+}
+
+} // namespace __Detail
+
+template <class ExecutionPolicy,
+          class T_x,
+          class Extent_x,
+          class Layout_x,
+          class Accessor_x,
+          class Extent_y,
+          class T_y,
+          class Layout_y,
+          class Accessor_y>
+    requires(Is_execution_policy_v<ExecutionPolicy> && !std::is_const_v<T_y>)
+inline void copy(ExecutionPolicy&& policy,
+                 Kokkos::mdspan<T_x, Extent_x, Layout_x, Accessor_x> x,
+                 Kokkos::mdspan<T_y, Extent_y, Layout_y, Accessor_y> y)
+{
+    using IndexType_x = typename Extent_x::index_type;
+    using IndexType_y = typename Extent_y::index_type;
+    using index_type = std::common_type_t<IndexType_x, IndexType_y>;
+
+    for (std::size_t r = 0; r < x.rank(); ++r) {
+        Expects(gsl::narrow_cast<index_type>(x.extent(r)) ==
+                gsl::narrow_cast<index_type>(y.extent(r)));
+    }
+    __Detail::copy_elements(policy, x, y);
+}
+
+template <class T_x,
+          class Extent_x,
+          class Layout_x,
+          class Accessor_x,
+          class Extent_y,
+          class T_y,
+          class Layout_y,
+          class Accessor_y>
+    requires(!std::is_const_v<T_y>)
+inline void copy(Kokkos::mdspan<T_x, Extent_x, Layout_x, Accessor_x> x,
+                 Kokkos::mdspan<T_y, Extent_y, Layout_y, Accessor_y> y)
+{
+    Sci::copy(Sci::execution::seq, x, y);
 }
 
 } // namespace Sci
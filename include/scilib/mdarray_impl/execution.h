@@ -0,0 +1,340 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_EXECUTION_H
+#define SCILIB_MDARRAY_EXECUTION_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Number of elements below which the parallel policies run serially.
+#ifndef SCILIB_PARALLEL_THRESHOLD
+#define SCILIB_PARALLEL_THRESHOLD (1 << 17)
+#endif
+
+// Number of threads in the default thread pool (0: hardware concurrency).
+#ifndef SCILIB_NUM_THREADS
+#define SCILIB_NUM_THREADS 0
+#endif
+
+#if defined(__clang__)
+#define SCILIB_VECTORIZE_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define SCILIB_VECTORIZE_LOOP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define SCILIB_VECTORIZE_LOOP __pragma(loop(ivdep))
+#else
+#define SCILIB_VECTORIZE_LOOP
+#endif
+
+// Kernels marked with SCILIB_TARGET_CLONES are compiled for AVX-512, AVX2
+// and the baseline instruction set, and the best version is selected at load
+// time. This needs ifunc support, hence it is limited to GCC with glibc on
+// x86-64. flatten inlines the scalar kernels into each version.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__) && defined(__GLIBC__) && \
+    !defined(SCILIB_NO_TARGET_CLONES)
+#define SCILIB_TARGET_CLONES __attribute__((flatten, target_clones("avx512f", "avx2", "default")))
+#else
+#define SCILIB_TARGET_CLONES
+#endif
+
+namespace Sci {
+
+//--------------------------------------------------------------------------------------------------
+// Execution policies:
+//
+// execution::seq runs on the calling thread. par partitions the iteration
+// space into contiguous chunks that run on the default thread pool.
+// par_unseq in addition allows the loops over each chunk to be vectorized,
+// hence the callable must not synchronize with other invocations. The
+// sequenced policy is not exported to Sci since Sci::seq creates slices.
+
+namespace execution {
+
+struct sequenced_policy {
+};
+
+struct parallel_policy {
+};
+
+struct parallel_unsequenced_policy {
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+} // namespace execution
+
+using execution::par;
+using execution::par_unseq;
+
+template <class T>
+struct Is_execution_policy : std::false_type {
+};
+
+template <>
+struct Is_execution_policy<execution::sequenced_policy> : std::true_type {
+};
+
+template <>
+struct Is_execution_policy<execution::parallel_policy> : std::true_type {
+};
+
+template <>
+struct Is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type {
+};
+
+template <class T>
+inline constexpr bool Is_execution_policy_v = Is_execution_policy<std::remove_cvref_t<T>>::value;
+
+//--------------------------------------------------------------------------------------------------
+// Fork-join thread pool:
+//
+// run(n, f) calls f(i) for i in [0, n) on the workers and the calling
+// thread, and returns when all calls have completed. Calls from several
+// threads, or from inside a task, run serially on the calling thread
+// instead of waiting for the pool. Tasks must not throw.
+
+class Thread_pool {
+public:
+    explicit Thread_pool(std::size_t nthreads)
+    {
+        try {
+            for (std::size_t i = 1; i < nthreads; ++i) {
+                workers.emplace_back([this] { worker_loop(); });
+            }
+        }
+        catch (...) { // run with the threads we got
+        }
+    }
+
+    Thread_pool(const Thread_pool&) = delete;
+    Thread_pool& operator=(const Thread_pool&) = delete;
+
+    ~Thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stop = true;
+        }
+        cv_work.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    // Number of threads including the calling thread.
+    std::size_t size() const noexcept { return workers.size() + 1; }
+
+    template <class Callable>
+    void run(std::size_t n, Callable&& f)
+    {
+        std::unique_lock<std::mutex> run_lk(run_mtx, std::try_to_lock);
+        if (!run_lk || workers.empty() || n < 2) {
+            for (std::size_t i = 0; i < n; ++i) {
+                f(i);
+            }
+            return;
+        }
+        std::function<void(std::size_t)> fn = std::ref(f);
+
+        std::unique_lock<std::mutex> lk(mtx);
+        job = &fn;
+        ntasks = n;
+        next = 0;
+        remaining = n;
+        cv_work.notify_all();
+
+        while (next < ntasks) {
+            const std::size_t i = next++;
+            lk.unlock();
+            fn(i);
+            lk.lock();
+            --remaining;
+        }
+        cv_done.wait(lk, [this] { return remaining == 0; });
+        job = nullptr;
+        ntasks = 0;
+        next = 0;
+    }
+
+private:
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        for (;;) {
+            cv_work.wait(lk, [this] { return stop || next < ntasks; });
+            if (stop) {
+                return;
+            }
+            const std::size_t i = next++;
+            auto* fn = job;
+            lk.unlock();
+            (*fn)(i);
+            lk.lock();
+            if (--remaining == 0) {
+                cv_done.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex run_mtx;
+    std::mutex mtx;
+    std::condition_variable cv_work;
+    std::condition_variable cv_done;
+    std::function<void(std::size_t)>* job = nullptr;
+    std::size_t ntasks = 0;
+    std::size_t next = 0;
+    std::size_t remaining = 0;
+    bool stop = false;
+};
+
+// Thread pool used by the parallel execution policies.
+inline Thread_pool& default_thread_pool()
+{
+    static Thread_pool pool(SCILIB_NUM_THREADS > 0
+                                ? std::size_t{SCILIB_NUM_THREADS}
+                                : std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+namespace __Detail {
+
+template <class Policy>
+inline constexpr bool Is_parallel_policy_v =
+    std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> ||
+    std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_unsequenced_policy>;
+
+// Split [0, n) into contiguous chunks and call f(first, last) for each of
+// them. The chunks run on the calling thread for the sequenced policy, or if
+// the total number of elements to process is below the threshold.
+template <class Policy, class IndexType, class Callable>
+void parallel_for(Policy, IndexType n, std::size_t nelem, Callable&& f)
+{
+    if constexpr (Is_parallel_policy_v<Policy>) {
+        auto& pool = default_thread_pool();
+        const auto nchunks = std::min(pool.size(), static_cast<std::size_t>(n));
+        if (nelem >= SCILIB_PARALLEL_THRESHOLD && nchunks > 1) {
+            const IndexType chunk = (n + static_cast<IndexType>(nchunks) - 1) /
+                                    static_cast<IndexType>(nchunks);
+            pool.run(nchunks, [&](std::size_t i) {
+                const IndexType first = static_cast<IndexType>(i) * chunk;
+                const IndexType last = std::min<IndexType>(n, first + chunk);
+                if (first < last) {
+                    f(first, last);
+                }
+            });
+            return;
+        }
+    }
+    f(IndexType{0}, n);
+}
+
+// Reduce [0, n) in contiguous chunks as for parallel_for, where
+// reduce(first, last) returns the result for a non-empty chunk. The chunk
+// results are combined in order, starting from init for empty chunks, so the
+// result does not depend on the scheduling. The chunks depend on the size of
+// the pool, however, and so do floating-point sums over them.
+template <class Policy, class IndexType, class T, class Reduce, class Combine>
+T parallel_reduce(
+    Policy, IndexType n, std::size_t nelem, const T& init, Reduce&& reduce, Combine&& combine)
+{
+    if constexpr (Is_parallel_policy_v<Policy>) {
+        auto& pool = default_thread_pool();
+        const auto nchunks = std::min(pool.size(), static_cast<std::size_t>(n));
+        if (nelem >= SCILIB_PARALLEL_THRESHOLD && nchunks > 1) {
+            const IndexType chunk = (n + static_cast<IndexType>(nchunks) - 1) /
+                                    static_cast<IndexType>(nchunks);
+            std::vector<T> partial(nchunks, init);
+            pool.run(nchunks, [&](std::size_t i) {
+                const IndexType first = static_cast<IndexType>(i) * chunk;
+                const IndexType last = std::min<IndexType>(n, first + chunk);
+                if (first < last) {
+                    partial[i] = reduce(first, last);
+                }
+            });
+            T res = partial[0];
+            for (std::size_t i = 1; i < nchunks; ++i) {
+                res = combine(res, partial[i]);
+            }
+            return res;
+        }
+    }
+    if (n == IndexType{0}) {
+        return init;
+    }
+    return reduce(IndexType{0}, n);
+}
+
+// Call f(k) for k in [first, last), vectorized for par_unseq.
+template <class Policy, class IndexType, class Callable>
+MDSPAN_FORCE_INLINE_FUNCTION void
+for_each_index(Policy, IndexType first, IndexType last, Callable& f)
+{
+    using policy_type = std::remove_cvref_t<Policy>;
+    if constexpr (std::is_same_v<policy_type, execution::parallel_unsequenced_policy>) {
+        SCILIB_VECTORIZE_LOOP
+        for (IndexType k = first; k < last; ++k) {
+            f(k);
+        }
+    }
+    else {
+        for (IndexType k = first; k < last; ++k) {
+            f(k);
+        }
+    }
+}
+
+// Extent that is slowest varying in memory, along which strided views are
+// partitioned.
+template <class Layout, std::size_t Rank>
+inline constexpr std::size_t Partition_rank_v =
+    std::is_same_v<Layout, Kokkos::layout_left> ? Rank - 1 : 0;
+
+// Partition the views along the slowest-varying extent of the first view and
+// call f(subviews...) for each chunk.
+template <class Policy, class Callable, class MDSpan, class... MDSpans>
+    requires(MDSpan::rank() > 0)
+void parallel_for_each_slab(Policy policy, Callable&& f, MDSpan v, MDSpans... vs)
+{
+    using index_type = typename MDSpan::index_type;
+    constexpr std::size_t rank = MDSpan::rank();
+    constexpr std::size_t d = Partition_rank_v<typename MDSpan::layout_type, rank>;
+
+    auto slab = [&]<std::size_t... Rs>(std::index_sequence<Rs...>, auto u, index_type first,
+                                       index_type last)
+    {
+        return Kokkos::submdspan(
+            u, [&] {
+                if constexpr (Rs == d) {
+                    return std::pair<index_type, index_type>{first, last};
+                }
+                else {
+                    return Kokkos::full_extent;
+                }
+            }()...);
+    };
+    const auto nelem = static_cast<std::size_t>(v.size());
+    parallel_for(policy, v.extent(d), nelem, [&](index_type first, index_type last) {
+        f(slab(std::make_index_sequence<rank>(), v, first, last),
+          slab(std::make_index_sequence<rank>(), vs, first, last)...);
+    });
+}
+
+} // namespace __Detail
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_EXECUTION_H
@@ -0,0 +1,280 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_EXPRESSION_H
+#define SCILIB_MDARRAY_EXPRESSION_H
+
+#include <cstddef>
+#include <gsl/gsl>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------------------------------------------------------
+// Expression templates for element-wise MDArray arithmetic:
+//
+// The arithmetic operators return lightweight expression nodes instead of
+// MDArrays. Nothing is computed until an expression is assigned to (or used
+// to construct) an MDArray, which then evaluates the whole expression tree in
+// a single loop without any intermediate temporaries.
+//
+// Lvalue MDArrays are captured by reference, while temporaries (rvalue
+// MDArrays, nested expressions and scalars) are stored by value in the node.
+// An expression must therefore not outlive the named MDArrays it refers to.
+//
+// The Linalg and Stats functions that take MDArrays by reference have
+// overloads that evaluate expression operands first, so that for example
+// Linalg::matrix_norm(a - b, 'F') compiles as it did with eager operators.
+
+namespace Sci {
+
+namespace __Detail {
+
+template <class Op, class E>
+class MDArray_unary_expr;
+
+template <class Op, class Lhs, class Rhs>
+class MDArray_binary_expr;
+
+template <class Op, class E>
+struct Is_expression<MDArray_unary_expr<Op, E>> : std::true_type {
+};
+
+template <class Op, class Lhs, class Rhs>
+struct Is_expression<MDArray_binary_expr<Op, Lhs, Rhs>> : std::true_type {
+};
+
+// MDArrays and expressions can both be operands of element-wise operations.
+template <class E>
+static constexpr bool Is_mdarray_operand_v =
+    Is_mdarray_v<std::remove_cvref_t<E>> || Is_expression_v<std::remove_cvref_t<E>>;
+
+// The MDArray type an operand evaluates to.
+template <class E>
+struct Mdarray_type {
+};
+
+template <class ElementType, class Extents, class LayoutPolicy, class Container>
+struct Mdarray_type<MDArray<ElementType, Extents, LayoutPolicy, Container>> {
+    using type = MDArray<ElementType, Extents, LayoutPolicy, Container>;
+};
+
+template <class Op, class E>
+struct Mdarray_type<MDArray_unary_expr<Op, E>> {
+    using type = typename MDArray_unary_expr<Op, E>::mdarray_type;
+};
+
+template <class Op, class Lhs, class Rhs>
+struct Mdarray_type<MDArray_binary_expr<Op, Lhs, Rhs>> {
+    using type = typename MDArray_binary_expr<Op, Lhs, Rhs>::mdarray_type;
+};
+
+template <class E>
+using Mdarray_type_t = typename Mdarray_type<std::remove_cvref_t<E>>::type;
+
+// Lvalue MDArrays are held by reference, everything else by value.
+template <class E>
+using Expr_operand_t = std::conditional_t<std::is_lvalue_reference_v<E> &&
+                                              Is_mdarray_v<std::remove_cvref_t<E>>,
+                                          const std::remove_cvref_t<E>&,
+                                          std::remove_cvref_t<E>>;
+
+//--------------------------------------------------------------------------------------------------
+// Operand access:
+
+template <class E, class... IndexTypes>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr auto expr_value(const E& e, IndexTypes... indices)
+{
+    if constexpr (Is_mdarray_operand_v<E>) {
+        return e(indices...);
+    }
+    else { // scalar
+        return e;
+    }
+}
+
+template <class E, class SizeType>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr auto expr_flat_value(const E& e, SizeType k)
+{
+    if constexpr (Is_mdarray_v<E>) {
+        return e.container_data()[k];
+    }
+    else if constexpr (Is_expression_v<E>) {
+        return e.flat(k);
+    }
+    else { // scalar
+        return e;
+    }
+}
+
+// Check if the operand can be traversed by a flat index into its container
+// using the same mapping as the destination.
+template <class E, class Mapping>
+constexpr bool expr_is_flat(const E& e, const Mapping& m) noexcept
+{
+    if constexpr (Is_mdarray_v<E>) {
+        return e.is_exhaustive() && e.mapping() == m;
+    }
+    else if constexpr (Is_expression_v<E>) {
+        return e.is_flat(m);
+    }
+    else { // scalar
+        return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Expression nodes:
+
+template <class Op, class E>
+class MDArray_unary_expr {
+public:
+    using mdarray_type = Mdarray_type_t<E>;
+    using extents_type = typename mdarray_type::extents_type;
+    using mapping_type = typename mdarray_type::mapping_type;
+    using value_type = typename mdarray_type::value_type;
+    using index_type = typename mdarray_type::index_type;
+    using size_type = typename mdarray_type::size_type;
+    using rank_type = typename mdarray_type::rank_type;
+
+    constexpr explicit MDArray_unary_expr(E e) : expr(std::forward<E>(e)) {}
+
+    static constexpr rank_type rank() noexcept { return extents_type::rank(); }
+
+    constexpr const extents_type& extents() const noexcept { return expr.extents(); }
+    constexpr index_type extent(rank_type r) const { return extents().extent(r); }
+    constexpr size_type size() const noexcept { return expr.size(); }
+
+    template <class... IndexTypes>
+        requires(sizeof...(IndexTypes) == extents_type::rank())
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr value_type operator()(IndexTypes... indices) const
+    {
+        return Op{}(expr_value(expr, indices...));
+    }
+
+    template <class IndexType>
+        requires(extents_type::rank() == 1)
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr value_type operator[](IndexType indx) const
+    {
+        return (*this)(indx);
+    }
+
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr value_type flat(size_type k) const
+    {
+        return Op{}(expr_flat_value(expr, k));
+    }
+
+    constexpr bool is_flat(const mapping_type& m) const noexcept { return expr_is_flat(expr, m); }
+
+private:
+    E expr;
+};
+
+template <class Op, class Lhs, class Rhs>
+class MDArray_binary_expr {
+    static constexpr bool lhs_is_operand = Is_mdarray_operand_v<Lhs>;
+
+public:
+    using mdarray_type = typename std::conditional_t<lhs_is_operand,
+                                                     Mdarray_type<std::remove_cvref_t<Lhs>>,
+                                                     Mdarray_type<std::remove_cvref_t<Rhs>>>::type;
+    using extents_type = typename mdarray_type::extents_type;
+    using mapping_type = typename mdarray_type::mapping_type;
+    using value_type = typename mdarray_type::value_type;
+    using index_type = typename mdarray_type::index_type;
+    using size_type = typename mdarray_type::size_type;
+    using rank_type = typename mdarray_type::rank_type;
+
+    constexpr MDArray_binary_expr(Lhs l, Rhs r) : lhs(std::forward<Lhs>(l)), rhs(std::forward<Rhs>(r))
+    {
+        if constexpr (Is_mdarray_operand_v<Lhs> && Is_mdarray_operand_v<Rhs>) {
+            Expects(lhs.extents() == rhs.extents());
+        }
+    }
+
+    static constexpr rank_type rank() noexcept { return extents_type::rank(); }
+
+    constexpr const extents_type& extents() const noexcept
+    {
+        if constexpr (lhs_is_operand) {
+            return lhs.extents();
+        }
+        else {
+            return rhs.extents();
+        }
+    }
+
+    constexpr index_type extent(rank_type r) const { return extents().extent(r); }
+
+    constexpr size_type size() const noexcept
+    {
+        if constexpr (lhs_is_operand) {
+            return lhs.size();
+        }
+        else {
+            return rhs.size();
+        }
+    }
+
+    template <class... IndexTypes>
+        requires(sizeof...(IndexTypes) == extents_type::rank())
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr value_type operator()(IndexTypes... indices) const
+    {
+        return Op{}(expr_value(lhs, indices...), expr_value(rhs, indices...));
+    }
+
+    template <class IndexType>
+        requires(extents_type::rank() == 1)
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr value_type operator[](IndexType indx) const
+    {
+        return (*this)(indx);
+    }
+
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr value_type flat(size_type k) const
+    {
+        return Op{}(expr_flat_value(lhs, k), expr_flat_value(rhs, k));
+    }
+
+    constexpr bool is_flat(const mapping_type& m) const noexcept
+    {
+        return expr_is_flat(lhs, m) && expr_is_flat(rhs, m);
+    }
+
+private:
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <class Op, class E>
+constexpr auto make_unary_expr(E&& e)
+{
+    return MDArray_unary_expr<Op, Expr_operand_t<E>>(std::forward<E>(e));
+}
+
+template <class Op, class Lhs, class Rhs>
+constexpr auto make_binary_expr(Lhs&& lhs, Rhs&& rhs)
+{
+    return MDArray_binary_expr<Op, Expr_operand_t<Lhs>, Expr_operand_t<Rhs>>(
+        std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+// Evaluate an operand into an MDArray, or pass through if it is one already.
+template <class E>
+    requires(Is_mdarray_operand_v<E>)
+constexpr decltype(auto) eval(const E& e)
+{
+    if constexpr (Is_mdarray_v<E>) {
+        return e;
+    }
+    else {
+        return Mdarray_type_t<E>(e);
+    }
+}
+
+} // namespace __Detail
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_EXPRESSION_H
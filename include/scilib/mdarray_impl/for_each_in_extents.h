@@ -7,13 +7,22 @@
 #ifndef SCILIB_MDARRAY_FOR_EACH_IN_EXTENTS_H
 #define SCILIB_MDARRAY_FOR_EACH_IN_EXTENTS_H
 
-#include <range/v3/view/cartesian_product.hpp>
-#include <range/v3/view/iota.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 //--------------------------------------------------------------------------------------------------
 // For each in extents:
 //
+// The index space is traversed by a compile-time expansion of nested loops
+// in the storage order of the layout, i.e. the last index varies fastest for
+// layout_right and the first index for layout_left. For layout_tiled the
+// tiles are traversed in row-major order, and the elements of each tile in
+// row-major order. The extents are read once per loop level and the
+// innermost loop is a plain counted loop that the compiler can vectorize.
+//
 // Copyright (2022) National Technology & Engineering Solutions of Sandia, LLC (NTESS).
 // See https://kokkos.org/LICENSE for license information.
 
@@ -21,64 +30,133 @@ namespace Sci {
 
 namespace __Detail {
 
-template <std::size_t... Lefts, std::size_t... Rights>
-auto concat_index_sequence(std::index_sequence<Lefts...>, std::index_sequence<Rights...>)
+// Outermost loop over extent 0, innermost over extent N-1.
+template <class Callable, class Extents, class... Indices>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr void
+for_each_in_extents_right(Callable& f, const Extents& e, Indices... indices)
 {
-    return std::index_sequence<Lefts..., Rights...>{};
+    using index_type = typename Extents::index_type;
+    constexpr std::size_t r = sizeof...(Indices);
+
+    if constexpr (r == Extents::rank()) {
+        f(indices...);
+    }
+    else {
+        const index_type n = e.extent(r);
+        for (index_type i = 0; i < n; ++i) {
+            for_each_in_extents_right(f, e, indices..., i);
+        }
+    }
 }
 
-inline auto reverse_index_sequence(std::index_sequence<> x) { return x; }
+// Outermost loop over extent N-1, innermost over extent 0.
+template <class Callable, class Extents, class... Indices>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr void
+for_each_in_extents_left(Callable& f, const Extents& e, Indices... indices)
+{
+    using index_type = typename Extents::index_type;
+    constexpr std::size_t k = sizeof...(Indices);
 
-template <std::size_t First, std::size_t... Rest>
-auto reverse_index_sequence(std::index_sequence<First, Rest...>)
+    if constexpr (k == Extents::rank()) {
+        f(indices...);
+    }
+    else {
+        const index_type n = e.extent(Extents::rank() - 1 - k);
+        for (index_type i = 0; i < n; ++i) {
+            for_each_in_extents_left(f, e, i, indices...);
+        }
+    }
+}
+
+// Loops over the elements of the tile starting at firsts.
+template <class Layout, class Callable, class Extents, class... Indices>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr void
+for_each_in_tile(Callable& f,
+                 const Extents& e,
+                 const std::array<typename Extents::index_type, Extents::rank()>& firsts,
+                 Indices... indices)
 {
-    return concat_index_sequence(reverse_index_sequence(std::index_sequence<Rest...>{}),
-                                 std::index_sequence<First>{});
+    using index_type = typename Extents::index_type;
+    using mapping_type = typename Layout::template mapping<Extents>;
+    constexpr std::size_t r = sizeof...(Indices);
+
+    if constexpr (r == Extents::rank()) {
+        f(indices...);
+    }
+    else {
+        const index_type last = std::min(firsts[r] + mapping_type::tile_extent(r), e.extent(r));
+        for (index_type i = firsts[r]; i < last; ++i) {
+            for_each_in_tile<Layout>(f, e, firsts, indices..., i);
+        }
+    }
 }
 
-template <std::size_t N>
-auto make_reverse_index_sequence()
+// Outer loops over the tiles, with the tile along extent N-1 varying fastest.
+template <class Layout, class Callable, class Extents, class... Firsts>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr void
+for_each_in_extents_tiled(Callable& f, const Extents& e, Firsts... firsts)
 {
-    return reverse_index_sequence(std::make_index_sequence<N>());
+    using index_type = typename Extents::index_type;
+    using mapping_type = typename Layout::template mapping<Extents>;
+    constexpr std::size_t r = sizeof...(Firsts);
+
+    if constexpr (r == Extents::rank()) {
+        for_each_in_tile<Layout>(f, e, {firsts...});
+    }
+    else {
+        const index_type n = e.extent(r);
+        constexpr index_type t = mapping_type::tile_extent(r);
+        for (index_type i = 0; i < n; i += t) {
+            for_each_in_extents_tiled<Layout>(f, e, firsts..., i);
+        }
+    }
 }
 
-template <class Callable, class IndexType, std::size_t... Extents, std::size_t... RankIndices>
-void for_each_in_extents_impl(Callable&& f,
-                              Kokkos::extents<IndexType, Extents...> e,
-                              std::index_sequence<RankIndices...> rank_sequence)
+template <std::size_t K, class Callable, class Mapping, class IndexType>
+MDSPAN_FORCE_INLINE_FUNCTION constexpr void
+for_each_offset_impl(Callable& f, const Mapping& m, IndexType offset)
 {
-    // In the layout_left case, caller passes in N-1, N-2, ..., 1, 0.
-    // This reverses the order of the Cartesian product,
-    // but also reverses the order of indices in each tuple.
-    [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
-    {
-        auto v = ranges::views::cartesian_product(
-            ranges::views::iota(IndexType(0), e.extent(Indices))...);
-        for (const auto& tuple_of_indices : v) {
-            // In the layout_left case, we undo the reversal of each tuple
-            // by getting its elements in reverse order.
-            [&]<std::size_t... InnerIndices>(std::index_sequence<InnerIndices...>)
-            {
-                std::forward<Callable>(f)(std::get<InnerIndices>(tuple_of_indices)...);
-            }
-            (rank_sequence);
+    using extents_type = typename Mapping::extents_type;
+    constexpr std::size_t rank = extents_type::rank();
+
+    if constexpr (K == rank) {
+        f(offset);
+    }
+    else {
+        constexpr std::size_t r =
+            std::is_same_v<typename Mapping::layout_type, Kokkos::layout_left> ? rank - 1 - K : K;
+        const IndexType n = m.extents().extent(r);
+        const IndexType s = m.stride(r);
+        for (IndexType i = 0; i < n; ++i, offset += s) {
+            for_each_offset_impl<K + 1>(f, m, offset);
         }
     }
-    (rank_sequence);
 }
+
 } // namespace __Detail
 
+// Call f(offset) for each element offset of a strided mapping. The strides
+// are hoisted out of the loops, so no mapping is evaluated per element.
+template <class Callable, class Mapping>
+    requires(Mapping::is_always_strided())
+constexpr void for_each_offset(Callable&& f, const Mapping& m)
+{
+    using index_type = typename Mapping::index_type;
+    __Detail::for_each_offset_impl<0>(f, m, index_type{0});
+}
+
 template <class Callable, class IndexType, std::size_t... Extents, class Layout>
 void for_each_in_extents(Callable&& f, Kokkos::extents<IndexType, Extents...> e, Layout)
 {
     using layout_type = std::remove_cvref_t<Layout>;
     if constexpr (std::is_same_v<layout_type, Kokkos::layout_left>) {
-        __Detail::for_each_in_extents_impl(std::forward<Callable>(f), e,
-                                           __Detail::make_reverse_index_sequence<e.rank()>());
+        __Detail::for_each_in_extents_left(f, e);
+    }
+    else if constexpr (__Detail::Is_layout_tiled_v<layout_type>) {
+        __Detail::for_each_in_extents_tiled<layout_type>(f, e);
     }
     else { // layout_right or any other layout
-        __Detail::for_each_in_extents_impl(std::forward<Callable>(f), e,
-                                           std::make_index_sequence<e.rank()>());
+        __Detail::for_each_in_extents_right(f, e);
     }
 }
 
@@ -0,0 +1,154 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_INIT_ALLOCATOR_H
+#define SCILIB_MDARRAY_INIT_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Sci {
+
+//--------------------------------------------------------------------------------------------------
+// Construction tags:
+//
+// MDArray(Sci::uninitialized, exts...) leaves the element values unspecified.
+// Trivial elements are not written if the container is a std::array or a
+// std::vector with default_init_allocator. Other containers value-initialize.
+//
+// MDArray(Sci::zero_pages, exts...) creates an MDArray of zeros. If the
+// container is a std::vector with zero_page_allocator, the zeros come from
+// the pages the OS maps on first touch, and the elements are never written.
+
+struct uninitialized_t {
+    explicit uninitialized_t() = default;
+};
+
+inline constexpr uninitialized_t uninitialized{};
+
+struct zero_pages_t {
+    explicit zero_pages_t() = default;
+};
+
+inline constexpr zero_pages_t zero_pages{};
+
+//--------------------------------------------------------------------------------------------------
+// Allocator adaptor that default-initializes instead of value-initializing
+// elements, e.g. in std::vector<T>(n) and resize(n).
+template <class T, class A = std::allocator<T>>
+class default_init_allocator : public A {
+    using traits = std::allocator_traits<A>;
+
+public:
+    template <class U>
+    struct rebind {
+        using other = default_init_allocator<U, typename traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+
+    constexpr default_init_allocator() noexcept(std::is_nothrow_default_constructible_v<A>) =
+        default;
+
+    constexpr default_init_allocator(const A& a) noexcept : A(a) {}
+
+    template <class U, class B>
+    constexpr default_init_allocator(const default_init_allocator<U, B>& other) noexcept
+        : A(static_cast<const B&>(other))
+    {
+    }
+
+    template <class U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args)
+    {
+        traits::construct(static_cast<A&>(*this), p, std::forward<Args>(args)...);
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+// Allocator returning zero-filled storage from std::calloc. Large blocks are
+// served by mmap in the common C libraries, hence the memory is not touched
+// until first use. Trivial elements are not written on value-initialization,
+// so a std::vector that is shrunk and grown again within its capacity keeps
+// the old values; MDArray always allocates a new container when resized.
+template <class T>
+class zero_page_allocator {
+public:
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "zero_page_allocator does not support over-aligned types");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    constexpr zero_page_allocator() noexcept = default;
+    constexpr zero_page_allocator(const zero_page_allocator&) noexcept = default;
+
+    template <class U>
+    constexpr zero_page_allocator(const zero_page_allocator<U>&) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(size_type n)
+    {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        void* p = std::calloc(n, sizeof(T));
+        if (!p && n > 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_type) noexcept { std::free(p); }
+
+    // The storage already holds zero bytes, which calloc has implicitly
+    // turned into objects of implicit-lifetime types.
+    template <class U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        if constexpr (!std::is_trivially_default_constructible_v<U>) {
+            ::new (static_cast<void*>(p)) U();
+        }
+    }
+
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template <class T1, class T2>
+constexpr bool operator==(const zero_page_allocator<T1>&, const zero_page_allocator<T2>&) noexcept
+{
+    return true;
+}
+
+template <class T1, class T2>
+constexpr bool operator!=(const zero_page_allocator<T1>& lhs,
+                          const zero_page_allocator<T2>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_INIT_ALLOCATOR_H
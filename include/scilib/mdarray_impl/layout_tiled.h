@@ -0,0 +1,235 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_LAYOUT_TILED_H
+#define SCILIB_MDARRAY_LAYOUT_TILED_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Sci {
+
+//--------------------------------------------------------------------------------------------------
+// Tiled layout:
+//
+// The index space is split into tiles of TileExtents... elements, e.g.
+// layout_tiled<32, 32> for matrices and layout_tiled<16, 16, 16> for 3D
+// arrays. The tiles are stored one after the other in row-major order, and
+// the elements in each tile in row-major order. Tiles at the upper edges
+// are truncated to the extents, hence the storage is exhaustive and the
+// container holds exactly size() elements.
+//
+// Neighbouring elements along any extent are thus close in memory, which
+// keeps both directions of a 2D or 3D sweep in cache. Tile extents should
+// be powers of two so that the index arithmetic reduces to shifts and masks.
+//
+// The layout supports submdspan (and hence Sci::slice) with full_extent and
+// index ranges; rank-reducing slices are not supported since the result is
+// not a tiled layout.
+
+template <std::size_t... TileExtents>
+struct layout_tiled {
+    static_assert(sizeof...(TileExtents) > 0, "layout_tiled: rank must be positive");
+    static_assert(((TileExtents > 0) && ...), "layout_tiled: tile extents must be positive");
+
+    template <class Extents>
+    class mapping {
+    public:
+        static_assert(Extents::rank() == sizeof...(TileExtents),
+                      "layout_tiled: rank of extents does not match the number of tile extents");
+
+        using extents_type = Extents;
+        using index_type = typename Extents::index_type;
+        using size_type = typename Extents::size_type;
+        using rank_type = typename Extents::rank_type;
+        using layout_type = layout_tiled;
+
+        static constexpr std::array<index_type, sizeof...(TileExtents)> tile_extents{
+            static_cast<index_type>(TileExtents)...};
+
+        constexpr mapping() noexcept : mapping(extents_type{}) {}
+
+        constexpr mapping(const extents_type& e) noexcept : exts(e)
+        {
+            for (rank_type r = 0; r < rank; ++r) {
+                storage[r] = exts.extent(r);
+            }
+            init_suffix();
+        }
+
+        template <class OtherExtents>
+            requires(std::is_constructible_v<extents_type, OtherExtents>)
+        constexpr explicit(!std::is_convertible_v<OtherExtents, extents_type>)
+            mapping(const mapping<OtherExtents>& other) noexcept
+            : exts(other.exts), base(static_cast<index_type>(other.base))
+        {
+            for (rank_type r = 0; r < rank; ++r) {
+                storage[r] = static_cast<index_type>(other.storage[r]);
+                origin[r] = static_cast<index_type>(other.origin[r]);
+            }
+            init_suffix();
+        }
+
+        constexpr const extents_type& extents() const noexcept { return exts; }
+
+        static constexpr index_type tile_extent(rank_type r) noexcept { return tile_extents[r]; }
+
+        constexpr index_type required_span_size() const noexcept
+        {
+            for (rank_type r = 0; r < rank; ++r) {
+                if (exts.extent(r) == 0) {
+                    return 0;
+                }
+            }
+            std::array<index_type, rank> last;
+            for (rank_type r = 0; r < rank; ++r) {
+                last[r] = exts.extent(r) - 1;
+            }
+            return offset(last) + 1;
+        }
+
+        template <class... Indices>
+            requires(sizeof...(Indices) == sizeof...(TileExtents) &&
+                     (std::is_convertible_v<Indices, index_type> && ...))
+        constexpr index_type operator()(Indices... indices) const noexcept
+        {
+            return offset({static_cast<index_type>(indices)...});
+        }
+
+        static constexpr bool is_always_unique() noexcept { return true; }
+        static constexpr bool is_always_exhaustive() noexcept { return false; }
+        static constexpr bool is_always_strided() noexcept { return false; }
+        static constexpr bool is_unique() noexcept { return true; }
+        static constexpr bool is_strided() noexcept { return false; }
+
+        // True unless the mapping is a slice of a larger tiled array.
+        constexpr bool is_exhaustive() const noexcept
+        {
+            index_type n = 1;
+            for (rank_type r = 0; r < rank; ++r) {
+                n *= exts.extent(r);
+            }
+            return required_span_size() == n;
+        }
+
+        friend constexpr bool operator==(const mapping& a, const mapping& b) noexcept
+        {
+            return a.exts == b.exts && a.storage == b.storage && a.origin == b.origin;
+        }
+
+        // Slicing with full_extent or [first, last) ranges along each extent.
+        template <class... SliceSpecifiers>
+            requires(sizeof...(SliceSpecifiers) == sizeof...(TileExtents))
+        friend constexpr auto submdspan_mapping(const mapping& src, SliceSpecifiers... slices)
+        {
+            return src.submdspan_mapping_impl(slices...);
+        }
+
+    private:
+        template <class>
+        friend class mapping;
+
+        static constexpr rank_type rank = sizeof...(TileExtents);
+
+        template <class... SliceSpecifiers>
+        constexpr auto submdspan_mapping_impl(SliceSpecifiers... slices) const
+        {
+            static_assert((!std::is_convertible_v<SliceSpecifiers, index_type> && ...),
+                          "layout_tiled: rank-reducing slices are not supported");
+
+            using sub_extents_type = Kokkos::dextents<index_type, rank>;
+            using sub_mapping_type = typename layout_tiled::template mapping<sub_extents_type>;
+
+            std::array<index_type, rank> first;
+            std::array<index_type, rank> sub_exts;
+            rank_type r = 0;
+            auto bounds = [&](const auto& s) {
+                if constexpr (std::is_same_v<std::remove_cvref_t<decltype(s)>,
+                                             Kokkos::full_extent_t>) {
+                    first[r] = 0;
+                    sub_exts[r] = exts.extent(r);
+                }
+                else {
+                    first[r] = static_cast<index_type>(std::get<0>(s));
+                    sub_exts[r] = static_cast<index_type>(std::get<1>(s)) - first[r];
+                }
+                ++r;
+            };
+            (bounds(slices), ...);
+
+            sub_mapping_type res{sub_extents_type(sub_exts)};
+            res.storage = storage;
+            res.init_suffix();
+            for (rank_type q = 0; q < rank; ++q) {
+                res.origin[q] = origin[q] + first[q];
+            }
+            const index_type off = offset(first);
+            res.base = base + off;
+            return Kokkos::submdspan_mapping_result<sub_mapping_type>{res,
+                                                                      static_cast<std::size_t>(off)};
+        }
+
+        constexpr void init_suffix() noexcept
+        {
+            index_type s = 1;
+            for (rank_type r = rank; r-- > 0;) {
+                suffix[r] = s;
+                s *= storage[r];
+            }
+        }
+
+        // All tiles before the one holding the element precede it in
+        // memory: along extent r these are the tiles in the same slab of
+        // extents < r, each slab of extents >= r holding suffix[r] elements
+        // per index. The element is then stored row-major in its tile, whose
+        // extents are truncated at the edges.
+        constexpr index_type offset(const std::array<index_type, rank>& idx) const noexcept
+        {
+            index_type res = 0;
+            index_type tile_size = 1;
+            index_type local = 0;
+            for (rank_type r = 0; r < rank; ++r) {
+                const index_type p = idx[r] + origin[r];
+                const index_type t = tile_extents[r];
+                const index_type start = p / t * t;
+                const index_type n = std::min(t, storage[r] - start);
+                res += start * tile_size * suffix[r];
+                tile_size *= n;
+                local = local * n + (p - start);
+            }
+            return res + local - base;
+        }
+
+        extents_type exts{};
+        std::array<index_type, rank> storage{}; // extents of the whole tiled array
+        std::array<index_type, rank> suffix{};  // products of storage extents after r
+        std::array<index_type, rank> origin{};  // position in the whole tiled array
+        index_type base = 0;                    // offset of origin in the whole array
+    };
+};
+
+namespace __Detail {
+
+template <class Layout>
+struct Is_layout_tiled : std::false_type {
+};
+
+template <std::size_t... TileExtents>
+struct Is_layout_tiled<layout_tiled<TileExtents...>> : std::true_type {
+};
+
+template <class Layout>
+inline constexpr bool Is_layout_tiled_v = Is_layout_tiled<std::remove_cvref_t<Layout>>::value;
+
+} // namespace __Detail
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_LAYOUT_TILED_H
@@ -7,12 +7,17 @@
 #ifndef SCILIB_MDARRAY_BITS_H
 #define SCILIB_MDARRAY_BITS_H
 
+#include "aligned_allocator.h"
+#include "execution.h"
+#include "init_allocator.h"
 #include "support.h"
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
 #include <gsl/gsl>
 #include <initializer_list>
+#include <memory>
 #include <span>
 #include <type_traits>
 #include <utility>
@@ -37,6 +42,14 @@ struct Is_mdarray<MDArray<ElementType, Extents, LayoutPolicy, Container>> : std:
 template <class M>
 static constexpr bool Is_mdarray_v = Is_mdarray<M>::value;
 
+// Specialized for the expression nodes in expression.h.
+template <class E>
+struct Is_expression : std::false_type {
+};
+
+template <class E>
+static constexpr bool Is_expression_v = Is_expression<std::remove_cvref_t<E>>::value;
+
 template <class ValueType, class Index>
 decltype(auto) just_value(Index, ValueType&& t)
 {
@@ -66,6 +79,12 @@ struct Container_is_array : std::false_type {
     {
         return Container(m.required_span_size(), val);
     }
+
+    template <class M>
+    static constexpr Container construct_uninitialized(const M& m)
+    {
+        return Container(m.required_span_size());
+    }
 };
 
 template <class ElementType, std::size_t N>
@@ -81,6 +100,13 @@ struct Container_is_array<std::array<ElementType, N>> : std::true_type {
     {
         return value_to_array<ElementType, N>(val);
     }
+
+    template <class M>
+    static constexpr std::array<ElementType, N> construct_uninitialized(const M&)
+    {
+        std::array<ElementType, N> res;
+        return res;
+    }
 };
 
 template <class Container>
@@ -97,6 +123,20 @@ struct Container_is_vector<std::vector<ElementType, Allocator>> : std::true_type
 template <class Container>
 static constexpr bool Container_is_vector_v = Container_is_vector<Container>::value;
 
+// Alignment in bytes guaranteed for the container data.
+template <class Container>
+struct Container_alignment {
+    static constexpr std::size_t value = alignof(typename Container::value_type);
+};
+
+template <class ElementType, std::size_t Alignment>
+struct Container_alignment<std::vector<ElementType, aligned_allocator<ElementType, Alignment>>> {
+    static constexpr std::size_t value = Alignment;
+};
+
+template <class Container>
+static constexpr std::size_t Container_alignment_v = Container_alignment<Container>::value;
+
 //--------------------------------------------------------------------------------------------------
 // Bounds checking:
 
@@ -221,6 +261,50 @@ public:
         Expects(gsl::narrow_cast<size_type>(map.required_span_size()) <= ctr.size());
     }
 
+    // [MDArray.ctors.tags], MDArray constructors with construction tags (see init_allocator.h)
+
+    template <class... OtherIndexTypes>
+        requires((std::is_convertible_v<OtherIndexTypes, index_type> && ...) &&
+                 std::is_constructible_v<extents_type, OtherIndexTypes...> &&
+                 std::is_constructible_v<mapping_type, extents_type> &&
+                 (std::is_constructible_v<container_type, std::size_t> ||
+                  __Detail::Container_is_array_v<container_type>) )
+    constexpr MDArray(uninitialized_t, OtherIndexTypes... exts)
+        : MDArray(uninitialized, extents_type(static_cast<index_type>(std::move(exts))...))
+    {
+    }
+
+    constexpr MDArray(uninitialized_t, const extents_type& exts) requires(
+        std::is_constructible_v<mapping_type, const extents_type&> &&
+        (std::is_constructible_v<container_type, std::size_t> ||
+         __Detail::Container_is_array_v<container_type>) )
+        : map(exts), ctr(__Detail::Container_is_array<container_type>::construct_uninitialized(map))
+    {
+        Expects(gsl::narrow_cast<size_type>(map.required_span_size()) <= ctr.size());
+    }
+
+    template <class... OtherIndexTypes>
+        requires((std::is_convertible_v<OtherIndexTypes, index_type> && ...) &&
+                 std::is_constructible_v<extents_type, OtherIndexTypes...> &&
+                 std::is_constructible_v<mapping_type, extents_type> &&
+                 (std::is_constructible_v<container_type, std::size_t> ||
+                  __Detail::Container_is_array_v<container_type>) )
+    constexpr MDArray(zero_pages_t, OtherIndexTypes... exts)
+        : MDArray(zero_pages, extents_type(static_cast<index_type>(std::move(exts))...))
+    {
+    }
+
+    // Value-initialization zeroes the arithmetic types; zero_page_allocator
+    // does so without writing the elements.
+    constexpr MDArray(zero_pages_t, const extents_type& exts) requires(
+        std::is_constructible_v<mapping_type, const extents_type&> &&
+        (std::is_constructible_v<container_type, std::size_t> ||
+         __Detail::Container_is_array_v<container_type>) )
+        : map(exts), ctr(__Detail::Container_is_array<container_type>::construct(map))
+    {
+        Expects(gsl::narrow_cast<size_type>(map.required_span_size()) <= ctr.size());
+    }
+
     constexpr MDArray(const extents_type& exts, const container_type& c) requires(
         std::is_constructible_v<mapping_type, const extents_type&>)
         : map(exts), ctr(c)
@@ -253,14 +337,14 @@ public:
 
     constexpr MDArray(
         __Detail::MDArray_initializer<element_type, extents_type::rank()>
-            init) requires((!std::is_same_v<layout_type, Kokkos::layout_stride>) &&std::
-                               is_same_v<container_type, std::vector<element_type>>)
+            init) requires((!std::is_same_v<layout_type, Kokkos::layout_stride>) &&
+                           __Detail::Container_is_vector_v<container_type>)
         : map(extents_type(__Detail::derive_extents<extents_type::rank()>(init)))
     {
         ctr.reserve(map.required_span_size());
         __Detail::insert_flat(init, ctr);
 
-        if constexpr (std::is_same_v<layout_type, Kokkos::layout_left>) { // need to transpose data
+        if constexpr (!std::is_same_v<layout_type, Kokkos::layout_right>) { // need to reorder data
             MDArray<element_type, extents_type, Kokkos::layout_right, container_type> tmp(extents(),
                                                                                          ctr);
             (*this) = tmp.to_mdspan();
@@ -282,17 +366,7 @@ public:
             Expects(static_extent(r) == gsl::narrow_cast<size_type>(Kokkos::dynamic_extent) ||
                     static_extent(r) == gsl::narrow_cast<size_type>(other.extent(r)));
         }
-        auto copy_fn = [&]<class... OtherIndexTypes>(OtherIndexTypes... indices)
-        {
-#if MDSPAN_USE_BRACKET_OPERATOR
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other[static_cast<index_type>(std::move(indices))...];
-#else
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other(static_cast<index_type>(std::move(indices))...);
-#endif
-        };
-        for_each_in_extents(copy_fn, other);
+        __Detail::copy_elements(other.to_mdspan(), to_mdspan());
     }
 
     template <class OtherElementType, class OtherExtents, class OtherLayoutPolicy, class Accessor>
@@ -309,23 +383,17 @@ public:
             Expects(static_extent(r) == gsl::narrow_cast<size_type>(Kokkos::dynamic_extent) ||
                     static_extent(r) == gsl::narrow_cast<size_type>(other.extent(r)));
         }
-#if _MSC_VER
-#pragma warning(disable : 4834)
-#endif // _MSC_VER
-        auto copy_fn = [&]<class... OtherIndexTypes>(OtherIndexTypes... indices)
-        {
-#if MDSPAN_USE_BRACKET_OPERATOR
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other[static_cast<index_type>(std::move(indices))...];
-#else
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other(static_cast<index_type>(std::move(indices))...);
-#endif
-        };
-#if _MSC_VER
-#pragma warning(default : 4834)
-#endif // _MSC_VER
-        for_each_in_extents(copy_fn, other);
+        __Detail::copy_elements(other, to_mdspan());
+    }
+
+    // Evaluate an element-wise expression (see expression.h).
+    template <class Expr>
+        requires(__Detail::Is_expression_v<Expr>&&
+                     std::is_same_v<typename Expr::mdarray_type, MDArray>)
+    constexpr MDArray(const Expr& e)
+        : map(e.extents()), ctr(__Detail::Container_is_array<container_type>::construct(map))
+    {
+        assign_expression(e, [](element_type& a, const value_type& b) { a = b; });
     }
 
     ~MDArray() = default;
@@ -411,17 +479,7 @@ public:
             Expects(static_extent(r) == gsl::narrow_cast<size_type>(Kokkos::dynamic_extent) ||
                     static_extent(r) == gsl::narrow_cast<size_type>(other.extent(r)));
         }
-        auto copy_fn = [&]<class... OtherIndexTypes>(OtherIndexTypes... indices)
-        {
-#if MDSPAN_USE_BRACKET_OPERATOR
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other[static_cast<index_type>(std::move(indices))...];
-#else
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other(static_cast<index_type>(std::move(indices))...);
-#endif
-        };
-        for_each_in_extents(copy_fn, other);
+        __Detail::copy_elements(other.to_mdspan(), to_mdspan());
     }
 
     template <class OtherElementType,
@@ -441,22 +499,25 @@ public:
             Expects(static_extent(r) == gsl::narrow_cast<size_type>(Kokkos::dynamic_extent) ||
                     static_extent(r) == gsl::narrow_cast<size_type>(other.extent(r)));
         }
-        auto copy_fn = [&]<class... OtherIndexTypes>(OtherIndexTypes... indices)
-        {
-#if MDSPAN_USE_BRACKET_OPERATOR
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other[static_cast<index_type>(std::move(indices))...];
-#else
-            ctr[map(static_cast<index_type>(std::move(indices))...)] =
-                other(static_cast<index_type>(std::move(indices))...);
-#endif
-        };
-        for_each_in_extents(copy_fn, other);
+        __Detail::copy_elements(other, to_mdspan());
     }
 
     constexpr MDArray& operator=(const MDArray&) = default;
     constexpr MDArray& operator=(MDArray&&) = default;
 
+    // The expression is evaluated element by element, hence it is safe for
+    // the expression to refer to this MDArray.
+    template <class Expr>
+        requires(__Detail::Is_expression_v<Expr>&&
+                     std::is_same_v<typename Expr::mdarray_type, MDArray>)
+    constexpr MDArray& operator=(const Expr& e)
+    {
+        if (extents() != e.extents()) {
+            return (*this) = MDArray(e);
+        }
+        return assign_expression(e, [](element_type& a, const value_type& b) { a = b; });
+    }
+
     // [MDArray.members], MDArray members
 
     template <class... OtherIndexTypes>
@@ -473,7 +534,7 @@ public:
         requires((std::is_convertible_v<OtherIndexTypes, index_type> && ...) &&
                  (std::is_nothrow_constructible_v<index_type, OtherIndexTypes> && ...) &&
                  sizeof...(OtherIndexTypes) == extents_type::rank())
-    MDSPAN_FORCE_INLINE_FUNCTION const_reference
+    MDSPAN_FORCE_INLINE_FUNCTION constexpr const_reference
     operator()(OtherIndexTypes... indices) const noexcept
     {
         assert(__Detail::__check_bounds(map.extents(), indices...));
@@ -630,6 +691,43 @@ public:
 
     container_type&& extract_container() noexcept { return std::move(ctr); }
 
+    // [MDArray.alignment], alignment of the container data
+
+    // Alignment guaranteed by the container type.
+    static constexpr std::size_t container_alignment() noexcept
+    {
+        return __Detail::Container_alignment_v<container_type>;
+    }
+
+    // Actual alignment of the container data, i.e. the largest power of two
+    // that divides its address.
+    std::size_t alignment() const noexcept
+    {
+        const auto addr = reinterpret_cast<std::uintptr_t>(container_data());
+        return static_cast<std::size_t>(addr & (~addr + 1));
+    }
+
+    bool is_aligned(std::size_t n) const noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>(container_data()) % n == 0;
+    }
+
+    // Pointer to the container data that the compiler may assume to be
+    // aligned to N bytes, enabling aligned loads and stores in hot loops.
+    template <std::size_t N>
+    pointer aligned_data() noexcept
+    {
+        Expects(is_aligned(N));
+        return std::assume_aligned<N>(container_data());
+    }
+
+    template <std::size_t N>
+    const_pointer aligned_data() const noexcept
+    {
+        Expects(is_aligned(N));
+        return std::assume_aligned<N>(container_data());
+    }
+
     template <class OtherElementType,
               class OtherExtents,
               class OtherLayoutType,
@@ -708,29 +806,37 @@ public:
         std::swap(x.map, y.map);
     }
 
+    // Apply f to each element. Exhaustive mappings are traversed by a flat
+    // loop over the container, other strided mappings by nested loops with
+    // the strides hoisted out.
     template <class Callable>
     constexpr MDArray& apply(Callable&& f) noexcept
     {
-        auto apply_fn = [&]<class... IndexTypes>(IndexTypes... indices)
-        {
-            std::forward<Callable>(f)(ctr[map(static_cast<index_type>(std::move(indices))...)]);
-        };
-        for_each_in_extents(apply_fn, extents(), layout_type{});
-
+        pointer data = std::assume_aligned<container_alignment()>(container_data());
+        if (map.is_exhaustive()) {
+            const size_type n = size();
+            for (size_type k = 0; k < n; ++k) {
+                f(data[k]);
+            }
+        }
+        else if constexpr (mapping_type::is_always_strided()) {
+            for_each_offset([&](index_type k) { f(data[k]); }, map);
+        }
+        else {
+            auto apply_fn = [&]<class... IndexTypes>(IndexTypes... indices)
+            {
+                f(ctr[map(static_cast<index_type>(std::move(indices))...)]);
+            };
+            for_each_in_extents(apply_fn, extents(), layout_type{});
+        }
         return *this;
     }
 
     template <class Callable, class ValueType>
+        requires(!Is_execution_policy_v<Callable>)
     constexpr MDArray& apply(Callable&& f, const ValueType& val) noexcept
     {
-        auto apply_fn = [&]<class... IndexTypes>(IndexTypes... indices)
-        {
-            std::forward<Callable>(f)(ctr[map(static_cast<index_type>(std::move(indices))...)],
-                                      val);
-        };
-        for_each_in_extents(apply_fn, extents(), layout_type{});
-
-        return *this;
+        return apply([&](element_type& a) { f(a, val); });
     }
 
     template <class Callable>
@@ -738,17 +844,26 @@ public:
     {
         Expects(extents() == m.extents());
 
+        if (map.is_exhaustive() && map == m.mapping()) {
+            pointer data = container_data();
+            const_pointer m_data = m.container_data();
+            const size_type n = size();
+            for (size_type k = 0; k < n; ++k) {
+                f(data[k], m_data[k]);
+            }
+            return *this;
+        }
         auto apply_fn = [&]<class... IndexTypes>(IndexTypes... indices)
         {
 #if _MSC_VER
 #pragma warning(disable : 4834)
 #endif // _MSC_VER
 #if MDSPAN_USE_BRACKET_OPERATOR
-            std::forward<Callable>(f)(ctr[map(static_cast<index_type>(std::move(indices))...)],
-                                      m[static_cast<index_type>(std::move(indices))...]);
+            f(ctr[map(static_cast<index_type>(std::move(indices))...)],
+              m[static_cast<index_type>(std::move(indices))...]);
 #else
-            std::forward<Callable>(f)(ctr[map(static_cast<index_type>(std::move(indices))...)],
-                                      m(static_cast<index_type>(std::move(indices))...));
+            f(ctr[map(static_cast<index_type>(std::move(indices))...)],
+              m(static_cast<index_type>(std::move(indices))...));
 #endif
 #if _MSC_VER
 #pragma warning(default : 4834)
@@ -759,6 +874,74 @@ public:
         return *this;
     }
 
+    // Apply f to each element using an execution policy (see execution.h).
+    // Exhaustive mappings are split into contiguous ranges of the container,
+    // other strided mappings into slabs along the slowest-varying extent.
+    template <class ExecutionPolicy, class Callable>
+        requires(Is_execution_policy_v<ExecutionPolicy>)
+    constexpr MDArray& apply(ExecutionPolicy&& policy, Callable&& f) noexcept
+    {
+        if constexpr (__Detail::Is_parallel_policy_v<ExecutionPolicy> &&
+                      !__Detail::Container_is_array_v<container_type> && (rank() > 0)) {
+            if (!std::is_constant_evaluated()) {
+                if (map.is_exhaustive()) {
+                    pointer data = std::assume_aligned<container_alignment()>(container_data());
+                    auto apply_range = [&](size_type first, size_type last) {
+                        auto apply_fn = [&](size_type k) { f(data[k]); };
+                        __Detail::for_each_index(policy, first, last, apply_fn);
+                    };
+                    __Detail::parallel_for(policy, size(), size(), apply_range);
+                    return *this;
+                }
+                if constexpr (mapping_type::is_always_strided()) {
+                    auto apply_slab = [&](auto v) {
+                        for_each_offset([&](index_type k) { f(v.data_handle()[k]); }, v.mapping());
+                    };
+                    __Detail::parallel_for_each_slab(policy, apply_slab, to_mdspan());
+                    return *this;
+                }
+            }
+        }
+        return apply(f);
+    }
+
+    template <class ExecutionPolicy, class Callable>
+        requires(Is_execution_policy_v<ExecutionPolicy>)
+    constexpr MDArray& apply(ExecutionPolicy&& policy, const MDArray& m, Callable&& f) noexcept
+    {
+        Expects(extents() == m.extents());
+
+        if constexpr (__Detail::Is_parallel_policy_v<ExecutionPolicy> &&
+                      !__Detail::Container_is_array_v<container_type> && (rank() > 0)) {
+            if (!std::is_constant_evaluated()) {
+                if (map.is_exhaustive() && map == m.mapping()) {
+                    pointer data = container_data();
+                    const_pointer m_data = m.container_data();
+                    auto apply_range = [&](size_type first, size_type last) {
+                        auto apply_fn = [&](size_type k) { f(data[k], m_data[k]); };
+                        __Detail::for_each_index(policy, first, last, apply_fn);
+                    };
+                    __Detail::parallel_for(policy, size(), size(), apply_range);
+                    return *this;
+                }
+                auto apply_slab = [&](auto u, auto v) {
+                    auto apply_fn = [&]<class... IndexTypes>(IndexTypes... indices)
+                    {
+#if MDSPAN_USE_BRACKET_OPERATOR
+                        f(u[indices...], v[indices...]);
+#else
+                        f(u(indices...), v(indices...));
+#endif
+                    };
+                    for_each_in_extents(apply_fn, u);
+                };
+                __Detail::parallel_for_each_slab(policy, apply_slab, to_mdspan(), m.to_mdspan());
+                return *this;
+            }
+        }
+        return apply(m, f);
+    }
+
     template <class OtherElementType>
         requires(std::is_convertible_v<element_type, OtherElementType>)
     constexpr MDArray& operator=(const OtherElementType& value) noexcept
@@ -811,7 +994,77 @@ public:
         return apply(m, [](element_type& a, const element_type& b) { a -= b; });
     }
 
+    template <class Expr>
+        requires(__Detail::Is_expression_v<Expr>&&
+                     std::is_same_v<typename Expr::mdarray_type, MDArray>)
+    constexpr MDArray& operator+=(const Expr& e)
+    {
+        Expects(extents() == e.extents());
+        return assign_expression(e, [](element_type& a, const value_type& b) { a += b; });
+    }
+
+    template <class Expr>
+        requires(__Detail::Is_expression_v<Expr>&&
+                     std::is_same_v<typename Expr::mdarray_type, MDArray>)
+    constexpr MDArray& operator-=(const Expr& e)
+    {
+        Expects(extents() == e.extents());
+        return assign_expression(e, [](element_type& a, const value_type& b) { a -= b; });
+    }
+
+    // Evaluate an element-wise expression using an execution policy (see
+    // execution.h). Expressions whose operands share the mapping of this
+    // MDArray are split over the thread pool for par and par_unseq.
+    template <class ExecutionPolicy, class Expr>
+        requires(Is_execution_policy_v<ExecutionPolicy> && __Detail::Is_expression_v<Expr> &&
+                 std::is_same_v<typename Expr::mdarray_type, MDArray>)
+    MDArray& assign(ExecutionPolicy&& policy, const Expr& e)
+    {
+        Expects(extents() == e.extents());
+        return assign_expression(policy, e,
+                                 [](element_type& a, const value_type& b) { a = b; });
+    }
+
 private:
+    // Evaluate the expression in a single pass. If all operands share the
+    // mapping of this MDArray, the containers are traversed by a flat index,
+    // which a parallel policy splits over the thread pool.
+    template <class Expr, class Callable>
+    constexpr MDArray& assign_expression(const Expr& e, Callable&& f)
+    {
+        return assign_expression(Sci::execution::seq, e, f);
+    }
+
+    template <class ExecutionPolicy, class Expr, class Callable>
+    constexpr MDArray& assign_expression(ExecutionPolicy&& policy, const Expr& e, Callable&& f)
+    {
+        if (map.is_exhaustive() && e.is_flat(map)) {
+            pointer data = std::assume_aligned<container_alignment()>(container_data());
+            auto assign_range = [&](size_type first, size_type last) {
+                for (size_type k = first; k < last; ++k) {
+                    f(data[k], e.flat(k));
+                }
+            };
+            if constexpr (__Detail::Is_parallel_policy_v<ExecutionPolicy> &&
+                          !__Detail::Container_is_array_v<container_type>) {
+                if (!std::is_constant_evaluated()) {
+                    __Detail::parallel_for(policy, size(), size(), assign_range);
+                    return *this;
+                }
+            }
+            assign_range(0, size());
+        }
+        else {
+            auto assign_fn = [&]<class... IndexTypes>(IndexTypes... indices)
+            {
+                f(ctr[map(static_cast<index_type>(indices)...)],
+                  e(static_cast<index_type>(indices)...));
+            };
+            for_each_in_extents(assign_fn, extents(), layout_type{});
+        }
+        return *this;
+    }
+
     mapping_type map;
     container_type ctr;
 };
@@ -876,6 +1129,13 @@ template <class ElementType, class Extents, class Layout, class Accessor, class
 MDArray(const Kokkos::mdspan<ElementType, Extents, Layout, Accessor>&, const Alloc&)
     -> MDArray<std::remove_cv_t<ElementType>, Extents, Layout>;
 
+template <class Expr>
+    requires(__Detail::Is_expression_v<Expr>)
+MDArray(const Expr&) -> MDArray<typename Expr::mdarray_type::element_type,
+                                typename Expr::mdarray_type::extents_type,
+                                typename Expr::mdarray_type::layout_type,
+                                typename Expr::mdarray_type::container_type>;
+
 } // namespace Sci
 
 #endif // SCILIB_MDArray_BITS_H
@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_MMAP_CONTAINER_H
+#define SCILIB_MDARRAY_MMAP_CONTAINER_H
+
+#if __has_include(<sys/mman.h>)
+#define SCILIB_HAS_MMAP 1
+
+#include <cstddef>
+#include <fcntl.h>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace Sci {
+
+enum class Mmap_mode {
+    read_only,    // writes are not permitted
+    read_write,   // writes go to the file
+    copy_on_write // writes are private to the process
+};
+
+enum class Mmap_advice { normal, sequential, random, willneed };
+
+//--------------------------------------------------------------------------------------------------
+// Container backed by a memory-mapped file:
+//
+// The file contents are used as a flat array of T starting at a byte offset,
+// which need not be page aligned. Pages are read on demand by the OS, hence
+// arrays larger than the physical memory can be processed. It is used as the
+// Container parameter of MDArray, giving views over on-disk data with no
+// copying:
+//
+//   Sci::MappedMatrix<const double> a(Kokkos::dextents<Sci::index, 2>(n, m),
+//                                     Sci::mmap_container<const double>("a.bin"));
+//
+// Read-only mappings need a const element type, so that writes to the
+// pages fail to compile rather than fault at run time. Mutable containers
+// map the file copy-on-write unless read_write is requested.
+//
+// The container is move-only since a mapping has a single owner.
+template <class T>
+    requires(std::is_trivially_copyable_v<std::remove_const_t<T>>)
+class mmap_container {
+public:
+    using value_type = std::remove_const_t<T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr Mmap_mode default_mode =
+        std::is_const_v<T> ? Mmap_mode::read_only : Mmap_mode::copy_on_write;
+
+    mmap_container() = default;
+
+    // Map an existing file.
+    explicit mmap_container(const std::string& path,
+                            Mmap_mode mode = default_mode,
+                            std::size_t offset = 0)
+    {
+        if (!std::is_const_v<T> && mode == Mmap_mode::read_only) {
+            throw std::invalid_argument(
+                "mmap_container: read-only mappings need a const element type");
+        }
+        const int flags = (mode == Mmap_mode::read_write) ? O_RDWR : O_RDONLY;
+        const int fd = ::open(path.c_str(), flags);
+        if (fd == -1) {
+            throw std::runtime_error("mmap_container: cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+            ::close(fd);
+            throw std::runtime_error("mmap_container: cannot stat " + path);
+        }
+        const auto file_size = static_cast<std::size_t>(st.st_size);
+        const std::size_t n = (file_size > offset) ? (file_size - offset) / sizeof(T) : 0;
+        map(fd, mode, offset, n);
+    }
+
+    // Create a file holding n elements after offset, or extend an existing
+    // one, and map it read-write.
+    static mmap_container create(const std::string& path, size_type n, std::size_t offset = 0)
+        requires(!std::is_const_v<T>)
+    {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd == -1) {
+            throw std::runtime_error("mmap_container: cannot create " + path);
+        }
+        struct stat st;
+        const auto bytes = static_cast<off_t>(offset + n * sizeof(T));
+        if (::fstat(fd, &st) == -1 || (st.st_size < bytes && ::ftruncate(fd, bytes) == -1)) {
+            ::close(fd);
+            throw std::runtime_error("mmap_container: cannot resize " + path);
+        }
+        mmap_container res;
+        res.map(fd, Mmap_mode::read_write, offset, n);
+        return res;
+    }
+
+    mmap_container(const mmap_container&) = delete;
+    mmap_container& operator=(const mmap_container&) = delete;
+
+    mmap_container(mmap_container&& other) noexcept { swap(other); }
+
+    mmap_container& operator=(mmap_container&& other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~mmap_container() { unmap(); }
+
+    void swap(mmap_container& other) noexcept
+    {
+        std::swap(base, other.base);
+        std::swap(base_len, other.base_len);
+        std::swap(ptr, other.ptr);
+        std::swap(sz, other.sz);
+        std::swap(md, other.md);
+    }
+
+    size_type size() const noexcept { return sz; }
+    bool empty() const noexcept { return sz == 0; }
+    Mmap_mode mode() const noexcept { return md; }
+
+    pointer data() noexcept { return ptr; }
+    const_pointer data() const noexcept { return ptr; }
+
+    iterator begin() noexcept { return ptr; }
+    iterator end() noexcept { return ptr + sz; }
+    const_iterator begin() const noexcept { return ptr; }
+    const_iterator end() const noexcept { return ptr + sz; }
+    const_iterator cbegin() const noexcept { return ptr; }
+    const_iterator cend() const noexcept { return ptr + sz; }
+
+    reference operator[](size_type i) noexcept { return ptr[i]; }
+    const_reference operator[](size_type i) const noexcept { return ptr[i]; }
+
+    // Tell the OS how the data will be accessed.
+    void advise(Mmap_advice advice) const
+    {
+        if (!base) {
+            return;
+        }
+        int adv = POSIX_MADV_NORMAL;
+        switch (advice) {
+        case Mmap_advice::sequential:
+            adv = POSIX_MADV_SEQUENTIAL;
+            break;
+        case Mmap_advice::random:
+            adv = POSIX_MADV_RANDOM;
+            break;
+        case Mmap_advice::willneed:
+            adv = POSIX_MADV_WILLNEED;
+            break;
+        default:
+            break;
+        }
+        if (::posix_madvise(base, base_len, adv) != 0) {
+            throw std::runtime_error("mmap_container: posix_madvise failed");
+        }
+    }
+
+    // Write modified pages back to the file.
+    void sync() const
+    {
+        if (base && md == Mmap_mode::read_write && ::msync(base, base_len, MS_SYNC) == -1) {
+            throw std::runtime_error("mmap_container: msync failed");
+        }
+    }
+
+private:
+    // Map n elements at offset and close fd; the mapping keeps the file open.
+    void map(int fd, Mmap_mode mode, std::size_t offset, size_type n)
+    {
+        Expects(offset % alignof(T) == 0);
+        if (n > 0) {
+            const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t first = offset - offset % page;
+            const int prot = (mode == Mmap_mode::read_only) ? PROT_READ : PROT_READ | PROT_WRITE;
+            const int flags = (mode == Mmap_mode::copy_on_write) ? MAP_PRIVATE : MAP_SHARED;
+
+            base_len = offset - first + n * sizeof(T);
+            base = ::mmap(nullptr, base_len, prot, flags, fd, static_cast<off_t>(first));
+            if (base == MAP_FAILED) {
+                base = nullptr;
+                ::close(fd);
+                throw std::runtime_error("mmap_container: mmap failed");
+            }
+            ptr = reinterpret_cast<T*>(static_cast<char*>(base) + (offset - first));
+            sz = n;
+        }
+        md = mode;
+        ::close(fd);
+    }
+
+    void unmap() noexcept
+    {
+        if (base) {
+            ::munmap(base, base_len);
+        }
+        base = nullptr;
+        base_len = 0;
+        ptr = nullptr;
+        sz = 0;
+    }
+
+    void* base = nullptr;
+    std::size_t base_len = 0;
+    T* ptr = nullptr;
+    size_type sz = 0;
+    Mmap_mode md = default_mode;
+};
+
+} // namespace Sci
+
+#endif // __has_include(<sys/mman.h>)
+
+#endif // SCILIB_MDARRAY_MMAP_CONTAINER_H
@@ -0,0 +1,371 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_NPY_H
+#define SCILIB_MDARRAY_NPY_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Sci {
+
+//--------------------------------------------------------------------------------------------------
+// Binary I/O in the NumPy .npy format:
+//
+// The format is described in
+//   https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+//
+// layout_right is stored with fortran_order False and layout_left with
+// fortran_order True. Other layouts are written in row-major order. Files
+// are read into layout_right or layout_left MDArrays; only native byte order
+// is supported.
+
+namespace __Detail {
+
+template <class T>
+struct Npy_kind {
+    static constexpr char value = std::is_same_v<T, bool>   ? 'b'
+                                  : std::is_floating_point_v<T> ? 'f'
+                                  : std::is_signed_v<T>         ? 'i'
+                                                                : 'u';
+};
+
+template <class T>
+struct Npy_kind<std::complex<T>> {
+    static constexpr char value = 'c';
+};
+
+template <class T>
+concept Npy_element =
+    std::is_arithmetic_v<T> || std::is_same_v<T, std::complex<float>> ||
+    std::is_same_v<T, std::complex<double>>;
+
+template <class T>
+inline std::string npy_descr()
+{
+    char order = (std::endian::native == std::endian::little) ? '<' : '>';
+    if constexpr (sizeof(T) == 1) {
+        order = '|';
+    }
+    return order + std::string(1, Npy_kind<T>::value) + std::to_string(sizeof(T));
+}
+
+struct Npy_header {
+    std::string descr;
+    bool fortran_order = false;
+    std::vector<std::size_t> shape;
+    std::size_t data_offset = 0;
+};
+
+inline void write_npy_header(std::ostream& os,
+                             const std::string& descr,
+                             bool fortran_order,
+                             const std::vector<std::size_t>& shape)
+{
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': ";
+    dict += fortran_order ? "True" : "False";
+    dict += ", 'shape': (";
+    for (std::size_t i = 0; i < shape.size(); ++i) {
+        dict += std::to_string(shape[i]);
+        if (shape.size() == 1 || i + 1 < shape.size()) {
+            dict += ",";
+        }
+        if (i + 1 < shape.size()) {
+            dict += " ";
+        }
+    }
+    dict += "), }";
+
+    // Pad with spaces so that the data starts at a multiple of 64 bytes.
+    constexpr std::size_t preamble = 10; // magic, version and header length
+    const std::size_t total = (preamble + dict.size() + 1 + 63) / 64 * 64;
+    dict.append(total - preamble - dict.size() - 1, ' ');
+    dict += '\n';
+
+    const auto len = static_cast<std::uint16_t>(dict.size());
+    const char magic[] = {'\x93', 'N', 'U', 'M', 'P', 'Y', '\x01', '\x00'};
+    os.write(magic, sizeof(magic));
+    const char len_le[] = {static_cast<char>(len & 0xff), static_cast<char>(len >> 8)};
+    os.write(len_le, sizeof(len_le));
+    os.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+}
+
+inline std::string npy_dict_value(const std::string& dict, const std::string& key)
+{
+    constexpr auto npos = std::string::npos;
+
+    auto pos = dict.find("'" + key + "'");
+    if (pos == npos) {
+        throw std::runtime_error("npy: missing key " + key);
+    }
+    pos = dict.find(':', pos);
+    const auto first = (pos == npos) ? npos : dict.find_first_not_of(' ', pos + 1);
+    std::size_t last = npos;
+    if (first != npos) {
+        if (dict[first] == '(' || dict[first] == '\'') {
+            // Tuples and strings end with, and include, the closing character.
+            last = dict.find(dict[first] == '(' ? ')' : '\'', first + 1);
+            if (last != npos) {
+                ++last;
+            }
+        }
+        else {
+            last = dict.find_first_of(",}", first);
+        }
+    }
+    if (last == npos) {
+        throw std::runtime_error("npy: bad value for key " + key);
+    }
+    return dict.substr(first, last - first);
+}
+
+inline Npy_header read_npy_header(std::istream& is)
+{
+    char magic[8];
+    if (!is.read(magic, sizeof(magic)) || std::string(magic, 6) != "\x93NUMPY") {
+        throw std::runtime_error("npy: not a .npy file");
+    }
+    const int major = static_cast<unsigned char>(magic[6]);
+
+    std::size_t len = 0;
+    const int nlen = (major == 1) ? 2 : 4;
+    for (int i = 0; i < nlen; ++i) {
+        len |= static_cast<std::size_t>(static_cast<unsigned char>(is.get())) << (8 * i);
+    }
+    if (!is) {
+        throw std::runtime_error("npy: truncated header");
+    }
+
+    // Bound the header length by the rest of the file before allocating.
+    const auto here = is.tellg();
+    if (here != std::istream::pos_type(-1) && is.seekg(0, std::ios::end)) {
+        const auto end = is.tellg();
+        is.seekg(here);
+        if (end == std::istream::pos_type(-1) || len > static_cast<std::size_t>(end - here)) {
+            throw std::runtime_error("npy: header length exceeds file size");
+        }
+    }
+    is.clear();
+    std::string dict(len, ' ');
+    if (!is.read(dict.data(), static_cast<std::streamsize>(len))) {
+        throw std::runtime_error("npy: truncated header");
+    }
+
+    Npy_header res;
+    res.data_offset = 6 + 2 + nlen + len;
+
+    const auto descr = npy_dict_value(dict, "descr");
+    if (descr.size() < 2 || descr.front() != '\'' || descr.back() != '\'') {
+        throw std::runtime_error("npy: descr is not a quoted string");
+    }
+    res.descr = descr.substr(1, descr.size() - 2);
+    res.fortran_order = npy_dict_value(dict, "fortran_order") == "True";
+
+    const auto shape = npy_dict_value(dict, "shape");
+    std::size_t pos = 1;
+    while (pos < shape.size()) {
+        pos = shape.find_first_of("0123456789", pos);
+        if (pos == std::string::npos) {
+            break;
+        }
+        std::size_t n;
+        try {
+            res.shape.push_back(std::stoull(shape.substr(pos), &n));
+        }
+        catch (const std::out_of_range&) {
+            throw std::runtime_error("npy: shape value out of range");
+        }
+        pos += n;
+    }
+    return res;
+}
+
+// Number of elements of the array, which has been checked to fit in
+// index_type by npy_extents.
+inline std::size_t npy_size(const Npy_header& h)
+{
+    std::size_t n = 1;
+    for (auto e : h.shape) {
+        n *= e;
+    }
+    return n;
+}
+
+template <class T, class Extents>
+inline Extents npy_extents(const Npy_header& h)
+{
+    using index_type = typename Extents::index_type;
+
+    if (h.descr != npy_descr<T>()) {
+        throw std::runtime_error("npy: dtype " + h.descr + " does not match " + npy_descr<T>());
+    }
+    if (h.shape.size() != Extents::rank()) {
+        throw std::runtime_error("npy: rank mismatch");
+    }
+    std::array<index_type, Extents::rank()> exts;
+    for (std::size_t r = 0; r < Extents::rank(); ++r) {
+        if (h.shape[r] > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) {
+            throw std::runtime_error("npy: extent out of range");
+        }
+        exts[r] = static_cast<index_type>(h.shape[r]);
+        if (Extents::static_extent(r) != Kokkos::dynamic_extent &&
+            Extents::static_extent(r) != h.shape[r]) {
+            throw std::runtime_error("npy: extent mismatch");
+        }
+    }
+    // The number of elements must also fit in index_type.
+    if (std::find(h.shape.begin(), h.shape.end(), std::size_t{0}) == h.shape.end()) {
+        auto n = static_cast<std::size_t>(std::numeric_limits<index_type>::max());
+        for (auto e : h.shape) {
+            n /= e;
+        }
+        if (n == 0) {
+            throw std::runtime_error("npy: shape too large");
+        }
+    }
+    return Extents(exts);
+}
+
+} // namespace __Detail
+
+// Write an mdspan to a .npy file.
+template <class T, class Extents, class Layout, class Accessor>
+    requires(__Detail::Npy_element<std::remove_cv_t<T>>)
+inline void save_npy(const std::string& path, Kokkos::mdspan<T, Extents, Layout, Accessor> m)
+{
+    using value_type = std::remove_cv_t<T>;
+
+    std::ofstream os(path, std::ios::binary);
+    if (!os) {
+        throw std::runtime_error("save_npy: cannot open " + path);
+    }
+    std::vector<std::size_t> shape(m.rank());
+    for (std::size_t r = 0; r < m.rank(); ++r) {
+        shape[r] = static_cast<std::size_t>(m.extent(r));
+    }
+    constexpr bool is_contiguous = (std::is_same_v<Layout, Kokkos::layout_left> ||
+                                    std::is_same_v<Layout, Kokkos::layout_right>) &&
+                                   std::is_same_v<Accessor, Kokkos::default_accessor<T>>;
+
+    constexpr bool fortran_order = is_contiguous && std::is_same_v<Layout, Kokkos::layout_left>;
+
+    __Detail::write_npy_header(os, __Detail::npy_descr<value_type>(), fortran_order, shape);
+    if constexpr (is_contiguous) {
+        os.write(reinterpret_cast<const char*>(m.data_handle()),
+                 static_cast<std::streamsize>(m.size() * sizeof(value_type)));
+    }
+    else {
+        std::vector<value_type> buf;
+        buf.reserve(m.size());
+        auto push = [&]<class... IndexTypes>(IndexTypes... indices)
+        {
+#if MDSPAN_USE_BRACKET_OPERATOR
+            buf.push_back(m[indices...]);
+#else
+            buf.push_back(m(indices...));
+#endif
+        };
+        for_each_in_extents(push, m.extents(), Kokkos::layout_right{});
+        os.write(reinterpret_cast<const char*>(buf.data()),
+                 static_cast<std::streamsize>(buf.size() * sizeof(value_type)));
+    }
+    if (!os) {
+        throw std::runtime_error("save_npy: failed writing " + path);
+    }
+}
+
+template <class T, class Extents, class Layout, class Container>
+inline void save_npy(const std::string& path, const MDArray<T, Extents, Layout, Container>& m)
+{
+    save_npy(path, m.to_mdspan());
+}
+
+// Read a .npy file into a new MDArray of type M. A file stored in the other
+// of row-major and column-major order is transposed on reading.
+template <class M>
+    requires(__Detail::Is_mdarray_v<M> && __Detail::Npy_element<typename M::value_type> &&
+             (std::is_same_v<typename M::layout_type, Kokkos::layout_left> ||
+              std::is_same_v<typename M::layout_type, Kokkos::layout_right>) )
+inline M load_npy(const std::string& path)
+{
+    using value_type = typename M::value_type;
+    using extents_type = typename M::extents_type;
+    using layout_type = typename M::layout_type;
+
+    std::ifstream is(path, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("load_npy: cannot open " + path);
+    }
+    const auto h = __Detail::read_npy_header(is);
+    const auto exts = __Detail::npy_extents<value_type, extents_type>(h);
+
+    auto read = [&](auto& res) {
+        const auto bytes = static_cast<std::streamsize>(res.size() * sizeof(value_type));
+        if (!is.read(reinterpret_cast<char*>(res.container_data()), bytes)) {
+            throw std::runtime_error("load_npy: truncated data in " + path);
+        }
+    };
+
+    if (h.fortran_order != std::is_same_v<layout_type, Kokkos::layout_left>) {
+        using other_layout = std::conditional_t<std::is_same_v<layout_type, Kokkos::layout_left>,
+                                                Kokkos::layout_right,
+                                                Kokkos::layout_left>;
+
+        MDArray<value_type, extents_type, other_layout> tmp(Sci::uninitialized, exts);
+        read(tmp);
+        return M(tmp.to_mdspan());
+    }
+    M res(Sci::uninitialized, exts);
+    read(res);
+    return res;
+}
+
+#ifdef SCILIB_HAS_MMAP
+// Map a .npy file into memory without copying. The storage order of the file
+// must match Layout. Read-only maps need a const T (see mmap_container.h):
+//
+//   auto a = Sci::map_npy<const double, 2>("a.npy");
+template <class T, std::size_t Rank, class Layout = Kokkos::layout_right>
+    requires(__Detail::Npy_element<std::remove_const_t<T>> &&
+             (std::is_same_v<Layout, Kokkos::layout_left> ||
+              std::is_same_v<Layout, Kokkos::layout_right>) )
+inline MDArray<T, Kokkos::dextents<index, Rank>, Layout, mmap_container<T>>
+map_npy(const std::string& path, Mmap_mode mode = mmap_container<T>::default_mode)
+{
+    using extents_type = Kokkos::dextents<index, Rank>;
+
+    std::ifstream is(path, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("map_npy: cannot open " + path);
+    }
+    const auto h = __Detail::read_npy_header(is);
+    is.close();
+
+    const auto exts = __Detail::npy_extents<std::remove_const_t<T>, extents_type>(h);
+    if (h.fortran_order != std::is_same_v<Layout, Kokkos::layout_left>) {
+        throw std::runtime_error("map_npy: storage order does not match layout");
+    }
+    mmap_container<T> c(path, mode, h.data_offset);
+    if (__Detail::npy_size(h) > c.size()) {
+        throw std::runtime_error("map_npy: truncated data in " + path);
+    }
+    return {exts, std::move(c)};
+}
+#endif
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_NPY_H
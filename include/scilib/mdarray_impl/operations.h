@@ -12,6 +12,7 @@
 #include "../linalg_impl/blas2_matrix_vector_product.h"
 #include "../linalg_impl/blas3_matrix_product.h"
 #include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <type_traits>
@@ -54,6 +55,9 @@ constexpr bool operator==(const MDArray<T, Extents, Layout, Container>& a,
     if ((a.rank() != b.rank()) || (a.extents() != b.extents())) {
         return false;
     }
+    if (a.is_exhaustive() && a.mapping() == b.mapping()) {
+        return std::equal(a.container_data(), a.container_data() + a.size(), b.container_data());
+    }
     bool result = true;
 
     auto is_equal = [&]<class... IndexTypes>(IndexTypes... indices)
@@ -89,95 +93,72 @@ constexpr bool operator!=(const MDArray<T, Extents, Layout, Container>& a,
 
 //--------------------------------------------------------------------------------------------------
 // Arithmetic operations:
+//
+// Element-wise operations are lazily evaluated, see expression.h.
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator-(const MDArray<T, Extents, Layout, Container>& v)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator-(E&& v)
 {
-    MDArray<T, Extents, Layout, Container> res = v;
-    return res *= -T{1};
+    return __Detail::make_unary_expr<std::negate<>>(std::forward<E>(v));
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator+(const MDArray<T, Extents, Layout, Container>& a,
-          const MDArray<T, Extents, Layout, Container>& b)
+template <class E1, class E2>
+    requires(__Detail::Is_mdarray_operand_v<E1>&& __Detail::Is_mdarray_operand_v<E2>&&
+                 std::is_same_v<__Detail::Mdarray_type_t<E1>, __Detail::Mdarray_type_t<E2>>)
+constexpr auto operator+(E1&& a, E2&& b)
 {
-    if constexpr (Extents::rank() <= 1) {
-        MDArray<T, Extents, Layout, Container> res(a.extents());
-        Kokkos::Experimental::linalg::add(a.to_mdspan(), b.to_mdspan(), res.to_mdspan());
-        return res;
-    }
-    else {
-        MDArray<T, Extents, Layout, Container> res = a;
-        return res += b;
-    }
+    return __Detail::make_binary_expr<std::plus<>>(std::forward<E1>(a), std::forward<E2>(b));
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator-(const MDArray<T, Extents, Layout, Container>& a,
-          const MDArray<T, Extents, Layout, Container>& b)
+template <class E1, class E2>
+    requires(__Detail::Is_mdarray_operand_v<E1>&& __Detail::Is_mdarray_operand_v<E2>&&
+                 std::is_same_v<__Detail::Mdarray_type_t<E1>, __Detail::Mdarray_type_t<E2>>)
+constexpr auto operator-(E1&& a, E2&& b)
 {
-    MDArray<T, Extents, Layout, Container> res = a;
-    return res -= b;
+    return __Detail::make_binary_expr<std::minus<>>(std::forward<E1>(a), std::forward<E2>(b));
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator+(const MDArray<T, Extents, Layout, Container>& v, const T& scalar)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator+(E&& v, const typename __Detail::Mdarray_type_t<E>::value_type& scalar)
 {
-    MDArray<T, Extents, Layout, Container> res = v;
-    return res += scalar;
+    return __Detail::make_binary_expr<std::plus<>>(std::forward<E>(v), scalar);
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator-(const MDArray<T, Extents, Layout, Container>& v, const T& scalar)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator-(E&& v, const typename __Detail::Mdarray_type_t<E>::value_type& scalar)
 {
-    MDArray<T, Extents, Layout, Container> res = v;
-    return res -= scalar;
+    return __Detail::make_binary_expr<std::minus<>>(std::forward<E>(v), scalar);
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator*(const MDArray<T, Extents, Layout, Container>& v, const T& scalar)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator*(E&& v, const typename __Detail::Mdarray_type_t<E>::value_type& scalar)
 {
-    using value_type = std::remove_cv_t<T>;
-    value_type scaling_factor = scalar;
-
-    return MDArray<T, Extents, Layout, Container>(
-        Kokkos::Experimental::linalg::scaled(scaling_factor, v.to_mdspan()));
+    return __Detail::make_binary_expr<std::multiplies<>>(std::forward<E>(v), scalar);
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator*(const T& scalar, const MDArray<T, Extents, Layout, Container>& v)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator*(const typename __Detail::Mdarray_type_t<E>::value_type& scalar, E&& v)
 {
-    using value_type = std::remove_cv_t<T>;
-    value_type scaling_factor = scalar;
-
-    return MDArray<T, Extents, Layout, Container>(
-        Kokkos::Experimental::linalg::scaled(scaling_factor, v.to_mdspan()));
+    return __Detail::make_binary_expr<std::multiplies<>>(scalar, std::forward<E>(v));
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator/(const MDArray<T, Extents, Layout, Container>& v, const T& scalar)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator/(E&& v, const typename __Detail::Mdarray_type_t<E>::value_type& scalar)
 {
-    using value_type = std::remove_cv_t<T>;
-    value_type scaling_factor = value_type{1} / scalar;
-
-    return MDArray<T, Extents, Layout, Container>(
-        Kokkos::Experimental::linalg::scaled(scaling_factor, v.to_mdspan()));
+    return __Detail::make_binary_expr<std::divides<>>(std::forward<E>(v), scalar);
 }
 
-template <class T, class Extents, class Layout, class Container>
-constexpr MDArray<T, Extents, Layout, Container>
-operator%(const MDArray<T, Extents, Layout, Container>& v, const T& scalar)
+template <class E>
+    requires(__Detail::Is_mdarray_operand_v<E>)
+constexpr auto operator%(E&& v, const typename __Detail::Mdarray_type_t<E>::value_type& scalar)
 {
-    MDArray<T, Extents, Layout, Container> res = v;
-    return res %= scalar;
+    return __Detail::make_binary_expr<std::modulus<>>(std::forward<E>(v), scalar);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -189,6 +170,22 @@ constexpr Matrix<T, Layout> operator*(const Matrix<T, Layout>& a, const Matrix<T
     return Sci::Linalg::matrix_product(a, b);
 }
 
+template <class T,
+          class IndexType,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          std::size_t ncols_b,
+          class Layout,
+          class Container_a,
+          class Container_b>
+    requires(__Detail::Is_small_static_v<nrows_a, ncols_a, ncols_b>)
+constexpr auto
+operator*(const MDArray<T, Kokkos::extents<IndexType, nrows_a, ncols_a>, Layout, Container_a>& a,
+          const MDArray<T, Kokkos::extents<IndexType, ncols_a, ncols_b>, Layout, Container_b>& b)
+{
+    return Sci::Linalg::matrix_product(a, b);
+}
+
 //--------------------------------------------------------------------------------------------------
 // Matrix-vector product:
 
@@ -198,6 +195,32 @@ constexpr Vector<T, Layout> operator*(const Matrix<T, Layout>& a, const Vector<T
     return Sci::Linalg::matrix_vector_product(a, x);
 }
 
+template <class T,
+          class IndexType,
+          std::size_t nrows_a,
+          std::size_t ncols_a,
+          class Layout,
+          class Container_a,
+          class Container_x>
+    requires(__Detail::Is_small_static_v<nrows_a, ncols_a>)
+constexpr auto
+operator*(const MDArray<T, Kokkos::extents<IndexType, nrows_a, ncols_a>, Layout, Container_a>& a,
+          const MDArray<T, Kokkos::extents<IndexType, ncols_a>, Layout, Container_x>& x)
+{
+    return Sci::Linalg::matrix_vector_product(a, x);
+}
+
+// Expression operands are evaluated before the product is computed.
+template <class E1, class E2>
+    requires((__Detail::Is_expression_v<E1> || __Detail::Is_expression_v<E2>) &&
+             __Detail::Is_mdarray_operand_v<E1> && __Detail::Is_mdarray_operand_v<E2> &&
+             std::remove_cvref_t<E1>::rank() == 2 &&
+             requires(const E1& a, const E2& b) { __Detail::eval(a) * __Detail::eval(b); })
+constexpr auto operator*(const E1& a, const E2& b)
+{
+    return __Detail::eval(a) * __Detail::eval(b);
+}
+
 //--------------------------------------------------------------------------------------------------
 // Apply operations:
 
@@ -205,6 +228,12 @@ template <class T, class Extents, class Layout, class Accessor, class Callable>
 constexpr void apply(Kokkos::mdspan<T, Extents, Layout, Accessor> v, Callable&& f)
 {
     using index_type = typename Extents::index_type;
+
+    if constexpr (Kokkos::mdspan<T, Extents, Layout, Accessor>::is_always_strided()) {
+        auto apply_fn = [&](index_type k) { f(v.accessor().access(v.data_handle(), k)); };
+        for_each_offset(apply_fn, v.mapping());
+        return;
+    }
     auto apply_fn = [&]<class... IndexTypes>(IndexTypes... indices)
     {
 #if _MSC_VER
@@ -263,6 +292,55 @@ constexpr void apply(Kokkos::mdspan<T_x, Extents_x, Layout_x, Accessor_x> x,
     for_each_in_extents(apply_fn, x);
 }
 
+// Apply f using an execution policy (see execution.h). The views are split
+// into slabs along the slowest-varying extent, which are processed in
+// parallel.
+template <class ExecutionPolicy,
+          class T,
+          class Extents,
+          class Layout,
+          class Accessor,
+          class Callable>
+    requires(Is_execution_policy_v<ExecutionPolicy>)
+void apply(ExecutionPolicy&& policy, Kokkos::mdspan<T, Extents, Layout, Accessor> v, Callable&& f)
+{
+    if constexpr (__Detail::Is_parallel_policy_v<ExecutionPolicy> && (Extents::rank() > 0)) {
+        __Detail::parallel_for_each_slab(policy, [&](auto u) { apply(u, f); }, v);
+    }
+    else {
+        apply(v, f);
+    }
+}
+
+template <class ExecutionPolicy,
+          class T_x,
+          class Extents_x,
+          class Layout_x,
+          class Accessor_x,
+          class T_y,
+          class Extents_y,
+          class Layout_y,
+          class Accessor_y,
+          class Callable>
+    requires(Is_execution_policy_v<ExecutionPolicy>)
+void apply(ExecutionPolicy&& policy,
+           Kokkos::mdspan<T_x, Extents_x, Layout_x, Accessor_x> x,
+           Kokkos::mdspan<T_y, Extents_y, Layout_y, Accessor_y> y,
+           Callable&& f)
+{
+    if constexpr (__Detail::Is_parallel_policy_v<ExecutionPolicy> && (Extents_x::rank() > 0)) {
+        Expects(x.rank() == y.rank());
+        for (std::size_t r = 0; r < x.rank(); ++r) {
+            Expects(static_cast<std::size_t>(x.extent(r)) == static_cast<std::size_t>(y.extent(r)));
+        }
+        __Detail::parallel_for_each_slab(
+            policy, [&](auto u, auto w) { apply(u, w, f); }, x, y);
+    }
+    else {
+        apply(x, y, f);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 // Stream methods:
 
@@ -379,6 +457,13 @@ operator<<(std::ostream& ostrm,
     return ostrm;
 }
 
+template <class E>
+    requires(__Detail::Is_expression_v<E>)
+inline std::ostream& operator<<(std::ostream& ostrm, const E& e)
+{
+    return ostrm << typename E::mdarray_type(e);
+}
+
 template <class T, class Layout>
 inline std::istream& operator>>(std::istream& istrm, Matrix<T, Layout>& m)
 {
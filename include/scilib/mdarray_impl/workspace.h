@@ -0,0 +1,179 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef SCILIB_MDARRAY_WORKSPACE_H
+#define SCILIB_MDARRAY_WORKSPACE_H
+
+#include "aligned_allocator.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl>
+#include <memory_resource>
+
+namespace Sci {
+
+//--------------------------------------------------------------------------------------------------
+// Workspace arena for scratch arrays:
+//
+// Memory is handed out from a preallocated buffer by bumping an offset. The
+// offset is rewound when the most recent allocation is released, and reset
+// when all allocations have been released. Scratch arrays that are created
+// and destroyed in stack order, as in the LAPACK wrappers, therefore reuse
+// the same memory with no system allocations. Requests that do not fit in
+// the buffer are forwarded to the upstream resource.
+//
+// Example:
+//
+//   Sci::Workspace ws(1 << 20);
+//   Sci::Workspace_scope scope(ws); // used by the linalg scratch arrays
+//   for (...) {
+//       Sci::Linalg::eigh(a, w);
+//   }
+//
+class Workspace : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t alignment = SCILIB_MEM_ALIGNMENT;
+
+    explicit Workspace(std::size_t capacity,
+                       std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream), capacity_(capacity)
+    {
+        if (capacity_ > 0) {
+            buffer_ = static_cast<std::byte*>(upstream_->allocate(capacity_, alignment));
+        }
+    }
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    ~Workspace()
+    {
+        if (buffer_) {
+            upstream_->deallocate(buffer_, capacity_, alignment);
+        }
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    // Number of bytes currently in use in the buffer.
+    std::size_t used() const noexcept { return top_; }
+
+    // Largest number of bytes requested at any time, including requests
+    // that overflowed to the upstream resource.
+    std::size_t high_water_mark() const noexcept { return high_water_; }
+
+    // Replace the buffer; no allocations may be live.
+    void reserve(std::size_t capacity)
+    {
+        Expects(live_ == 0);
+        if (capacity <= capacity_) {
+            return;
+        }
+        if (buffer_) {
+            upstream_->deallocate(buffer_, capacity_, alignment);
+            buffer_ = nullptr;
+            capacity_ = 0;
+        }
+        buffer_ = static_cast<std::byte*>(upstream_->allocate(capacity, alignment));
+        capacity_ = capacity;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        const std::size_t offset = (top_ + align - 1) & ~(align - 1);
+        high_water_ = std::max(high_water_, offset + bytes);
+
+        if (buffer_ && offset + bytes <= capacity_) {
+            top_ = offset + bytes;
+            ++live_;
+            return buffer_ + offset;
+        }
+        return upstream_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+    {
+        const auto addr = reinterpret_cast<std::uintptr_t>(p);
+        const auto first = reinterpret_cast<std::uintptr_t>(buffer_);
+
+        if (buffer_ && addr >= first && addr < first + capacity_) {
+            const std::size_t offset = addr - first;
+            if (--live_ == 0) {
+                top_ = 0;
+            }
+            else if (offset + bytes == top_) {
+                top_ = offset;
+            }
+            return;
+        }
+        upstream_->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::byte* buffer_ = nullptr;
+    std::size_t capacity_;
+    std::size_t top_ = 0;
+    std::size_t live_ = 0;
+    std::size_t high_water_ = 0;
+};
+
+namespace __Detail {
+
+inline thread_local Workspace* current_workspace = nullptr;
+
+} // namespace __Detail
+
+// Install a workspace as the default for scratch arrays on this thread for
+// the lifetime of the scope. Scopes may be nested.
+class Workspace_scope {
+public:
+    explicit Workspace_scope(Workspace& ws) noexcept : prev(__Detail::current_workspace)
+    {
+        __Detail::current_workspace = &ws;
+    }
+
+    Workspace_scope(const Workspace_scope&) = delete;
+    Workspace_scope& operator=(const Workspace_scope&) = delete;
+
+    ~Workspace_scope() { __Detail::current_workspace = prev; }
+
+private:
+    Workspace* prev;
+};
+
+// Memory resource for scratch arrays: the workspace installed on this thread,
+// or new/delete if there is none.
+inline std::pmr::memory_resource* workspace_resource() noexcept
+{
+    if (__Detail::current_workspace) {
+        return __Detail::current_workspace;
+    }
+    return std::pmr::new_delete_resource();
+}
+
+// Create a scratch MDArray from the current workspace. The elements are
+// uninitialized and must be written before they are read.
+template <class T, class Layout = Kokkos::layout_right, class... IndexTypes>
+inline auto make_scratch(IndexTypes... exts)
+{
+    using extents_type = Kokkos::dextents<index, sizeof...(IndexTypes)>;
+    using scratch_type = MDArray<T, extents_type, Layout, pmr::Default_init_container<T>>;
+
+    return scratch_type(extents_type(exts...), workspace_resource());
+}
+
+} // namespace Sci
+
+#endif // SCILIB_MDARRAY_WORKSPACE_H
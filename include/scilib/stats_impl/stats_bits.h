@@ -10,27 +10,58 @@
 #include "../linalg.h"
 #include "../mdarray.h"
 #include <cmath>
+#include <functional>
 #include <gsl/gsl>
 #include <type_traits>
 
 namespace Sci {
 namespace Stats {
 
+// Arithmetic mean, variance, standard deviation and root-mean-square
+// deviation run on the calling thread unless an execution policy is passed
+// first (see Sci::Linalg::sum).
+
 // Arithmetic mean.
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline auto mean(ExecutionPolicy&& policy,
+                 Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
+{
+    using value_type = std::remove_cv_t<T>;
+    value_type result = Sci::Linalg::sum(policy, x) / static_cast<value_type>(x.extent(0));
+    return result;
+}
+
 template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
     requires(std::is_integral_v<IndexType>)
 inline auto mean(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
 {
-    using value_type = std::remove_cv_t<T>;
-    value_type result = Sci::Linalg::sum(x) / static_cast<value_type>(x.extent(0));
-    return result;
+    return mean(Sci::execution::seq, x);
+}
+
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline T mean(ExecutionPolicy&& policy,
+              const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
+{
+    return mean(policy, x.to_mdspan());
 }
 
 template <class T, class IndexType, std::size_t ext, class Layout, class Container>
     requires(std::is_integral_v<IndexType>)
 inline T mean(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
 {
-    return mean(x.to_mdspan());
+    return mean(Sci::execution::seq, x.to_mdspan());
 }
 
 // Median.
@@ -61,66 +92,138 @@ inline T median(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, C
 }
 
 // Variance.
-template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
-    requires(std::is_integral_v<IndexType>)
-inline auto var(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline auto var(ExecutionPolicy&& policy,
+                Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
 {
-    using index_type = IndexType;
     using value_type = std::remove_cv_t<T>;
 
     // Two-pass algorithm:
     value_type n = static_cast<value_type>(x.extent(0));
-    value_type xmean = mean(x);
-    value_type sum2 = value_type{0};
-
-    for (index_type i = 0; i < x.extent(0); ++i) {
-        sum2 += std::pow(x[i] - xmean, 2);
-    }
+    value_type xmean = mean(policy, x);
+    value_type sum2 = Sci::__Detail::reduce(
+        policy, x, value_type{0},
+        [xmean](const value_type& xi) { return (xi - xmean) * (xi - xmean); }, std::plus<>{});
     return sum2 / (n - 1.0);
 }
 
+template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
+    requires(std::is_integral_v<IndexType>)
+inline auto var(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
+{
+    return var(Sci::execution::seq, x);
+}
+
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline T var(ExecutionPolicy&& policy,
+             const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
+{
+    return var(policy, x.to_mdspan());
+}
+
 template <class T, class IndexType, std::size_t ext, class Layout, class Container>
     requires(std::is_integral_v<IndexType>)
 inline T var(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
 {
-    return var(x.to_mdspan());
+    return var(Sci::execution::seq, x.to_mdspan());
 }
 
 // Standard deviation.
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline auto stddev(ExecutionPolicy&& policy,
+                   Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
+{
+    return std::sqrt(var(policy, x));
+}
+
 template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
     requires(std::is_integral_v<IndexType>)
 inline auto stddev(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
 {
-    return std::sqrt(var(x));
+    return stddev(Sci::execution::seq, x);
+}
+
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline T stddev(ExecutionPolicy&& policy,
+                const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
+{
+    return stddev(policy, x.to_mdspan());
 }
 
 template <class T, class IndexType, std::size_t ext, class Layout, class Container>
     requires(std::is_integral_v<IndexType>)
 inline T stddev(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
 {
-    return stddev(x.to_mdspan());
+    return stddev(Sci::execution::seq, x.to_mdspan());
 }
 
 // Root-mean-square deviation.
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Accessor>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline auto rms(ExecutionPolicy&& policy,
+                Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
+{
+    using value_type = std::remove_cv_t<T>;
+
+    value_type sum2 = Sci::__Detail::reduce(
+        policy, x, value_type{0}, [](const value_type& xi) { return xi * xi; }, std::plus<>{});
+    return std::sqrt(sum2 / x.extent(0));
+}
+
 template <class T, class IndexType, std::size_t ext, class Layout, class Accessor>
     requires(std::is_integral_v<IndexType>)
 inline auto rms(Kokkos::mdspan<T, Kokkos::extents<IndexType, ext>, Layout, Accessor> x)
 {
-    using index_type = IndexType;
-    using value_type = std::remove_cv_t<T>;
+    return rms(Sci::execution::seq, x);
+}
 
-    value_type sum2 = value_type{0};
-    for (index_type i = 0; i < x.extent(0); ++i) {
-        sum2 += x[i] * x[i];
-    }
-    return std::sqrt(sum2 / x.extent(0));
+template <class ExecutionPolicy,
+          class T,
+          class IndexType,
+          std::size_t ext,
+          class Layout,
+          class Container>
+    requires(Sci::Is_execution_policy_v<ExecutionPolicy> && std::is_integral_v<IndexType>)
+inline T rms(ExecutionPolicy&& policy,
+             const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
+{
+    return rms(policy, x.to_mdspan());
 }
 
 template <class T, class IndexType, std::size_t ext, class Layout, class Container>
     requires(std::is_integral_v<IndexType>)
 inline T rms(const Sci::MDArray<T, Kokkos::extents<IndexType, ext>, Layout, Container>& x)
 {
-    return rms(x.to_mdspan());
+    return rms(Sci::execution::seq, x.to_mdspan());
 }
 
 // Covariance.
@@ -170,6 +273,86 @@ inline T cov(const Sci::MDArray<T, Kokkos::extents<IndexType_x, ext_x>, Layout_x
     return cov(x.to_mdspan(), y.to_mdspan());
 }
 
+// Expression operands are evaluated first.
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto mean(const E& e)
+{
+    return mean(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { mean(p, Sci::__Detail::eval(e)); })
+inline auto mean(P&& p, const E& e)
+{
+    return mean(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto median(const E& e)
+{
+    return median(Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto var(const E& e)
+{
+    return var(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { var(p, Sci::__Detail::eval(e)); })
+inline auto var(P&& p, const E& e)
+{
+    return var(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto stddev(const E& e)
+{
+    return stddev(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { stddev(p, Sci::__Detail::eval(e)); })
+inline auto stddev(P&& p, const E& e)
+{
+    return stddev(p, Sci::__Detail::eval(e));
+}
+
+template <class E>
+    requires(Sci::__Detail::Is_expression_v<E>)
+inline auto rms(const E& e)
+{
+    return rms(Sci::__Detail::eval(e));
+}
+
+template <class P, class E>
+    requires(Sci::__Detail::Is_expression_v<E> &&
+             requires(P&& p, const E& e) { rms(p, Sci::__Detail::eval(e)); })
+inline auto rms(P&& p, const E& e)
+{
+    return rms(p, Sci::__Detail::eval(e));
+}
+
+template <class E1, class E2>
+    requires((Sci::__Detail::Is_expression_v<E1> || Sci::__Detail::Is_expression_v<E2>) &&
+             Sci::__Detail::Is_mdarray_operand_v<E1> && Sci::__Detail::Is_mdarray_operand_v<E2> &&
+             requires(const E1& a, const E2& b) {
+                 cov(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+             })
+inline auto cov(const E1& a, const E2& b)
+{
+    return cov(Sci::__Detail::eval(a), Sci::__Detail::eval(b));
+}
+
 } // namespace Stats
 } // namespace Sci
 
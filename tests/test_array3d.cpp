@@ -63,3 +63,95 @@ TEST(TestMDArray, TestArray3DInit)
     EXPECT_EQ(m3.extent(1), 2);
     EXPECT_EQ(m3.extent(2), 2);
 }
+
+TEST(TestMDArray, TestForEachInExtents)
+{
+    Sci::Array3D<int> a(2, 3, 4);
+    Sci::Array3D<int, Kokkos::layout_left> b(2, 3, 4);
+
+    // The index space is traversed in storage order.
+    int it = 0;
+    auto fill_a = [&](Sci::index i, Sci::index j, Sci::index k) { a(i, j, k) = it++; };
+    Sci::for_each_in_extents(fill_a, a.extents(), Kokkos::layout_right{});
+    for (std::size_t n = 0; n < a.size(); ++n) {
+        EXPECT_EQ(a.container_data()[n], static_cast<int>(n));
+    }
+
+    it = 0;
+    auto fill_b = [&](Sci::index i, Sci::index j, Sci::index k) { b(i, j, k) = it++; };
+    Sci::for_each_in_extents(fill_b, b.extents(), Kokkos::layout_left{});
+    for (std::size_t n = 0; n < b.size(); ++n) {
+        EXPECT_EQ(b.container_data()[n], static_cast<int>(n));
+    }
+}
+
+TEST(TestMDArray, TestApplyStrided)
+{
+    using extents_type = Kokkos::dextents<Sci::index, 3>;
+    using mapping_type = Kokkos::layout_stride::mapping<extents_type>;
+
+    // Every second element along the last extent is padding.
+    std::array<Sci::index, 3> strides = {24, 8, 2};
+    mapping_type map(extents_type(2, 3, 4), strides);
+
+    Sci::MDArray<int, extents_type, Kokkos::layout_stride> a(map, 0);
+    EXPECT_FALSE(a.is_exhaustive());
+
+    a += 2;
+    a.apply([](int& x) { x *= 3; });
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            for (Sci::index k = 0; k < a.extent(2); ++k) {
+                EXPECT_EQ(a(i, j, k), 6);
+            }
+        }
+    }
+    for (std::size_t n = 1; n < a.container_size(); n += 2) {
+        EXPECT_EQ(a.container_data()[n], 0);
+    }
+}
+
+TEST(TestMDArray, TestApplyParallel)
+{
+    // Large enough to run on the thread pool.
+    const Sci::index n = 64;
+    Sci::Array3D<double> a(n, n, n);
+    Sci::Array3D<double> b(n, n, n);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a.container_data()[i] = static_cast<double>(i);
+    }
+    b = a;
+
+    a.apply(Sci::par, [](double& x) { x = 2.0 * x + 1.0; });
+    b.apply(Sci::execution::seq, [](double& x) { x = 2.0 * x + 1.0; });
+    EXPECT_TRUE(a == b);
+
+    a.apply(Sci::par_unseq, b, [](double& x, const double& y) { x -= y; });
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a.container_data()[i], 0.0);
+    }
+
+    // Strided views are split into slabs along the first extent.
+    auto a_sub = Kokkos::submdspan(a.to_mdspan(), Kokkos::full_extent, std::pair{1, 63}, 0);
+    auto b_sub = Kokkos::submdspan(b.to_mdspan(), Kokkos::full_extent, std::pair{1, 63}, 0);
+    Sci::apply(Sci::par_unseq, a_sub, b_sub, [](double& x, const double& y) { x = y; });
+    Sci::apply(Sci::par, a_sub, [](double& x) { x += 1.0; });
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            const double ans = (j >= 1 && j < 63) ? b(i, j, 0) + 1.0 : 0.0;
+            EXPECT_EQ(a(i, j, 0), ans);
+        }
+    }
+
+    // Compound operators stay serial; expressions can be assigned in
+    // parallel on request.
+    Sci::Array3D<double> c(n, n, n);
+    c = 1.0;
+    c *= 3.0;
+    c += c;
+    a.assign(Sci::par, 2.0 * c + b);
+    for (std::size_t i = 0; i < c.size(); ++i) {
+        EXPECT_EQ(c.container_data()[i], 6.0);
+        EXPECT_EQ(a.container_data()[i], 12.0 + b.container_data()[i]);
+    }
+}
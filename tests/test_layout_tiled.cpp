@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#if _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4190)
+#endif
+
+#include <array>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+#include <scilib/mdarray.h>
+
+#if _MSC_VER
+#pragma warning(pop)
+#endif
+
+TEST(TestLayoutTiled, TestMapping)
+{
+    using extents_type = Kokkos::dextents<Sci::index, 2>;
+    Sci::layout_tiled<2, 3>::mapping<extents_type> m(extents_type(5, 7));
+
+    EXPECT_EQ(m.required_span_size(), 35);
+    EXPECT_TRUE(m.is_exhaustive());
+
+    // First tile holds rows 0-1 and columns 0-2.
+    EXPECT_EQ(m(0, 0), 0);
+    EXPECT_EQ(m(0, 2), 2);
+    EXPECT_EQ(m(1, 0), 3);
+    EXPECT_EQ(m(1, 2), 5);
+    EXPECT_EQ(m(0, 3), 6);
+    // The tile at the right edge is truncated to one column.
+    EXPECT_EQ(m(0, 6), 12);
+    EXPECT_EQ(m(1, 6), 13);
+    EXPECT_EQ(m(2, 0), 14);
+    // The tiles at the bottom edge are truncated to one row.
+    EXPECT_EQ(m(4, 0), 28);
+    EXPECT_EQ(m(4, 6), 34);
+
+    std::set<Sci::index> offsets;
+    for (Sci::index i = 0; i < 5; ++i) {
+        for (Sci::index j = 0; j < 7; ++j) {
+            offsets.insert(m(i, j));
+        }
+    }
+    EXPECT_EQ(offsets.size(), 35);
+    EXPECT_EQ(*offsets.rbegin(), 34);
+}
+
+TEST(TestLayoutTiled, TestIterationOrder)
+{
+    using extents_type = Kokkos::dextents<Sci::index, 3>;
+    using layout_type = Sci::layout_tiled<2, 2, 4>;
+    layout_type::mapping<extents_type> m(extents_type(3, 5, 6));
+
+    Sci::index k = 0;
+    bool in_order = true;
+    auto f = [&](Sci::index i, Sci::index j, Sci::index l) { in_order &= (m(i, j, l) == k++); };
+    Sci::for_each_in_extents(f, m.extents(), layout_type{});
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(k, 90);
+}
+
+TEST(TestLayoutTiled, TestMDArray)
+{
+    Sci::Matrix<double> a(37, 45);
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            a(i, j) = static_cast<double>(i * 100 + j);
+        }
+    }
+    Sci::TiledMatrix<double, 8, 16> t(a);
+    EXPECT_EQ(t.container_size(), a.size());
+    EXPECT_EQ(Sci::Matrix<double>(t), a);
+
+    Sci::Matrix<double, Sci::layout_left> b(t.to_mdspan());
+    EXPECT_EQ(Sci::Matrix<double>(b), a);
+
+    Sci::Matrix<double> c(a.extent(0), a.extent(1));
+    Sci::copy(t.to_mdspan(), c.to_mdspan());
+    EXPECT_EQ(c, a);
+
+    Sci::TiledMatrix<double, 8, 16> u(a.extent(0), a.extent(1));
+    Sci::copy(a.to_mdspan(), u.to_mdspan());
+    EXPECT_EQ(u, t);
+
+    Sci::TiledMatrix<double, 8, 16> v(t);
+    v += t;
+    v *= 0.5;
+    EXPECT_EQ(v, t);
+}
+
+TEST(TestLayoutTiled, TestSlice)
+{
+    Sci::TiledArray3D<int, 4, 4, 4> a(9, 10, 11);
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            for (Sci::index k = 0; k < a.extent(2); ++k) {
+                a(i, j, k) = static_cast<int>(i * 10000 + j * 100 + k);
+            }
+        }
+    }
+    auto s = Sci::slice(a, std::pair{2, 7}, Kokkos::full_extent, std::pair{3, 10});
+    EXPECT_EQ(s.extent(0), 5);
+    EXPECT_EQ(s.extent(1), 10);
+    EXPECT_EQ(s.extent(2), 7);
+    EXPECT_FALSE(s.is_exhaustive());
+
+    bool ok = true;
+    for (Sci::index i = 0; i < s.extent(0); ++i) {
+        for (Sci::index j = 0; j < s.extent(1); ++j) {
+            for (Sci::index k = 0; k < s.extent(2); ++k) {
+                ok &= (s(i, j, k) == a(i + 2, j, k + 3));
+            }
+        }
+    }
+    EXPECT_TRUE(ok);
+
+    // Slices of slices.
+    auto ss = Sci::slice(s, std::pair{1, 3}, std::pair{4, 9}, std::pair{0, 2});
+    EXPECT_EQ(ss(1, 2, 1), a(4, 6, 4));
+
+    Sci::Array3D<int> b(s);
+    EXPECT_EQ(b(4, 9, 6), a(6, 9, 9));
+
+    Sci::apply(s, [](int& x) { x = -1; });
+    EXPECT_EQ(a(2, 0, 3), -1);
+    EXPECT_EQ(a(6, 9, 9), -1);
+    EXPECT_EQ(a(1, 0, 3), 100 * 0 + 10000 + 3);
+    EXPECT_EQ(a(2, 0, 2), 20002);
+}
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <scilib/linalg.h>
 #include <scilib/mdarray.h>
+#include <array>
 #include <vector>
 
 #if _MSC_VER
@@ -42,6 +43,85 @@ TEST(TestLinalg, TestSumProd)
     EXPECT_EQ(Sci::Linalg::prod(v), 24);
 }
 
+TEST(TestLinalg, TestReductionsRank2)
+{
+    Sci::Matrix<int> a(Kokkos::dextents<Sci::index, 2>(2, 3), {4, 1, 9, 9, -2, 3});
+    Sci::Matrix<int, Kokkos::layout_left> b(a.to_mdspan());
+
+    EXPECT_EQ(Sci::Linalg::sum(a), 24);
+    EXPECT_EQ(Sci::Linalg::max(b), 9);
+    EXPECT_EQ(Sci::Linalg::min(b), -2);
+
+    // Indices into the row-major flattened array, also for layout_left.
+    EXPECT_EQ(Sci::Linalg::argmax(a), 2UL);
+    EXPECT_EQ(Sci::Linalg::argmax(b), 2UL);
+    EXPECT_EQ(Sci::Linalg::argmin(b), 4UL);
+    EXPECT_EQ(Sci::Linalg::argmax(Sci::column(a.to_mdspan(), 0)), 1UL);
+}
+
+TEST(TestLinalg, TestReductionsLarge)
+{
+    // Large enough to run on the thread pool on request.
+    const std::size_t n = 1000003;
+    Sci::Vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v(i) = static_cast<double>((i * 7919) % 1000);
+    }
+    v(123457) = 1000.0;
+    v(876543) = 1000.0;
+    v(500000) = -1.0;
+
+    double ans = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        ans += v(i);
+    }
+    EXPECT_EQ(Sci::Linalg::sum(v), ans);
+    EXPECT_EQ(Sci::Linalg::sum(Sci::par, v), ans);
+    EXPECT_EQ(Sci::Linalg::max(Sci::par, v), 1000.0);
+    EXPECT_EQ(Sci::Linalg::min(Sci::par_unseq, v), -1.0);
+    EXPECT_EQ(Sci::Linalg::argmax(Sci::par, v), 123457UL);
+    EXPECT_EQ(Sci::Linalg::argmin(Sci::par, v), 500000UL);
+    EXPECT_EQ(Sci::Linalg::argmax(v), 123457UL);
+    EXPECT_EQ(Sci::Linalg::argmin(v), 500000UL);
+
+    Sci::Vector<double> w(n);
+    w = 1.0;
+    w(17) = 2.0;
+    w(n - 1) = 0.5;
+    EXPECT_EQ(Sci::Linalg::prod(w), 1.0);
+    EXPECT_EQ(Sci::Linalg::prod(Sci::par, w), 1.0);
+}
+
+TEST(TestLinalg, TestReductionsSerial)
+{
+    // Without a policy the sum is accumulated serially in reduce_lanes
+    // interleaved partial sums, independent of the size of the thread pool.
+    const std::size_t n = 1000003;
+    Sci::Vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v(i) = 1.0 / static_cast<double>(i + 1);
+    }
+    constexpr std::size_t lanes = Sci::__Detail::reduce_lanes;
+    std::array<double, lanes> acc{};
+    std::size_t k = 0;
+    for (; k + lanes <= n; k += lanes) {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            acc[l] += v(k + l);
+        }
+    }
+    for (; k < n; ++k) {
+        acc[0] += v(k);
+    }
+    for (std::size_t w = lanes / 2; w > 0; w /= 2) {
+        for (std::size_t l = 0; l < w; ++l) {
+            acc[l] += acc[l + w];
+        }
+    }
+    EXPECT_EQ(Sci::Linalg::sum(v), acc[0]);
+    EXPECT_EQ(Sci::Linalg::sum(Sci::execution::seq, v), acc[0]);
+    EXPECT_NEAR(Sci::Linalg::sum(Sci::par, v), acc[0], 1.0e-12);
+}
+
 TEST(TestLinalg, TestZerosMatrix)
 {
     auto m = Sci::Linalg::zeros<Sci::Matrix<int>>(2, 2);
@@ -52,6 +132,27 @@ TEST(TestLinalg, TestZerosMatrix)
    }
 }
 
+TEST(TestLinalg, TestZerosZeroPageMatrix)
+{
+    using Zero_page_matrix = Sci::MDArray<double,
+                                          Kokkos::dextents<Sci::index, 2>,
+                                          Kokkos::layout_right,
+                                          Sci::Zero_page_container<double>>;
+
+    auto m = Sci::Linalg::zeros<Zero_page_matrix>(300, 200);
+    for (Sci::index i = 0; i < m.extent(0); ++i) {
+        for (Sci::index j = 0; j < m.extent(1); ++j) {
+            EXPECT_EQ(m(i, j), 0.0);
+        }
+    }
+    auto e = Sci::Linalg::identity<Zero_page_matrix>(4);
+    for (Sci::index i = 0; i < e.extent(0); ++i) {
+        for (Sci::index j = 0; j < e.extent(1); ++j) {
+            EXPECT_EQ(e(i, j), i == j ? 1.0 : 0.0);
+        }
+    }
+}
+
 TEST(TestLinalg, TestOnesMatrix)
 {
     auto m = Sci::Linalg::ones<Sci::Matrix<int>>(2, 2);
@@ -0,0 +1,185 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+// Run every batch on a thread pool of several threads, regardless of its size
+// and of the number of cores, so that the per-chunk workspaces and concurrent
+// LAPACK calls are exercised.
+#define SCILIB_PARALLEL_THRESHOLD 1
+#define SCILIB_NUM_THREADS 4
+
+#if _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4190)
+#endif
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <scilib/mdarray.h>
+#include <scilib/linalg.h>
+
+#if _MSC_VER
+#pragma warning(pop)
+#endif
+
+namespace {
+
+// Batch of symmetric positive definite matrices a(q) = m(q) * m(q)' + n * I.
+template <class Layout>
+Sci::Array3D<double, Layout> spd_batch(Sci::index nbatch, Sci::index n)
+{
+    Sci::Array3D<double, Layout> a(nbatch, n, n);
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        for (Sci::index i = 0; i < n; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                double s = (i == j) ? static_cast<double>(n) : 0.0;
+                for (Sci::index k = 0; k < n; ++k) {
+                    s += std::sin(static_cast<double>(q + 3 * i + 7 * k)) *
+                         std::sin(static_cast<double>(q + 3 * j + 7 * k));
+                }
+                a(q, i, j) = s;
+            }
+        }
+    }
+    return a;
+}
+
+} // namespace
+
+TEST(TestLinalg, TestBatchedEigh)
+{
+    const Sci::index nbatch = 40;
+    const Sci::index n = 7;
+
+    auto a = spd_batch<Kokkos::layout_right>(nbatch, n);
+    auto v = a;
+    Sci::Matrix<double> w(nbatch, n);
+    auto info = Sci::Linalg::batched_eigh(v, w);
+
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        EXPECT_EQ(info(q), 0);
+
+        Sci::Matrix<double> aq(Sci::slice(a.to_mdspan(), q, Kokkos::full_extent, Kokkos::full_extent));
+        Sci::Vector<double> wq(n);
+        Sci::Linalg::eigh(aq, wq);
+
+        bool ok = true;
+        for (Sci::index i = 0; i < n; ++i) {
+            ok &= std::abs(w(q, i) - wq(i)) < 1.0e-10;
+            // a * v(:, i) = w(i) * v(:, i)
+            for (Sci::index k = 0; k < n; ++k) {
+                double s = 0.0;
+                for (Sci::index j = 0; j < n; ++j) {
+                    s += a(q, k, j) * v(q, j, i);
+                }
+                ok &= std::abs(s - w(q, i) * v(q, k, i)) < 1.0e-10;
+            }
+        }
+        EXPECT_TRUE(ok);
+    }
+}
+
+TEST(TestLinalg, TestBatchedSolve)
+{
+    const Sci::index nbatch = 30;
+    const Sci::index n = 6;
+    const Sci::index nrhs = 2;
+
+    auto a = spd_batch<Kokkos::layout_left>(nbatch, n);
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        a(q, 0, n - 1) += 1.0; // make the matrices non-symmetric
+    }
+    Sci::Array3D<double, Kokkos::layout_left> b(nbatch, n, nrhs);
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        for (Sci::index i = 0; i < n; ++i) {
+            b(q, i, 0) = static_cast<double>(i + 1);
+            b(q, i, 1) = static_cast<double>(q - i);
+        }
+    }
+    auto lu = a;
+    auto x = b;
+    auto info = Sci::Linalg::batched_solve(lu, x);
+
+    bool ok = true;
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        ok &= (info(q) == 0);
+        for (Sci::index r = 0; r < nrhs; ++r) {
+            for (Sci::index i = 0; i < n; ++i) {
+                double s = 0.0;
+                for (Sci::index j = 0; j < n; ++j) {
+                    s += a(q, i, j) * x(q, j, r);
+                }
+                ok &= std::abs(s - b(q, i, r)) < 1.0e-10;
+            }
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(TestLinalg, TestBatchedCholesky)
+{
+    const Sci::index nbatch = 20;
+    const Sci::index n = 5;
+
+    auto a = spd_batch<Kokkos::layout_right>(nbatch, n);
+    a(3, 2, 2) = -1.0; // not positive definite
+
+    auto l = a;
+    auto info = Sci::Linalg::batched_cholesky(l);
+
+    bool ok = true;
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        if (q == 3) {
+            EXPECT_GT(info(q), 0);
+            continue;
+        }
+        ok &= (info(q) == 0);
+        for (Sci::index i = 0; i < n; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                double s = 0.0;
+                for (Sci::index k = 0; k < n; ++k) {
+                    s += l(q, i, k) * l(q, j, k);
+                }
+                ok &= std::abs(s - a(q, i, j)) < 1.0e-10;
+                if (j > i) {
+                    ok &= (l(q, i, j) == 0.0);
+                }
+            }
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(TestLinalg, TestBatchedInv)
+{
+    const Sci::index nbatch = 25;
+    const Sci::index n = 6;
+
+    auto a = spd_batch<Kokkos::layout_right>(nbatch, n);
+    for (Sci::index j = 0; j < n; ++j) {
+        a(5, 1, j) = 0.0; // singular
+    }
+    Sci::Array3D<double> res(nbatch, n, n);
+    auto info = Sci::Linalg::batched_inv(a, res);
+
+    bool ok = true;
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        if (q == 5) {
+            EXPECT_GT(info(q), 0);
+            continue;
+        }
+        ok &= (info(q) == 0);
+        for (Sci::index i = 0; i < n; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                double s = 0.0;
+                for (Sci::index k = 0; k < n; ++k) {
+                    s += a(q, i, k) * res(q, k, j);
+                }
+                ok &= std::abs(s - (i == j ? 1.0 : 0.0)) < 1.0e-10;
+            }
+        }
+    }
+    EXPECT_TRUE(ok);
+}
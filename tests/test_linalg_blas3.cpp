@@ -107,3 +107,125 @@ TEST(TestLinalg, TestMatrixMatrixProductComplex)
 
     EXPECT_EQ(ans, res);
 }
+
+TEST(TestLinalg, TestMatrixMatrixProductStatic)
+{
+    using extents_a = Kokkos::extents<Sci::index, 2, 3>;
+    using extents_b = Kokkos::extents<Sci::index, 3, 2>;
+
+    constexpr Sci::StaticMatrix<double, 2, 3> ma(extents_a(), {1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+    constexpr Sci::StaticMatrix<double, 3, 2> mb(extents_b(), {7.0, 8.0, 9.0, 10.0, 11.0, 12.0});
+
+    constexpr auto res = ma * mb;
+    static_assert(res.extent(0) == 2 && res.extent(1) == 2);
+    static_assert(res(0, 0) == 58.0 && res(0, 1) == 64.0);
+    static_assert(res(1, 0) == 139.0 && res(1, 1) == 154.0);
+
+    // Same result as the BLAS path.
+    Sci::Matrix<double> ans =
+        Sci::Matrix<double>(ma.to_mdspan()) * Sci::Matrix<double>(mb.to_mdspan());
+    EXPECT_EQ(Sci::Matrix<double>(res.to_mdspan()), ans);
+
+    // The product may overwrite an operand.
+    Sci::StaticMatrix<double, 3, 3, Kokkos::layout_left> c(Kokkos::extents<Sci::index, 3, 3>(),
+                                                           {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0,
+                                                            8.0, 9.0});
+    Sci::Matrix<double, Kokkos::layout_left> c2(c.to_mdspan());
+    Sci::Linalg::matrix_product(c, c, c);
+    Sci::Matrix<double, Kokkos::layout_left> c3(c.to_mdspan());
+    EXPECT_EQ(c3, c2 * c2);
+
+    constexpr Sci::StaticVector<double, 3> x(Kokkos::extents<Sci::index, 3>(), {1.0, -1.0, 2.0});
+    constexpr auto y = ma * x;
+    static_assert(y(0) == 5.0 && y(1) == 11.0);
+}
+
+TEST(TestLinalg, TestBatchedMatrixProduct)
+{
+    // Large enough for all three forms to run on the thread pool.
+    const Sci::index nbatch = 600;
+    const Sci::index m = 13;
+    const Sci::index p = 9;
+    const Sci::index n = 11;
+
+    Sci::Array3D<double> a(nbatch, m, p);
+    Sci::Array3D<double> b(nbatch, p, n);
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        for (Sci::index i = 0; i < m; ++i) {
+            for (Sci::index k = 0; k < p; ++k) {
+                a(q, i, k) = static_cast<double>((q + 2 * i + 3 * k) % 7) - 3.0;
+            }
+        }
+        for (Sci::index k = 0; k < p; ++k) {
+            for (Sci::index j = 0; j < n; ++j) {
+                b(q, k, j) = static_cast<double>((3 * q + k + 5 * j) % 5) - 2.0;
+            }
+        }
+    }
+    auto c = Sci::Linalg::batched_matrix_product(a, b);
+
+    Sci::Array3D<double, Kokkos::layout_left> al(a.to_mdspan());
+    Sci::Array3D<double, Kokkos::layout_left> bl(b.to_mdspan());
+    Sci::Array3D<double, Kokkos::layout_left> cl(nbatch, m, n);
+    Sci::Linalg::batched_matrix_product(al, bl, cl);
+
+    // Pointer-array form with column-major matrices of different sizes.
+    using matrix_view =
+        Kokkos::mdspan<double, Kokkos::dextents<Sci::index, 2>, Kokkos::layout_left>;
+    std::vector<Sci::Matrix<double, Kokkos::layout_left>> as;
+    std::vector<Sci::Matrix<double, Kokkos::layout_left>> bs;
+    std::vector<Sci::Matrix<double, Kokkos::layout_left>> cs;
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        const Sci::index mq = 1 + q % m;
+        as.emplace_back(Sci::slice(a.to_mdspan(), q, std::pair{0, mq}, Kokkos::full_extent));
+        bs.emplace_back(Sci::slice(b.to_mdspan(), q, Kokkos::full_extent, Kokkos::full_extent));
+        cs.emplace_back(mq, n);
+    }
+    std::vector<matrix_view> av;
+    std::vector<matrix_view> bv;
+    std::vector<matrix_view> cv;
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        av.push_back(as[q].to_mdspan());
+        bv.push_back(bs[q].to_mdspan());
+        cv.push_back(cs[q].to_mdspan());
+    }
+    Sci::Linalg::batched_matrix_product(av, bv, cv);
+
+    for (Sci::index q = 0; q < nbatch; ++q) {
+        auto all = Kokkos::full_extent;
+        Sci::Matrix<double> aq(Sci::slice(a.to_mdspan(), q, all, all));
+        Sci::Matrix<double> bq(Sci::slice(b.to_mdspan(), q, all, all));
+        Sci::Matrix<double> ans = aq * bq;
+        bool ok = true;
+        for (Sci::index i = 0; i < m; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                ok &= (c(q, i, j) == ans(i, j));
+                ok &= (cl(q, i, j) == ans(i, j));
+                if (i < cs[q].extent(0)) {
+                    ok &= (cs[q](i, j) == ans(i, j));
+                }
+            }
+        }
+        EXPECT_TRUE(ok);
+    }
+
+    // Strided views without a contiguous dimension, which are packed.
+    Sci::Matrix<int> x(6, 6);
+    for (Sci::index i = 0; i < 6; ++i) {
+        for (Sci::index j = 0; j < 6; ++j) {
+            x(i, j) = static_cast<int>(i * 6 + j);
+        }
+    }
+    using extents_type = Kokkos::dextents<Sci::index, 2>;
+    using strided_view = Kokkos::mdspan<int, extents_type, Kokkos::layout_stride>;
+    using mapping_type = strided_view::mapping_type;
+    const std::array<Sci::index, 2> strides = {12, 2};
+    std::array<strided_view, 1> xa = {
+        strided_view(x.container_data(), mapping_type(extents_type(2, 3), strides))};
+    std::array<strided_view, 1> xb = {
+        strided_view(x.container_data(), mapping_type(extents_type(3, 2), strides))};
+    Sci::Matrix<int> y(2, 2);
+    std::array<decltype(y.to_mdspan()), 1> ya = {y.to_mdspan()};
+    Sci::Linalg::batched_matrix_product(xa, xb, ya);
+    EXPECT_EQ(y(1, 1), 12 * 2 + 14 * 14 + 16 * 26);
+}
@@ -10,6 +10,7 @@
 #endif
 
 #include <cmath>
+#include <array>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -58,6 +59,80 @@ TEST(TestLinalg, TestEighReal)
     }
 }
 
+TEST(TestLinalg, TestEighSubset)
+{
+    using namespace Sci::Linalg;
+
+    // Intel MKL example, as above:
+    // clang-format off
+    std::vector<double> eval = {
+         0.4330218, 2.14494666, 3.36808674, 4.27915302, 6.93479178
+    };
+    std::vector<double> evec_data = {
+       -0.9796240, -0.0146276, -0.0817668, -0.0124140,  0.182435,
+        0.0109926,  0.0209833, -0.9338050,  0.0257257, -0.356068,
+        0.0444859, -0.6927900, -0.0735199, -0.7086760,  0.102155,
+       -0.1810480,  0.1934840,  0.3129500, -0.3541350, -0.840498,
+        0.0738794,  0.6942270, -0.1340860, -0.6095500,  0.350800 
+    };
+    std::vector<double> a_data = {
+        0.67, -0.20,  0.19, -1.06,  0.46,
+       -0.20,  3.82, -0.13,  1.06, -0.48,
+        0.19, -0.13,  3.27,  0.11,  1.10,
+       -1.06,  1.06,  0.11,  5.86, -0.98,
+        0.46, -0.48,  1.10, -0.98,  3.54
+    };
+    // clang-format on
+    Sci::Matrix<double> evec(Kokkos::dextents<Sci::index, 2>(5, 5), evec_data);
+    Sci::Matrix<double> a(Kokkos::dextents<Sci::index, 2>(5, 5), a_data);
+
+    for (auto driver : {Eigh_driver::evr, Eigh_driver::evd, Eigh_driver::evr_2stage}) {
+        auto w = eigvalsh(a, Eigh_subset::all(), 'U', driver);
+        EXPECT_EQ(w.size(), 5);
+        for (Sci::index i = 0; i < w.extent(0); ++i) {
+            EXPECT_NEAR(w(i), eval[i], 1.0e-6);
+        }
+    }
+    auto w_idx = eigvalsh(a, Eigh_subset::by_index(1, 2));
+    EXPECT_EQ(w_idx.size(), 2);
+    EXPECT_NEAR(w_idx(0), eval[1], 1.0e-6);
+    EXPECT_NEAR(w_idx(1), eval[2], 1.0e-6);
+
+    auto w_val = eigvalsh(a, Eigh_subset::by_value(2.0, 4.0), 'L', Eigh_driver::evr_2stage);
+    EXPECT_EQ(w_val.size(), 2);
+    EXPECT_NEAR(w_val(0), eval[1], 1.0e-6);
+    EXPECT_NEAR(w_val(1), eval[2], 1.0e-6);
+
+    // Lowest two eigenpairs written into z.
+    Sci::Matrix<double> a_copy = a;
+    Sci::Vector<double> w(5);
+    Sci::Matrix<double> z(5, 2);
+    EXPECT_EQ(eigh(a_copy, w, z, Eigh_subset::by_index(0, 1)), 2);
+    for (Sci::index i = 0; i < 5; ++i) {
+        for (Sci::index j = 0; j < 2; ++j) {
+            EXPECT_NEAR(std::abs(z(i, j)), std::abs(evec(i, j)), 1.0e-6);
+        }
+    }
+
+    // Full decomposition by divide and conquer, column-major.
+    Sci::Matrix<double, Kokkos::layout_left> al(a.to_mdspan());
+    Sci::Vector<double, Kokkos::layout_left> wl(5);
+    Sci::Matrix<double, Kokkos::layout_left> zl(5, 5);
+    EXPECT_EQ(eigh(al, wl, zl, Eigh_subset::all(), 'U', Eigh_driver::evd), 5);
+    for (Sci::index i = 0; i < 5; ++i) {
+        EXPECT_NEAR(wl(i), eval[i], 1.0e-6);
+        for (Sci::index j = 0; j < 5; ++j) {
+            EXPECT_NEAR(std::abs(zl(i, j)), std::abs(evec(i, j)), 1.0e-6);
+        }
+    }
+
+    a_copy = a;
+    EXPECT_THROW(eigh(a_copy, w, z, Eigh_subset::by_index(0, 1), 'U', Eigh_driver::evd),
+                 std::runtime_error);
+    EXPECT_THROW(eigh(a_copy, w, z, Eigh_subset::by_index(0, 1), 'U', Eigh_driver::evr_2stage),
+                 std::runtime_error);
+}
+
 TEST(TestLinalg, TestEighComplex)
 {
     // Intel MKL example:
@@ -194,3 +269,90 @@ TEST(TestLinalg, TestEigColMajor)
         }
     }
 }
+
+TEST(TestLinalg, TestEighStatic)
+{
+    using namespace Sci;
+
+    // Inertia tensors: general, with a repeated eigenvalue, and diagonal.
+    // clang-format off
+    std::array<std::array<double, 9>, 4> data = {{
+        { 4.0,  1.0, -2.0,
+          1.0,  2.0,  0.5,
+         -2.0,  0.5,  3.0},
+        { 2.0, -1.0, -1.0,
+         -1.0,  2.0, -1.0,
+         -1.0, -1.0,  2.0},
+        { 1.0e-3, 0.0, 0.0,
+          0.0,    5.0, 0.0,
+          0.0,    0.0, 5.0},
+        { 0.0, 0.0, 0.0,
+          0.0, 0.0, 0.0,
+          0.0, 0.0, 0.0}
+    }};
+    // clang-format on
+    for (const auto& d : data) {
+        StaticMatrix<double, 3, 3> a(Kokkos::extents<Sci::index, 3, 3>(), d);
+        StaticVector<double, 3> w(3);
+        Linalg::eigh(a, w);
+
+        Matrix<double> a2(Kokkos::dextents<Sci::index, 2>(3, 3),
+                          std::vector<double>(d.begin(), d.end()));
+        Vector<double> w2(3);
+        Linalg::eigh(a2, w2);
+
+        for (Sci::index k = 0; k < 3; ++k) {
+            EXPECT_NEAR(w(k), w2(k), 1.0e-12);
+            if (k > 0) {
+                EXPECT_LE(w(k - 1), w(k));
+            }
+            // a * v = w * v and the eigenvectors are orthonormal.
+            for (Sci::index i = 0; i < 3; ++i) {
+                double av = 0.0;
+                for (Sci::index j = 0; j < 3; ++j) {
+                    av += d[i * 3 + j] * a(j, k);
+                }
+                EXPECT_NEAR(av, w(k) * a(i, k), 1.0e-12);
+            }
+            for (Sci::index l = 0; l < 3; ++l) {
+                double vv = 0.0;
+                for (Sci::index i = 0; i < 3; ++i) {
+                    vv += a(i, k) * a(i, l);
+                }
+                EXPECT_NEAR(vv, (k == l) ? 1.0 : 0.0, 1.0e-12);
+            }
+        }
+    }
+
+    // Symmetric top: q * diag(lambda) * q' with a nearly repeated eigenvalue,
+    // where q is the reflection through the plane normal to (1, 2, 2).
+    // clang-format off
+    const std::array<double, 9> q = {
+         7.0 / 9.0, -4.0 / 9.0, -4.0 / 9.0,
+        -4.0 / 9.0,  1.0 / 9.0, -8.0 / 9.0,
+        -4.0 / 9.0, -8.0 / 9.0,  1.0 / 9.0};
+    // clang-format on
+    const std::array<double, 3> lambda = {2.0, 2.0 + 5.0e-6, 5.0};
+    StaticMatrix<double, 3, 3> t(Kokkos::extents<Sci::index, 3, 3>{});
+    for (Sci::index i = 0; i < 3; ++i) {
+        for (Sci::index j = 0; j < 3; ++j) {
+            t(i, j) = 0.0;
+            for (Sci::index k = 0; k < 3; ++k) {
+                t(i, j) += q[i * 3 + k] * lambda[k] * q[j * 3 + k];
+            }
+        }
+    }
+    StaticMatrix<double, 3, 3> z = t;
+    StaticVector<double, 3> w(3);
+    Linalg::eigh(z, w);
+    for (Sci::index k = 0; k < 3; ++k) {
+        EXPECT_NEAR(w(k), lambda[k], 1.0e-13);
+        for (Sci::index i = 0; i < 3; ++i) {
+            double tz = 0.0;
+            for (Sci::index j = 0; j < 3; ++j) {
+                tz += t(i, j) * z(j, k);
+            }
+            EXPECT_NEAR(tz, w(k) * z(i, k), 1.0e-13);
+        }
+    }
+}
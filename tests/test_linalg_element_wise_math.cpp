@@ -9,6 +9,11 @@
 #pragma warning(disable : 4190)
 #endif
 
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -28,3 +33,152 @@ TEST(TestLinalg, TestElementWisePow)
         EXPECT_EQ(res(i), ans(i));
     }
 }
+
+namespace {
+
+// Distance in units in the last place between two finite doubles.
+std::int64_t ulp_distance(double a, double b)
+{
+    auto ordered = [](double x) {
+        const auto i = std::bit_cast<std::int64_t>(x);
+        return (i < 0) ? std::numeric_limits<std::int64_t>::min() - i : i;
+    };
+    const auto d = ordered(a) - ordered(b);
+    return (d < 0) ? -d : d;
+}
+
+} // namespace
+
+TEST(TestLinalg, TestElementWiseStrict)
+{
+    Sci::Matrix<double> a(3, 4);
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            a(i, j) = 0.25 * static_cast<double>(i * a.extent(1) + j) + 0.1;
+        }
+    }
+    auto e = Sci::Linalg::exp(a);
+    auto s = Sci::Linalg::sin(Sci::Linalg::strict_math, a);
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            EXPECT_EQ(e(i, j), std::exp(a(i, j)));
+            EXPECT_EQ(s(i, j), std::sin(a(i, j)));
+        }
+    }
+
+    Sci::Matrix<double, Kokkos::layout_left> b(a.to_mdspan());
+    auto l = Sci::Linalg::log(b);
+    for (Sci::index i = 0; i < b.extent(0); ++i) {
+        for (Sci::index j = 0; j < b.extent(1); ++j) {
+            EXPECT_EQ(l(i, j), std::log(a(i, j)));
+        }
+    }
+}
+
+TEST(TestLinalg, TestElementWiseFast)
+{
+    using Sci::Linalg::fast_math;
+
+    const std::size_t n = 100000;
+    std::mt19937_64 gen(42);
+
+    auto check = [&](auto fast_fn, double (*std_fn)(double), double lo, double hi, bool log2) {
+        std::uniform_real_distribution<double> dist(lo, hi);
+        Sci::Vector<double> x(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            x(i) = log2 ? std::exp2(dist(gen)) : dist(gen);
+        }
+        auto y = fast_fn(x);
+        std::int64_t max_ulp = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            max_ulp = std::max(max_ulp, ulp_distance(y(i), std_fn(x(i))));
+        }
+        EXPECT_LE(max_ulp, 2);
+    };
+
+    auto fast_exp = [](const auto& x) { return Sci::Linalg::exp(fast_math, x); };
+    auto fast_log = [](const auto& x) { return Sci::Linalg::log(fast_math, x); };
+    auto fast_log2 = [](const auto& x) { return Sci::Linalg::log2(fast_math, x); };
+    auto fast_log10 = [](const auto& x) { return Sci::Linalg::log10(fast_math, x); };
+    auto fast_sin = [](const auto& x) { return Sci::Linalg::sin(fast_math, x); };
+    auto fast_cos = [](const auto& x) { return Sci::Linalg::cos(fast_math, x); };
+
+    check(fast_exp, std::exp, -745.0, 709.7, false);
+    check(fast_exp, std::exp, -1.0, 1.0, false);
+    check(fast_log, std::log, -1074.0, 1023.0, true);
+    check(fast_log, std::log, 0.5, 2.0, false);
+    check(fast_log2, std::log2, -1074.0, 1023.0, true);
+    check(fast_log10, std::log10, -1074.0, 1023.0, true);
+    check(fast_sin, std::sin, -10.0, 10.0, false);
+    check(fast_sin, std::sin, -1.0e5, 1.0e5, false);
+    check(fast_cos, std::cos, -1.0e5, 1.0e5, false);
+    check(fast_sin, std::sin, -1.0e10, 1.0e10, false);
+
+    // Special values.
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    Sci::Vector<double> x(Kokkos::dextents<Sci::index, 1>(6), {0.0, -1.0, inf, -inf, nan, 1.0});
+
+    auto ex = fast_exp(x);
+    EXPECT_EQ(ex(0), 1.0);
+    EXPECT_EQ(ex(2), inf);
+    EXPECT_EQ(ex(3), 0.0);
+    EXPECT_TRUE(std::isnan(ex(4)));
+
+    auto lx = fast_log(x);
+    EXPECT_EQ(lx(0), -inf);
+    EXPECT_TRUE(std::isnan(lx(1)));
+    EXPECT_EQ(lx(2), inf);
+    EXPECT_TRUE(std::isnan(lx(3)));
+    EXPECT_TRUE(std::isnan(lx(4)));
+    EXPECT_EQ(lx(5), 0.0);
+
+    auto sx = fast_sin(x);
+    EXPECT_EQ(sx(0), 0.0);
+    EXPECT_TRUE(std::isnan(sx(2)));
+    EXPECT_TRUE(std::isnan(sx(4)));
+
+    // Single precision and in-place evaluation of strided views.
+    Sci::Vector<float> xf(Kokkos::dextents<Sci::index, 1>(3), {0.5f, 1.0f, 2.0f});
+    auto ef = Sci::Linalg::exp(fast_math, xf);
+    for (Sci::index i = 0; i < xf.extent(0); ++i) {
+        EXPECT_FLOAT_EQ(ef(i), std::exp(xf(i)));
+    }
+    using extents_type = Kokkos::dextents<Sci::index, 1>;
+    Kokkos::layout_stride::mapping<extents_type> map(extents_type(3), std::array<Sci::index, 1>{2});
+    Sci::MDArray<double, extents_type, Kokkos::layout_stride> xs(map);
+    xs(0) = 0.5;
+    xs(1) = 1.0;
+    xs(2) = 2.0;
+    auto cs = Sci::Linalg::cos(fast_math, xs);
+    for (Sci::index i = 0; i < xs.extent(0); ++i) {
+        EXPECT_LE(ulp_distance(cs(i), std::cos(xs(i))), 2);
+    }
+}
+
+TEST(TestLinalg, TestElementWiseParallel)
+{
+    using Sci::Linalg::fast_math;
+
+    const Sci::index n = 1 << 18;
+    Sci::Vector<double> x(n);
+    for (Sci::index i = 0; i < n; ++i) {
+        x(i) = 1.0e-4 * static_cast<double>(i) - 10.0;
+    }
+    auto e = Sci::Linalg::exp(x);
+    auto ep = Sci::Linalg::exp(Sci::par, x);
+    auto ef = Sci::Linalg::exp(fast_math, x);
+    auto efp = Sci::Linalg::exp(Sci::par, fast_math, x);
+    auto sp = Sci::Linalg::sqrt(Sci::par_unseq, Sci::Linalg::abs(x));
+    for (Sci::index i = 0; i < n; ++i) {
+        EXPECT_EQ(ep(i), e(i));
+        EXPECT_EQ(efp(i), ef(i));
+        EXPECT_EQ(sp(i), std::sqrt(std::abs(x(i))));
+    }
+
+    // Expression operands are evaluated first.
+    auto es = Sci::Linalg::exp(x - x);
+    auto esf = Sci::Linalg::exp(fast_math, x - x);
+    EXPECT_EQ(es(0), 1.0);
+    EXPECT_EQ(esf(n - 1), 1.0);
+}
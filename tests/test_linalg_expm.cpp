@@ -10,6 +10,7 @@
 #endif
 
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -78,3 +79,79 @@ TEST(TestLinalg, TestExpmColMajor)
         }
     }
 }
+
+TEST(TestLinalg, TestExpmPadeDegrees)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    // exp([0 t; -t 0]) = [cos(t) sin(t); -sin(t) cos(t)], with the 1-norm t
+    // selecting each of the Pade degrees, with and without squaring.
+    for (double t : {0.01, 0.2, 0.9, 2.0, 5.0, 50.0}) {
+        Matrix<double> a = {{0.0, t}, {-t, 0.0}};
+        auto res = expm(a);
+        EXPECT_NEAR(res(0, 0), std::cos(t), 1.0e-12);
+        EXPECT_NEAR(res(0, 1), std::sin(t), 1.0e-12);
+        EXPECT_NEAR(res(1, 0), -std::sin(t), 1.0e-12);
+        EXPECT_NEAR(res(1, 1), std::cos(t), 1.0e-12);
+    }
+
+    // exp(A) * exp(-A) = I for a non-normal matrix.
+    const Sci::index n = 30;
+    Matrix<double> a(n, n);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = (j >= i) ? std::sin(static_cast<double>(3 * i + j)) : 0.0;
+        }
+    }
+    Matrix<double> b = -1.0 * a;
+    auto ab = expm(a) * expm(b);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            EXPECT_NEAR(ab(i, j), (i == j) ? 1.0 : 0.0, 1.0e-10);
+        }
+    }
+
+    // Non-finite elements have no scaling exponent.
+    for (double x : {HUGE_VAL, NAN}) {
+        Matrix<double> c = {{1.0, x}, {0.0, 1.0}};
+        EXPECT_THROW(expm(c), std::runtime_error);
+    }
+}
+
+TEST(TestLinalg, TestExpmMultiply)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    const Sci::index n = 40;
+    Matrix<double> a(n, n);
+    Vector<double> v(n);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = 0.3 * std::sin(static_cast<double>(2 * i + 5 * j + 1));
+        }
+        a(i, i) -= 2.0;
+        v(i) = std::cos(static_cast<double>(i));
+    }
+
+    for (double t : {0.0, 0.1, 1.0, 7.5, -0.5}) {
+        Matrix<double> ta = t * a;
+        auto ans = expm(ta) * v;
+        auto res = expm_multiply(a, v, t);
+        for (Sci::index i = 0; i < n; ++i) {
+            EXPECT_NEAR(res(i), ans(i), 1.0e-12 * (1.0 + std::abs(ans(i))));
+        }
+    }
+
+    std::vector<double> times = {0.0, 0.25, 0.5, 2.0, 3.0};
+    auto res = expm_multiply(a, v, times);
+    EXPECT_EQ(res.extent(0), static_cast<Sci::index>(times.size()));
+    for (std::size_t k = 0; k < times.size(); ++k) {
+        Matrix<double> ta = times[k] * a;
+        auto ans = expm(ta) * v;
+        for (Sci::index i = 0; i < n; ++i) {
+            EXPECT_NEAR(res(k, i), ans(i), 1.0e-12 * (1.0 + std::abs(ans(i))));
+        }
+    }
+}
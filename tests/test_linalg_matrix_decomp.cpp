@@ -90,6 +90,89 @@ TEST(TestLinalg, TestLU)
     }
 }
 
+TEST(TestLinalg, TestLUFactorization)
+{
+    using namespace Sci::Linalg;
+
+    Sci::Matrix<double> a = {
+        {2.0, 5.0, 8.0, 7.0}, {5.0, 2.0, 2.0, 8.0}, {7.0, 5.0, 6.0, 6.0}, {5.0, 4.0, 4.0, 8.0}};
+    const auto n = a.extent(0);
+
+    LU f(a);
+    EXPECT_FALSE(f.singular());
+    EXPECT_EQ(f.size(), n);
+    EXPECT_NEAR(f.det(), det(a), 1.0e-10);
+
+    auto ainv = inv(a);
+    auto finv = f.inverse();
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            EXPECT_NEAR(finv(i, j), ainv(i, j), 1.0e-12);
+        }
+    }
+    const double rcond = 1.0 / (matrix_norm(a, '1') * matrix_norm(ainv, '1'));
+    EXPECT_NEAR(f.rcond(), rcond, 0.1 * rcond);
+
+    // Vector, row-major, column-major and strided right-hand sides.
+    Sci::Vector<double> x = {1.0, -2.0, 3.0, 0.5};
+    Sci::Matrix<double> xr = {{1.0, 2.0}, {-2.0, 0.0}, {3.0, 1.0}, {0.5, -1.0}};
+    Sci::Matrix<double, Kokkos::layout_left> xl(xr.to_mdspan());
+
+    auto b = a * x;
+    auto br = a * xr;
+    Sci::Matrix<double, Kokkos::layout_left> bl(br.to_mdspan());
+    auto bt = Sci::Linalg::transposed(a) * x;
+
+    f.solve(b);
+    f.solve(br);
+    f.solve(bl);
+    f.solve_transposed(bt);
+
+    Sci::Matrix<double> bs = a * xr;
+    f.solve(Kokkos::submdspan(bs.to_mdspan(), Kokkos::full_extent, 1));
+
+    for (Sci::index i = 0; i < n; ++i) {
+        EXPECT_NEAR(b(i), x(i), 1.0e-12);
+        EXPECT_NEAR(bt(i), x(i), 1.0e-12);
+        EXPECT_NEAR(bs(i, 1), xr(i, 1), 1.0e-12);
+        for (Sci::index j = 0; j < xr.extent(1); ++j) {
+            EXPECT_NEAR(br(i, j), xr(i, j), 1.0e-12);
+            EXPECT_NEAR(bl(i, j), xl(i, j), 1.0e-12);
+        }
+    }
+
+    auto brt = Sci::Linalg::transposed(a) * xr;
+    f.solve_transposed(brt);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < xr.extent(1); ++j) {
+            EXPECT_NEAR(brt(i, j), xr(i, j), 1.0e-12);
+        }
+    }
+
+    // Single-column matrices have unit stride in both extents.
+    Sci::Matrix<double> x1(n, 1);
+    for (Sci::index i = 0; i < n; ++i) {
+        x1(i, 0) = x(i);
+    }
+    auto b1 = a * x1;
+    Sci::Matrix<double, Kokkos::layout_left> b1l(b1.to_mdspan());
+    f.solve(b1);
+    f.solve(b1l);
+    for (Sci::index i = 0; i < n; ++i) {
+        EXPECT_NEAR(b1(i, 0), x(i), 1.0e-12);
+        EXPECT_NEAR(b1l(i, 0), x(i), 1.0e-12);
+    }
+
+    // Singular matrix.
+    Sci::Matrix<double> s = {{1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}, {1.0, 0.0, 1.0}};
+    f.factorize(s);
+    EXPECT_TRUE(f.singular());
+    EXPECT_EQ(f.det(), 0.0);
+    EXPECT_EQ(f.rcond(), 0.0);
+    Sci::Vector<double> y = {1.0, 2.0, 3.0};
+    EXPECT_THROW(f.solve(y), std::runtime_error);
+}
+
 TEST(TestLinalg, TestQR)
 {
     using namespace Sci;
@@ -231,3 +314,346 @@ TEST(TestLinalg, TestSVDColMajor)
         }
     }
 }
+
+TEST(TestLinalg, TestQRFactorization)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    const Sci::index m = 9;
+    const Sci::index n = 4;
+    Matrix<double> a(m, n);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = std::sin(static_cast<double>(i * n + j + 1)) + ((i == j) ? 2.0 : 0.0);
+        }
+    }
+
+    // Thin QR: q is m x n and r is n x n.
+    Matrix<double> q(m, n);
+    Matrix<double> r(n, n);
+    qr(a, q, r);
+    auto qr_prod = q * r;
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            EXPECT_NEAR(qr_prod(i, j), a(i, j), 1.0e-12);
+        }
+    }
+    for (Sci::index i = 1; i < n; ++i) {
+        for (Sci::index j = 0; j < i; ++j) {
+            EXPECT_EQ(r(i, j), 0.0);
+        }
+    }
+
+    // Complete Q is orthogonal and extends the thin Q.
+    QRFactorization fact(a);
+    auto qc = fact.q(true);
+    EXPECT_EQ(qc.extent(1), m);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < m; ++j) {
+            double sum = 0.0;
+            for (Sci::index k = 0; k < m; ++k) {
+                sum += qc(k, i) * qc(k, j);
+            }
+            EXPECT_NEAR(sum, (i == j) ? 1.0 : 0.0, 1.0e-12);
+        }
+        for (Sci::index j = 0; j < n; ++j) {
+            EXPECT_NEAR(qc(i, j), q(i, j), 1.0e-12);
+        }
+    }
+
+    // Q' * (Q * c) = c without forming Q, in both layouts.
+    Matrix<double> c(m, 3);
+    Matrix<double, Kokkos::layout_left> c_left(m, 3);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < 3; ++j) {
+            c(i, j) = std::cos(static_cast<double>(i + 2 * j));
+            c_left(i, j) = c(i, j);
+        }
+    }
+    Matrix<double> ans = qc * c;
+    Matrix<double> c0 = c;
+    fact.apply_q(c);
+    fact.apply_q(c_left);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < 3; ++j) {
+            EXPECT_NEAR(c(i, j), ans(i, j), 1.0e-12);
+            EXPECT_NEAR(c_left(i, j), ans(i, j), 1.0e-12);
+        }
+    }
+    fact.apply_qt(c);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < 3; ++j) {
+            EXPECT_NEAR(c(i, j), c0(i, j), 1.0e-12);
+        }
+    }
+
+    // Least squares: the residual is orthogonal to the columns of A.
+    Vector<double> b(m);
+    for (Sci::index i = 0; i < m; ++i) {
+        b(i) = std::cos(static_cast<double>(3 * i));
+    }
+    auto x = fact.solve(b);
+    EXPECT_EQ(x.size(), n);
+    Vector<double> resid = b - a * x;
+    for (Sci::index j = 0; j < n; ++j) {
+        double sum = 0.0;
+        for (Sci::index i = 0; i < m; ++i) {
+            sum += a(i, j) * resid(i);
+        }
+        EXPECT_NEAR(sum, 0.0, 1.0e-12);
+    }
+    auto xm = fact.solve(c0);
+    EXPECT_EQ(xm.extent(0), n);
+    EXPECT_EQ(xm.extent(1), 3);
+
+    // Single-column matrices have unit stride in both extents.
+    Matrix<double> a1 = {{1.0}, {2.0}, {2.0}};
+    Matrix<double> q1(3, 1);
+    Matrix<double> r1(1, 1);
+    qr(a1, q1, r1);
+    EXPECT_NEAR(std::abs(r1(0, 0)), 3.0, 1.0e-12);
+    auto qr1_prod = q1 * r1;
+    for (Sci::index i = 0; i < 3; ++i) {
+        EXPECT_NEAR(qr1_prod(i, 0), a1(i, 0), 1.0e-12);
+    }
+    QRFactorization fact1(a1);
+    auto q1_thin = fact1.q();
+    EXPECT_EQ(q1_thin.extent(1), 1);
+    for (Sci::index i = 0; i < 3; ++i) {
+        EXPECT_NEAR(std::abs(q1_thin(i, 0)), a1(i, 0) / 3.0, 1.0e-12);
+    }
+    Matrix<double> c1 = a1;
+    fact1.apply_qt(c1);
+    EXPECT_NEAR(std::abs(c1(0, 0)), 3.0, 1.0e-12);
+    EXPECT_NEAR(c1(1, 0), 0.0, 1.0e-12);
+    EXPECT_NEAR(c1(2, 0), 0.0, 1.0e-12);
+    fact1.apply_q(c1);
+    for (Sci::index i = 0; i < 3; ++i) {
+        EXPECT_NEAR(c1(i, 0), a1(i, 0), 1.0e-12);
+    }
+}
+
+namespace {
+
+// Check a = u * diag(s) * vt over the first k singular triplets.
+template <class Layout>
+void check_svd(const Sci::Matrix<double, Layout>& a,
+               const Sci::Vector<double, Layout>& s,
+               const Sci::Matrix<double, Layout>& u,
+               const Sci::Matrix<double, Layout>& vt)
+{
+    const Sci::index k = s.size();
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            double sum = 0.0;
+            for (Sci::index l = 0; l < k; ++l) {
+                sum += u(i, l) * s(l) * vt(l, j);
+            }
+            EXPECT_NEAR(sum, a(i, j), 1.0e-12);
+        }
+    }
+}
+
+template <class Layout>
+void test_svd_modes(Sci::index m, Sci::index n, Sci::Linalg::Svd_driver driver)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    const Sci::index k = std::min(m, n);
+    Matrix<double, Layout> a(m, n);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = std::sin(static_cast<double>(i * n + j + 1));
+        }
+    }
+    auto s_ref = svdvals(a);
+    for (Sci::index l = 1; l < k; ++l) {
+        EXPECT_GE(s_ref(l - 1), s_ref(l));
+    }
+    auto s_dd = svdvals(a, Svd_driver::gesdd);
+    for (Sci::index l = 0; l < k; ++l) {
+        EXPECT_NEAR(s_dd(l), s_ref(l), 1.0e-12);
+    }
+
+    {
+        Matrix<double, Layout> tmp(a);
+        Vector<double, Layout> s(k);
+        Matrix<double, Layout> u(m, m);
+        Matrix<double, Layout> vt(n, n);
+        svd(tmp, s, u, vt, 'A', driver);
+        check_svd(a, s, u, vt);
+    }
+    {
+        Matrix<double, Layout> tmp(a);
+        Vector<double, Layout> s(k);
+        Matrix<double, Layout> u(m, k);
+        Matrix<double, Layout> vt(k, n);
+        svd(tmp, s, u, vt, 'S', driver);
+        check_svd(a, s, u, vt);
+        for (Sci::index l = 0; l < k; ++l) {
+            EXPECT_NEAR(s(l), s_ref(l), 1.0e-12);
+        }
+    }
+    {
+        Matrix<double, Layout> tmp(a);
+        Vector<double, Layout> s(k);
+        Matrix<double, Layout> other(m >= n ? k : m, m >= n ? n : k);
+        Matrix<double, Layout> unused;
+        if (m >= n) {
+            svd(tmp, s, unused, other, 'O', driver);
+            check_svd(a, s, tmp, other);
+        }
+        else {
+            svd(tmp, s, other, unused, 'O', driver);
+            check_svd(a, s, other, tmp);
+        }
+    }
+}
+
+} // namespace
+
+TEST(TestLinalg, TestSVDModes)
+{
+    using namespace Sci::Linalg;
+
+    for (auto driver : {Svd_driver::gesvd, Svd_driver::gesdd}) {
+        test_svd_modes<Kokkos::layout_right>(7, 4, driver);
+        test_svd_modes<Kokkos::layout_right>(4, 7, driver);
+        test_svd_modes<Kokkos::layout_left>(7, 4, driver);
+        test_svd_modes<Kokkos::layout_left>(4, 7, driver);
+        test_svd_modes<Kokkos::layout_right>(5, 5, driver);
+        test_svd_modes<Kokkos::layout_left>(5, 5, driver);
+    }
+}
+
+TEST(TestLinalg, TestRandomizedSVD)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    // A = Ua * diag(sigma) * Va' of rank 12 with geometrically decaying
+    // singular values.
+    const Sci::index m = 300;
+    const Sci::index n = 80;
+    const Sci::index rank = 12;
+    Matrix<double> ua(m, rank);
+    Matrix<double> va(n, rank);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < rank; ++j) {
+            ua(i, j) = std::sin(static_cast<double>(i * rank + j + 1));
+        }
+    }
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < rank; ++j) {
+            va(i, j) = std::cos(static_cast<double>(3 * i + j * j));
+        }
+    }
+    QRFactorization(ua).q(ua.to_mdspan());
+    QRFactorization(va).q(va.to_mdspan());
+    Matrix<double> a(m, n);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (Sci::index l = 0; l < rank; ++l) {
+                sum += ua(i, l) * std::pow(0.5, static_cast<double>(l)) * va(j, l);
+            }
+            a(i, j) = sum;
+        }
+    }
+
+    const Sci::index k = 6;
+    auto res = randomized_svd(a, k, 10, 2, 42);
+    EXPECT_EQ(res.s.size(), k);
+    EXPECT_EQ(res.u.extent(0), m);
+    EXPECT_EQ(res.vt.extent(1), n);
+    for (Sci::index l = 0; l < k; ++l) {
+        EXPECT_NEAR(res.s(l), std::pow(0.5, static_cast<double>(l)), 1.0e-12);
+    }
+    // u and vt are orthonormal, and A * v = s * u.
+    for (Sci::index p = 0; p < k; ++p) {
+        for (Sci::index r = 0; r < k; ++r) {
+            double uu = 0.0;
+            for (Sci::index i = 0; i < m; ++i) {
+                uu += res.u(i, p) * res.u(i, r);
+            }
+            double vv = 0.0;
+            for (Sci::index j = 0; j < n; ++j) {
+                vv += res.vt(p, j) * res.vt(r, j);
+            }
+            EXPECT_NEAR(uu, (p == r) ? 1.0 : 0.0, 1.0e-12);
+            EXPECT_NEAR(vv, (p == r) ? 1.0 : 0.0, 1.0e-12);
+        }
+        for (Sci::index i = 0; i < m; ++i) {
+            double av = 0.0;
+            for (Sci::index j = 0; j < n; ++j) {
+                av += a(i, j) * res.vt(p, j);
+            }
+            EXPECT_NEAR(av, res.s(p) * res.u(i, p), 1.0e-12);
+        }
+    }
+
+    // The matrix-free variant and a column-major A give the same result for
+    // the same seed.
+    auto apply_a = [&](auto x, auto y) {
+        for (Sci::index i = 0; i < m; ++i) {
+            for (Sci::index c = 0; c < x.extent(1); ++c) {
+                double sum = 0.0;
+                for (Sci::index j = 0; j < n; ++j) {
+                    sum += a(i, j) * x(j, c);
+                }
+                y(i, c) = sum;
+            }
+        }
+    };
+    auto apply_at = [&](auto x, auto y) {
+        for (Sci::index j = 0; j < n; ++j) {
+            for (Sci::index c = 0; c < x.extent(1); ++c) {
+                double sum = 0.0;
+                for (Sci::index i = 0; i < m; ++i) {
+                    sum += a(i, j) * x(i, c);
+                }
+                y(j, c) = sum;
+            }
+        }
+    };
+    auto res_free = randomized_svd(m, n, apply_a, apply_at, k, 10, 2, 42);
+    Matrix<double, Kokkos::layout_left> a_left(m, n);
+    Sci::copy(a.to_mdspan(), a_left.to_mdspan());
+    auto res_left = randomized_svd(a_left, k, 10, 2, 42);
+    for (Sci::index l = 0; l < k; ++l) {
+        EXPECT_NEAR(res_free.s(l), res.s(l), 1.0e-12);
+        EXPECT_NEAR(res_left.s(l), res.s(l), 1.0e-12);
+        for (Sci::index i = 0; i < m; ++i) {
+            EXPECT_NEAR(res_free.u(i, l), res.u(i, l), 1.0e-10);
+            EXPECT_NEAR(res_left.u(i, l), res.u(i, l), 1.0e-10);
+        }
+    }
+
+    // A single sample vector, for the rank-one A = x * y'.
+    const Sci::index m1 = 20;
+    const Sci::index n1 = 8;
+    Vector<double> x1(m1);
+    Vector<double> y1(n1);
+    for (Sci::index i = 0; i < m1; ++i) {
+        x1(i) = 1.0 + 0.05 * static_cast<double>(i);
+    }
+    for (Sci::index j = 0; j < n1; ++j) {
+        y1(j) = std::cos(static_cast<double>(j));
+    }
+    Matrix<double> a1(m1, n1);
+    for (Sci::index i = 0; i < m1; ++i) {
+        for (Sci::index j = 0; j < n1; ++j) {
+            a1(i, j) = x1(i) * y1(j);
+        }
+    }
+    auto res1 = randomized_svd(a1, 1, 0, 2, 42);
+    EXPECT_EQ(res1.u.extent(1), 1);
+    EXPECT_NEAR(res1.s(0), vector_norm2(x1) * vector_norm2(y1), 1.0e-12);
+    for (Sci::index i = 0; i < m1; ++i) {
+        for (Sci::index j = 0; j < n1; ++j) {
+            EXPECT_NEAR(res1.u(i, 0) * res1.s(0) * res1.vt(0, j), a1(i, j), 1.0e-12);
+        }
+    }
+}
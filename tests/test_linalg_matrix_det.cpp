@@ -10,6 +10,7 @@
 #endif
 
 #include <cmath>
+#include <array>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -84,3 +85,28 @@ TEST(TestLinalg, TestZeroDet)
      Matrix<double> A = {{1.0, 1.0, -2.0}, {1.0, -2.0, 1.0}, {-2.0, 1.0, 1.0}};
      EXPECT_NEAR(det(A), 0.0, 1.0e-16);
 }
+
+TEST(TestLinalg, TestDetStatic)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    constexpr StaticMatrix<double, 2, 2> a2(Kokkos::extents<Sci::index, 2, 2>(), {1.0, 5.0, -2.0, 3.0});
+    constexpr StaticMatrix<double, 3, 3> a3(Kokkos::extents<Sci::index, 3, 3>(),
+                                            {1.0, 5.0, 4.0, -2.0, 3.0, 6.0, 5.0, 1.0, 0.0});
+    // clang-format off
+    constexpr StaticMatrix<double, 4, 4> a4(Kokkos::extents<Sci::index, 4, 4>(), {
+         1.0, 5.0,  4.0,  2.0,
+        -2.0, 3.0,  6.0,  4.0,
+         5.0, 1.0,  0.0, -1.0,
+         2.0, 3.0, -4.0,  0.0
+    });
+    // clang-format on
+    static_assert(det(a2) == 13.0);
+    static_assert(det(a3) == 76.0);
+    static_assert(det(a4) == 242.0);
+
+    StaticMatrix<double, 4, 4, layout_left> b4(a4.to_mdspan());
+    EXPECT_NEAR(det(b4), 242.0, 1.0e-12);
+    EXPECT_NEAR(det(b4), det(Matrix<double>(a4.to_mdspan())), 1.0e-12);
+}
@@ -10,6 +10,8 @@
 #endif
 
 #include <cmath>
+#include <array>
+#include <type_traits>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -97,3 +99,94 @@ TEST(TestLinalg, TestNotInvertible)
      Matrix<double> A = {{1.0, 1.0, -2.0}, {1.0, -2.0, 1.0}, {-2.0, 1.0, 1.0}};
      EXPECT_ANY_THROW(inv(A));
 }
+
+TEST(TestLinalg, TestInvStatic)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    // clang-format off
+    constexpr StaticMatrix<double, 4, 4> a(Kokkos::extents<Sci::index, 4, 4>(), {
+         1.0, 5.0,  4.0,  2.0,
+        -2.0, 3.0,  6.0,  4.0,
+         5.0, 1.0,  0.0, -1.0,
+         2.0, 3.0, -4.0,  0.0
+    });
+    // clang-format on
+    constexpr auto ainv = inv(a);
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(ainv)>, StaticMatrix<double, 4, 4>>);
+
+    auto ans = inv(Matrix<double>(a.to_mdspan()));
+    for (Sci::index i = 0; i < 4; ++i) {
+        for (Sci::index j = 0; j < 4; ++j) {
+            EXPECT_NEAR(ainv(i, j), ans(i, j), 1.0e-12);
+        }
+    }
+
+    // The 1x1, 2x2 and 3x3 kernels, in place and compared with LAPACK.
+    auto check = []<Sci::index n>(std::integral_constant<Sci::index, n>) {
+        StaticMatrix<double, n, n, layout_left> b(Kokkos::extents<Sci::index, n, n>{});
+        for (Sci::index i = 0; i < n; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                b(i, j) = (i == j) ? 2.0 + static_cast<double>(i == n - 1) : 0.0;
+                if (i - j == 1 || j - i == 1) {
+                    b(i, j) = -1.0;
+                }
+            }
+        }
+        Matrix<double, layout_left> c(b.to_mdspan());
+        inv(b.to_mdspan(), b.to_mdspan()); // in place
+        auto cinv = inv(c);
+        for (Sci::index i = 0; i < n; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                EXPECT_NEAR(b(i, j), cinv(i, j), 1.0e-12);
+            }
+        }
+    };
+    check(std::integral_constant<Sci::index, 1>{});
+    check(std::integral_constant<Sci::index, 2>{});
+    check(std::integral_constant<Sci::index, 3>{});
+
+    StaticMatrix<double, 2, 2> s(Kokkos::extents<Sci::index, 2, 2>(), {1.0, 2.0, 2.0, 4.0});
+    EXPECT_THROW(inv(s), std::runtime_error);
+}
+
+TEST(TestLinalg, TestInvInplace)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    Matrix<double> a = {
+        {1.0, 5.0, 4.0, 2.0}, {-2.0, 3.0, 6.0, 4.0}, {5.0, 1.0, 0.0, -1.0}, {2.0, 3.0, -4.0, 0.0}};
+    Matrix<double, Kokkos::layout_left> al(a.to_mdspan());
+    auto ainv = inv(a);
+
+    inv_inplace(a);
+    inv_inplace(al);
+    for (Sci::index i = 0; i < a.extent(0); ++i) {
+        for (Sci::index j = 0; j < a.extent(1); ++j) {
+            EXPECT_NEAR(a(i, j), ainv(i, j), 1.0e-12);
+            EXPECT_NEAR(al(i, j), ainv(i, j), 1.0e-12);
+        }
+    }
+
+    // The determinant overflows, but the matrix is well conditioned.
+    const Sci::index n = 200;
+    Matrix<double> d(n, n);
+    d = 0.0;
+    for (Sci::index i = 0; i < n; ++i) {
+        d(i, i) = 1.0e3;
+    }
+    auto dinv = inv(d);
+    EXPECT_NEAR(dinv(0, 0), 1.0e-3, 1.0e-15);
+    EXPECT_NEAR(dinv(n - 1, n - 1), 1.0e-3, 1.0e-15);
+
+    // Singular to working precision.
+    Matrix<double> h(14, 14);
+    for (Sci::index i = 0; i < h.extent(0); ++i) {
+        for (Sci::index j = 0; j < h.extent(1); ++j) {
+            h(i, j) = 1.0 / static_cast<double>(i + j + 1);
+        }
+    }
+    EXPECT_THROW(inv_inplace(h), std::runtime_error);
+}
@@ -37,6 +37,36 @@ TEST(TestLinalg, TestMatrixNorm)
     EXPECT_EQ(matrix_norm(A, 'I'), 15.0);
 }
 
+TEST(TestLinalg, TestMatrixNormExpression)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    // clang-format off
+    std::vector<double> a_data = {
+        -3.0, 5.0, 7.0,
+         0.0, 2.0, 8.0
+    };
+    std::vector<double> b_data = {
+        1.0, 2.0, 3.0,
+        4.0, 5.0, 6.0
+    };
+    // clang-format on
+    using extents_type = typename Matrix<double>::extents_type;
+    Matrix<double> A(extents_type(2, 3), a_data);
+    Matrix<double> B(extents_type(2, 3), b_data);
+    Matrix<double> C = A - B;
+
+    EXPECT_EQ(matrix_norm(A - B, 'F'), matrix_norm(C, 'F'));
+    EXPECT_EQ(matrix_norm(A - B, '1'), matrix_norm(C, '1'));
+
+    using static_extents = Kokkos::extents<Sci::index, 2, 2>;
+    StaticMatrix<double, 2, 2> S1(static_extents(), {1.0, 2.0, 3.0, 4.0});
+    StaticMatrix<double, 2, 2> S2(static_extents(), {0.5, 0.5, 0.5, 0.5});
+    StaticMatrix<double, 2, 2> S3 = S1 - S2;
+    EXPECT_EQ(matrix_norm(S1 - S2, 'F'), matrix_norm(S3, 'F'));
+}
+
 TEST(TestLinalg, TestMatrixNormColMajor)
 {
     using namespace Sci;
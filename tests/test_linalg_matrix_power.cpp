@@ -10,6 +10,7 @@
 #endif
 
 #include <cmath>
+#include <limits>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -158,3 +159,96 @@ TEST(TestLinalg, TestMatrixPowerColMajor)
         }
     }
 }
+
+TEST(TestLinalg, TestMatrixPowerSquaring)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    const Sci::index n = 12;
+    Matrix<double> a(n, n);
+    Matrix<double> s(n, n);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = 0.2 * std::sin(static_cast<double>(3 * i + j + 1));
+            s(i, j) = 0.1 * std::cos(static_cast<double>(i + j)) + 0.05 * std::cos(i * j / 3.0);
+        }
+        a(i, i) += 0.5;
+    }
+
+    // Compare with repeated products for general and symmetric matrices.
+    for (const auto& m : {a, s}) {
+        for (int p : {2, 3, 7, 13, 64, 77, -1, -4, -39}) {
+            Matrix<double> base = (p < 0) ? inv(m) : m;
+            Matrix<double> ans = identity<Matrix<double>>(n);
+            for (int k = 0; k < std::abs(p); ++k) {
+                ans = ans * base;
+            }
+            auto res = matrix_power(m, p);
+            double scale = 1.0;
+            for (Sci::index i = 0; i < n; ++i) {
+                for (Sci::index j = 0; j < n; ++j) {
+                    scale = std::max(scale, std::abs(ans(i, j)));
+                }
+            }
+            for (Sci::index i = 0; i < n; ++i) {
+                for (Sci::index j = 0; j < n; ++j) {
+                    EXPECT_NEAR(res(i, j), ans(i, j), 1.0e-10 * scale);
+                }
+            }
+        }
+    }
+
+    Matrix<double, Kokkos::layout_left> b(n, n);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            b(i, j) = s(i, j);
+        }
+    }
+    auto res_left = matrix_power(b, 100);
+    auto res_right = matrix_power(s, 100);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            EXPECT_NEAR(res_left(i, j), res_right(i, j), 1.0e-12);
+        }
+    }
+
+    // Small integer matrices are raised exactly, even when symmetric.
+    Matrix<double> fib = {{1.0, 1.0}, {1.0, 0.0}};
+    auto res_fib = matrix_power(fib, 63);
+    EXPECT_EQ(res_fib(0, 0), 10610209857723.0);
+    EXPECT_EQ(res_fib(0, 1), 6557470319842.0);
+    EXPECT_EQ(res_fib(1, 0), 6557470319842.0);
+    EXPECT_EQ(res_fib(1, 1), 4052739537881.0);
+
+    // The magnitude of INT_MIN does not fit in int.
+    Matrix<double> swap = {{0.0, 1.0}, {1.0, 0.0}};
+    auto res_swap = matrix_power(swap, std::numeric_limits<int>::min());
+    EXPECT_EQ(res_swap, (identity<Matrix<double>>(2)));
+
+    // Large symmetric matrices take the eigendecomposition path for large
+    // powers; compare with repeated squaring.
+    const Sci::index nl = 80;
+    Matrix<double> sl(nl, nl);
+    for (Sci::index i = 0; i < nl; ++i) {
+        for (Sci::index j = 0; j < nl; ++j) {
+            sl(i, j) = 0.01 * std::cos(static_cast<double>(i + j)) + 0.005 * std::cos(i * j / 3.0);
+        }
+    }
+    Matrix<double> ans_l = sl;
+    for (int k = 0; k < 6; ++k) {
+        ans_l = ans_l * ans_l;
+    }
+    auto res_l = matrix_power(sl, 64);
+    double scale_l = 0.0;
+    for (Sci::index i = 0; i < nl; ++i) {
+        for (Sci::index j = 0; j < nl; ++j) {
+            scale_l = std::max(scale_l, std::abs(ans_l(i, j)));
+        }
+    }
+    for (Sci::index i = 0; i < nl; ++i) {
+        for (Sci::index j = 0; j < nl; ++j) {
+            EXPECT_NEAR(res_l(i, j), ans_l(i, j), 1.0e-10 * scale_l);
+        }
+    }
+}
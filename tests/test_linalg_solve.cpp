@@ -9,6 +9,7 @@
 #pragma warning(disable : 4190)
 #endif
 
+#include <array>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -79,3 +80,81 @@ TEST(TestLinalg, TestSolveColMajor)
         EXPECT_NEAR(B(i, 0), x[i], 1.0e-12);
     }
 }
+
+TEST(TestLinalg, TestSolveWorkspace)
+{
+    using namespace Sci;
+    using namespace Sci::Linalg;
+
+    // clang-format off
+    std::vector<double> A_data = {
+        1.0, 2.0, 3.0, 
+        2.0, 3.0, 4.0, 
+        3.0, 4.0, 1.0
+    };
+    std::vector<double> x = {1.0, 2.0, 3.0};
+    // clang-format on
+
+    using extents_type = typename Matrix<double>::extents_type;
+
+    Workspace ws(4096);
+    {
+        Workspace_scope scope(ws);
+        EXPECT_EQ(workspace_resource(), &ws);
+
+        for (int iter = 0; iter < 3; ++iter) {
+            Matrix<double> A(extents_type(3, 3), A_data);
+            Matrix<double> B(3, 1);
+            B(0, 0) = 14.0;
+            B(1, 0) = 20.0;
+            B(2, 0) = 14.0;
+
+            solve(A, B);
+            EXPECT_EQ(ws.used(), 0);
+
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                EXPECT_NEAR(B(i, 0), x[i], 1.0e-12);
+            }
+        }
+        EXPECT_GT(ws.high_water_mark(), 0);
+        EXPECT_LE(ws.high_water_mark(), ws.capacity());
+
+        auto a = make_scratch<double>(3, 3);
+        auto b = make_scratch<double>(3);
+        EXPECT_GE(ws.used(), 12 * sizeof(double));
+        EXPECT_EQ(a.size(), 9);
+        EXPECT_EQ(b.size(), 3);
+    }
+    EXPECT_EQ(ws.used(), 0);
+    EXPECT_EQ(workspace_resource(), std::pmr::new_delete_resource());
+}
+
+TEST(TestLinalg, TestSolveStatic)
+{
+    // clang-format off
+    std::array<double, 9> A_data = {
+        1.0, 2.0, 3.0, 
+        2.0, 3.0, 4.0, 
+        3.0, 4.0, 1.0
+    };
+    // clang-format on
+    Sci::StaticMatrix<double, 3, 3> A(Kokkos::extents<Sci::index, 3, 3>(), A_data);
+    Sci::StaticMatrix<double, 3, 2> B(Kokkos::extents<Sci::index, 3, 2>(),
+                                      {14.0, 1.0, 20.0, 2.0, 14.0, 3.0});
+    Sci::Matrix<double> A2(A.to_mdspan());
+    Sci::Linalg::solve(A, B);
+
+    EXPECT_NEAR(B(0, 0), 1.0, 1.0e-12);
+    EXPECT_NEAR(B(1, 0), 2.0, 1.0e-12);
+    EXPECT_NEAR(B(2, 0), 3.0, 1.0e-12);
+
+    Sci::Matrix<double> B2(Kokkos::dextents<Sci::index, 2>(3, 1), {1.0, 2.0, 3.0});
+    Sci::Linalg::solve(A2, B2);
+    for (Sci::index i = 0; i < 3; ++i) {
+        EXPECT_NEAR(B(i, 1), B2(i, 0), 1.0e-12);
+    }
+
+    Sci::StaticMatrix<double, 2, 2> S(Kokkos::extents<Sci::index, 2, 2>(), {1.0, 2.0, 2.0, 4.0});
+    Sci::StaticMatrix<double, 2, 1> b(Kokkos::extents<Sci::index, 2, 1>(), {1.0, 1.0});
+    EXPECT_THROW(Sci::Linalg::solve(S, b), std::runtime_error);
+}
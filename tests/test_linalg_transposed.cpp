@@ -94,3 +94,90 @@ TEST(TestMatrix, TestTransposedStatic)
         }
     }
 }
+
+TEST(TestMatrix, TestTransposedLarge)
+{
+    const Sci::index m = 130;
+    const Sci::index n = 71;
+    Sci::Matrix<double> a(m, n);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = static_cast<double>(i * n + j);
+        }
+    }
+    auto at = Sci::Linalg::transposed(a);
+    Sci::Matrix<double, Kokkos::layout_left> b(a.to_mdspan());
+    auto bt = Sci::Linalg::transposed(b);
+
+    bool ok = true;
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            ok &= (at(j, i) == a(i, j)) && (bt(j, i) == a(i, j));
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(TestMatrix, TestTransposeInplace)
+{
+    // Square, tall and wide multiples, general rectangular and empty shapes.
+    const std::array<std::array<Sci::index, 2>, 8> shapes = {
+        {{70, 70}, {96, 32}, {20, 100}, {37, 53}, {1, 9}, {5, 0}, {0, 5}, {0, 0}}};
+
+    for (const auto& [m, n] : shapes) {
+        Sci::Matrix<double> a(m, n);
+        for (Sci::index i = 0; i < m; ++i) {
+            for (Sci::index j = 0; j < n; ++j) {
+                a(i, j) = static_cast<double>(i * n + j);
+            }
+        }
+        Sci::Matrix<double> at(a);
+        Sci::Linalg::transpose_inplace(at);
+        EXPECT_EQ(at.extent(0), n);
+        EXPECT_EQ(at.extent(1), m);
+        EXPECT_EQ(at, Sci::Linalg::transposed(a));
+
+        Sci::Matrix<double, Kokkos::layout_left> b(a.to_mdspan());
+        auto bt = Sci::Linalg::transposed(b);
+        Sci::Linalg::transpose_inplace(b);
+        EXPECT_EQ(b, bt);
+    }
+
+    // Square transpose above the parallel threshold, on request in parallel.
+    const Sci::index n = 600;
+    Sci::Matrix<double> a(n, n);
+    for (Sci::index i = 0; i < n; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = static_cast<double>(i * n + j);
+        }
+    }
+    Sci::Matrix<double> at(a);
+    Sci::Linalg::transpose_inplace(Sci::par, at);
+    EXPECT_EQ(at, Sci::Linalg::transposed(a));
+}
+
+TEST(TestMatrix, TestChangeLayout)
+{
+    Sci::Matrix<int> a = {{1, 2, 3}, {4, 5, 6}};
+    Sci::Matrix<int> ans(a);
+
+    auto b = Sci::Linalg::change_layout<Kokkos::layout_left>(std::move(a));
+    EXPECT_EQ(b.extent(0), 2);
+    EXPECT_EQ(b.extent(1), 3);
+    EXPECT_EQ(b.container_data()[1], 4);
+    for (Sci::index i = 0; i < b.extent(0); ++i) {
+        for (Sci::index j = 0; j < b.extent(1); ++j) {
+            EXPECT_EQ(b(i, j), ans(i, j));
+        }
+    }
+    auto c = Sci::Linalg::change_layout<Kokkos::layout_right>(std::move(b));
+    EXPECT_EQ(c, ans);
+
+    for (Sci::index m : {0, 5}) {
+        auto e = Sci::Linalg::change_layout<Kokkos::layout_left>(Sci::Matrix<int>(m, 5 - m));
+        EXPECT_EQ(e.extent(0), m);
+        EXPECT_EQ(e.extent(1), 5 - m);
+        auto f = Sci::Linalg::change_layout<Kokkos::layout_right>(std::move(e));
+        EXPECT_EQ(f.size(), 0);
+    }
+}
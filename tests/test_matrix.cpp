@@ -237,6 +237,62 @@ TEST(TestMatrix, TestAddMatrix)
     }
 }
 
+TEST(TestMatrix, TestExpression)
+{
+    Sci::Matrix<double> a = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    Sci::Matrix<double> b = {{6.0, 5.0, 4.0}, {3.0, 2.0, 1.0}};
+
+    auto expr = 2.0 * a - b / 2.0 + 1.0;
+    EXPECT_EQ(expr.extent(0), a.extent(0));
+    EXPECT_EQ(expr.extent(1), a.extent(1));
+
+    Sci::Matrix<double> c = expr;
+    for (Sci::index i = 0; i < c.extent(0); ++i) {
+        for (Sci::index j = 0; j < c.extent(1); ++j) {
+            EXPECT_DOUBLE_EQ(c(i, j), 2.0 * a(i, j) - b(i, j) / 2.0 + 1.0);
+            EXPECT_DOUBLE_EQ(expr(i, j), c(i, j));
+        }
+    }
+}
+
+TEST(TestMatrix, TestExpressionAliasing)
+{
+    Sci::Matrix<int> a = {{1, 2, 3}, {4, 5, 6}};
+    Sci::Matrix<int> ans = {{3, 6, 9}, {12, 15, 18}};
+
+    a = a + 2 * a;
+    EXPECT_EQ(a, ans);
+
+    a -= -a + ans;
+    EXPECT_EQ(a, ans);
+}
+
+TEST(TestMatrix, TestExpressionColMajor)
+{
+    Sci::Matrix<int, Kokkos::layout_left> a = {{1, 2, 3}, {4, 5, 6}};
+    Sci::Matrix<int, Kokkos::layout_left> b = {{6, 5, 4}, {3, 2, 1}};
+    Sci::Matrix<int, Kokkos::layout_left> c(2, 3);
+
+    c = a + b;
+    for (Sci::index i = 0; i < c.extent(0); ++i) {
+        for (Sci::index j = 0; j < c.extent(1); ++j) {
+            EXPECT_EQ(c(i, j), 7);
+        }
+    }
+}
+
+TEST(TestMatrix, TestExpressionTemporary)
+{
+    Sci::Matrix<int> a = {{1, 2}, {3, 4}};
+    auto expr = a + Sci::Matrix<int>(Kokkos::dextents<Sci::index, 2>(2, 2), 1);
+
+    Sci::Matrix<int> c(1, 1);
+    c = expr;
+    EXPECT_EQ(c.extent(0), 2);
+    EXPECT_EQ(c.extent(1), 2);
+    EXPECT_EQ(c(1, 1), 5);
+}
+
 TEST(TestMatrix, TestRow)
 {
     // clang-format off
@@ -394,3 +450,106 @@ TEST(TestMatrix, TestCopyRowMajorColMajor)
         }
     }
 }
+
+TEST(TestMatrix, TestCopyEngine)
+{
+    // Sizes that are not multiples of the transpose blocks.
+    const Sci::index m = 203;
+    const Sci::index n = 77;
+    Sci::Matrix<double> a(m, n);
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            a(i, j) = static_cast<double>(i * n + j);
+        }
+    }
+    Sci::Matrix<double, Kokkos::layout_left> b(a.to_mdspan());
+    Sci::Matrix<double> c(m, n);
+    Sci::copy(b.to_mdspan(), c.to_mdspan());
+    EXPECT_EQ(c, a);
+
+    Sci::Matrix<float> d(a.to_mdspan());
+    EXPECT_EQ(d(m - 1, n - 1), static_cast<float>(a(m - 1, n - 1)));
+
+    bool ok = true;
+    for (Sci::index i = 0; i < m; ++i) {
+        for (Sci::index j = 0; j < n; ++j) {
+            ok &= (b(i, j) == a(i, j));
+        }
+    }
+    EXPECT_TRUE(ok);
+
+    // Strided source and destination.
+    auto s = Sci::slice(a, std::pair{3, 103}, std::pair{5, 65});
+    Sci::Matrix<double, Kokkos::layout_left> e(100, 60);
+    Sci::copy(s, e.to_mdspan());
+    auto f = Sci::slice(c, std::pair{0, 100}, std::pair{10, 70});
+    Sci::copy(e.to_mdspan(), f);
+    EXPECT_EQ(c(0, 10), a(3, 5));
+    EXPECT_EQ(c(99, 69), a(102, 64));
+    EXPECT_EQ(c(0, 9), a(0, 9));
+
+    // Transposes above the parallel threshold, serial and on request in
+    // parallel.
+    Sci::Matrix<double> g(517, 301);
+    for (Sci::index i = 0; i < g.extent(0); ++i) {
+        for (Sci::index j = 0; j < g.extent(1); ++j) {
+            g(i, j) = static_cast<double>(i * g.extent(1) + j);
+        }
+    }
+    Sci::Matrix<double, Kokkos::layout_left> h(g.extent(0), g.extent(1));
+    Sci::Matrix<double, Kokkos::layout_left> hp(g.extent(0), g.extent(1));
+    Sci::copy(g.to_mdspan(), h.to_mdspan());
+    Sci::copy(Sci::par, g.to_mdspan(), hp.to_mdspan());
+    ok = true;
+    for (Sci::index i = 0; i < g.extent(0); ++i) {
+        for (Sci::index j = 0; j < g.extent(1); ++j) {
+            ok &= (h(i, j) == g(i, j)) && (hp(i, j) == g(i, j));
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(TestMatrix, TestAlignedMatrix)
+{
+    Sci::AlignedMatrix<float> a(3, 5);
+    Sci::AlignedMatrix<float> b(3, 5);
+    a = 1.0f;
+    b = 2.0f;
+
+    Sci::AlignedMatrix<float> c = a + b;
+    EXPECT_TRUE(c.is_aligned(64));
+    for (Sci::index i = 0; i < c.extent(0); ++i) {
+        for (Sci::index j = 0; j < c.extent(1); ++j) {
+            EXPECT_EQ(c(i, j), 3.0f);
+        }
+    }
+    c.resize(7, 9);
+    EXPECT_TRUE(c.is_aligned(64));
+}
+
+TEST(TestMatrix, TestConstructionTags)
+{
+    using Default_init_matrix = Sci::MDArray<double,
+                                             Kokkos::dextents<Sci::index, 2>,
+                                             Kokkos::layout_right,
+                                             Sci::Default_init_container<double>>;
+
+    Default_init_matrix a(Sci::uninitialized, 3, 4);
+    EXPECT_EQ(a.extent(0), 3);
+    EXPECT_EQ(a.extent(1), 4);
+    a = 2.0;
+    EXPECT_EQ(a(2, 3), 2.0);
+
+    Sci::Matrix<double> b(Sci::zero_pages, 3, 4);
+    for (Sci::index i = 0; i < b.extent(0); ++i) {
+        for (Sci::index j = 0; j < b.extent(1); ++j) {
+            EXPECT_EQ(b(i, j), 0.0);
+        }
+    }
+
+    Sci::StaticMatrix<int, 2, 2> c(Sci::zero_pages, 2, 2);
+    EXPECT_EQ(c(1, 1), 0);
+    Sci::StaticMatrix<int, 2, 2> d(Sci::uninitialized, 2, 2);
+    d = 1;
+    EXPECT_EQ(d(1, 1), 1);
+}
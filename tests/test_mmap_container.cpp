@@ -0,0 +1,124 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#if _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4190)
+#endif
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <gtest/gtest.h>
+#include <scilib/mdarray.h>
+#include <scilib/linalg.h>
+#include <scilib/statistics.h>
+
+#if _MSC_VER
+#pragma warning(pop)
+#endif
+
+#ifdef SCILIB_HAS_MMAP
+
+namespace {
+
+std::string temp_file(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST(TestMmapContainer, TestReadWrite)
+{
+    const std::string path = temp_file("scilib_test_mmap_rw.bin");
+    using extents_type = Kokkos::dextents<Sci::index, 2>;
+    {
+        Sci::MappedMatrix<double> a(extents_type(2, 3),
+                                    Sci::mmap_container<double>::create(path, 6));
+        for (Sci::index i = 0; i < a.extent(0); ++i) {
+            for (Sci::index j = 0; j < a.extent(1); ++j) {
+                a(i, j) = static_cast<double>(i * a.extent(1) + j + 1);
+            }
+        }
+    }
+    EXPECT_EQ(std::filesystem::file_size(path), 6 * sizeof(double));
+
+    Sci::mmap_container<const double> c(path);
+    EXPECT_EQ(c.size(), 6);
+    EXPECT_EQ(c.mode(), Sci::Mmap_mode::read_only);
+    c.advise(Sci::Mmap_advice::sequential);
+
+    const Sci::MappedMatrix<const double> a(extents_type(2, 3), std::move(c));
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(a(1, 2), 6.0);
+
+    auto v = Sci::MappedVector<const double>(Kokkos::dextents<Sci::index, 1>(6),
+                                             Sci::mmap_container<const double>(path));
+    EXPECT_EQ(Sci::Linalg::sum(v), 21.0);
+    EXPECT_EQ(Sci::Stats::mean(v), 3.5);
+
+    Sci::Matrix<double> b = {{1.0, 0.0}, {0.0, 1.0}, {1.0, 1.0}};
+    Sci::Matrix<double> ab(2, 2);
+    Sci::Linalg::matrix_product(a, b, ab);
+    EXPECT_EQ(ab(0, 0), 4.0);
+    EXPECT_EQ(ab(0, 1), 5.0);
+    EXPECT_EQ(ab(1, 0), 10.0);
+    EXPECT_EQ(ab(1, 1), 11.0);
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestMmapContainer, TestOffsetCopyOnWrite)
+{
+    const std::string path = temp_file("scilib_test_mmap_cow.bin");
+    {
+        auto c = Sci::mmap_container<int>::create(path, 4, 12);
+        for (std::size_t i = 0; i < c.size(); ++i) {
+            c[i] = static_cast<int>(i);
+        }
+        c.sync();
+    }
+    Sci::MappedVector<int> v(Kokkos::dextents<Sci::index, 1>(4),
+                             Sci::mmap_container<int>(path, Sci::Mmap_mode::copy_on_write, 12));
+    EXPECT_EQ(v(3), 3);
+    v(3) = 42;
+    EXPECT_EQ(v(3), 42);
+
+    Sci::mmap_container<const int> c(path, Sci::Mmap_mode::read_only, 12);
+    EXPECT_EQ(c[3], 3);
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestMmapContainer, TestReadOnly)
+{
+    const std::string path = temp_file("scilib_test_mmap_ro.bin");
+    {
+        auto c = Sci::mmap_container<double>::create(path, 4);
+        c[2] = 2.0;
+    }
+    // Read-only maps are only exposed through const elements.
+    Sci::MappedVector<const double> v(Kokkos::dextents<Sci::index, 1>(4),
+                                      Sci::mmap_container<const double>(path));
+    EXPECT_EQ(v(2), 2.0);
+    static_assert(!std::is_assignable_v<decltype(v(0)), double>);
+    static_assert(std::is_same_v<decltype(v.container_data()), const double*>);
+
+    EXPECT_THROW((Sci::mmap_container<double>(path, Sci::Mmap_mode::read_only)),
+                 std::invalid_argument);
+
+    // Mutable containers default to private copy-on-write maps.
+    Sci::mmap_container<double> w(path);
+    EXPECT_EQ(w.mode(), Sci::Mmap_mode::copy_on_write);
+    w[2] = 5.0;
+    EXPECT_EQ(v(2), 2.0);
+
+    std::filesystem::remove(path);
+}
+
+#endif // SCILIB_HAS_MMAP
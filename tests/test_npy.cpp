@@ -0,0 +1,172 @@
+// Copyright (c) 2024 Stig Rune Sellevag
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#if _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4190)
+#endif
+
+#include <complex>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <gtest/gtest.h>
+#include <scilib/mdarray.h>
+#include <scilib/linalg.h>
+
+#if _MSC_VER
+#pragma warning(pop)
+#endif
+
+namespace {
+
+std::string temp_file(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Write a version 1.0 .npy header with the given dictionary and no data.
+void write_raw_header(const std::string& path, const std::string& dict)
+{
+    std::ofstream os(path, std::ios::binary);
+    const char magic[] = {'\x93', 'N', 'U', 'M', 'P', 'Y', '\x01', '\x00'};
+    os.write(magic, sizeof(magic));
+    const char len[] = {static_cast<char>(dict.size() & 0xff), static_cast<char>(dict.size() >> 8)};
+    os.write(len, sizeof(len));
+    os.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+}
+
+} // namespace
+
+TEST(TestNpy, TestHeader)
+{
+    const std::string path = temp_file("scilib_test_npy_header.npy");
+
+    Sci::Matrix<double> a = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    Sci::save_npy(path, a);
+
+    std::ifstream is(path, std::ios::binary);
+    std::string header;
+    std::getline(is, header);
+    EXPECT_EQ((header.size() + 1) % 64, 0); // data is 64-byte aligned
+    EXPECT_EQ(std::filesystem::file_size(path), header.size() + 1 + 6 * sizeof(double));
+    EXPECT_EQ(header.substr(1, 5), "NUMPY");
+    EXPECT_NE(header.find("'descr': '<f8'"), std::string::npos);
+    EXPECT_NE(header.find("'fortran_order': False"), std::string::npos);
+    EXPECT_NE(header.find("'shape': (2, 3)"), std::string::npos);
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestNpy, TestMalformedHeader)
+{
+    const std::string path = temp_file("scilib_test_npy_malformed.npy");
+
+    // Truncated headers must throw instead of reading out of bounds.
+    const std::string full = "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }";
+    for (std::size_t len : {7, 8, 9, 14, 39, 48, 55}) {
+        const std::string dict = full.substr(0, len);
+        write_raw_header(path, dict);
+        EXPECT_THROW(Sci::load_npy<Sci::Matrix<double>>(path), std::runtime_error) << dict;
+    }
+
+    // Unquoted descr, and shapes that do not fit in the index type.
+    for (const std::string dict : {"{'descr': <f8, 'fortran_order': False, 'shape': (2, 3), }",
+                                   "{'descr': '<f8', 'fortran_order': False, "
+                                   "'shape': (18446744073709551615, 3), }",
+                                   "{'descr': '<f8', 'fortran_order': False, "
+                                   "'shape': (99999999999999999999999, 3), }",
+                                   "{'descr': '<f8', 'fortran_order': False, "
+                                   "'shape': (4294967296, 4294967296), }"}) {
+        write_raw_header(path, dict);
+        EXPECT_THROW(Sci::load_npy<Sci::Matrix<double>>(path), std::runtime_error) << dict;
+    }
+
+    // A header length beyond the end of the file must not be allocated.
+    {
+        std::ofstream os(path, std::ios::binary);
+        const char magic[] = {'\x93', 'N', 'U', 'M', 'P', 'Y', '\x02', '\x00'};
+        os.write(magic, sizeof(magic));
+        const char len[] = {'\xff', '\xff', '\xff', '\x7f'};
+        os.write(len, sizeof(len));
+        os << "{'descr': '<f8', }";
+    }
+    EXPECT_THROW(Sci::load_npy<Sci::Matrix<double>>(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(TestNpy, TestSaveLoad)
+{
+    const std::string path = temp_file("scilib_test_npy_save_load.npy");
+
+    Sci::Array3D<int> a(2, 3, 4);
+    int k = 0;
+    a.apply([&](int& x) { x = k++; });
+    Sci::save_npy(path, a);
+    EXPECT_EQ(Sci::load_npy<Sci::Array3D<int>>(path), a);
+
+    // Row-major file read into column-major array:
+    auto b = Sci::load_npy<Sci::Array3D<int, Kokkos::layout_left>>(path);
+    EXPECT_EQ(b(1, 2, 3), a(1, 2, 3));
+    EXPECT_EQ(b(0, 1, 2), a(0, 1, 2));
+
+    // Column-major file read into row-major array:
+    Sci::save_npy(path, b);
+    EXPECT_EQ(Sci::load_npy<Sci::Array3D<int>>(path), a);
+
+    Sci::Vector<std::complex<double>> z = {{1.0, 2.0}, {3.0, -4.0}};
+    Sci::save_npy(path, z);
+    EXPECT_EQ(Sci::load_npy<Sci::Vector<std::complex<double>>>(path), z);
+
+    EXPECT_THROW(Sci::load_npy<Sci::Vector<double>>(path), std::runtime_error);
+    EXPECT_THROW(Sci::load_npy<Sci::Matrix<std::complex<double>>>(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestNpy, TestSaveStrided)
+{
+    const std::string path = temp_file("scilib_test_npy_strided.npy");
+
+    Sci::Matrix<double> a = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    Sci::save_npy(path, Kokkos::Experimental::linalg::transposed(a.to_mdspan()));
+
+    auto at = Sci::load_npy<Sci::Matrix<double>>(path);
+    EXPECT_EQ(at.extent(0), 3);
+    EXPECT_EQ(at(2, 1), 6.0);
+    EXPECT_EQ(at(0, 1), 4.0);
+
+    std::filesystem::remove(path);
+}
+
+#ifdef SCILIB_HAS_MMAP
+TEST(TestNpy, TestMapNpy)
+{
+    const std::string path = temp_file("scilib_test_npy_map.npy");
+
+    Sci::Matrix<double, Kokkos::layout_left> a = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    Sci::save_npy(path, a);
+
+    auto m = Sci::map_npy<double, 2, Kokkos::layout_left>(path);
+    EXPECT_EQ(m.extent(0), 2);
+    EXPECT_EQ(m.extent(1), 3);
+    EXPECT_EQ(m(1, 2), 6.0);
+    EXPECT_EQ(Sci::Linalg::sum(Sci::row(m.to_mdspan(), 1)), 15.0);
+
+    auto c = Sci::map_npy<const double, 2, Kokkos::layout_left>(path);
+    EXPECT_EQ(c(0, 1), 2.0);
+    static_assert(!std::is_assignable_v<decltype(c(0, 1)), double>);
+
+    EXPECT_THROW((Sci::map_npy<double, 2>(path)), std::runtime_error);
+
+    // Truncated data.
+    write_raw_header(path, "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }");
+    EXPECT_THROW((Sci::map_npy<const double, 2>(path)), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+#endif
@@ -9,6 +9,7 @@
 #pragma warning(disable : 4190)
 #endif
 
+#include <cmath>
 #include <vector>
 #include <gtest/gtest.h>
 #include <scilib/mdarray.h>
@@ -60,3 +61,25 @@ TEST(TestStats, TestCov)
                              23.0, 40.0, 23.0, 14.0, 12.0, 56.0, 23.0};
     EXPECT_NEAR(Sci::Stats::cov(b, c), 59.78021978, 1.0e-8);
 }
+
+TEST(TestStats, TestSerialReproducible)
+{
+    // Large enough to run on the thread pool on request.
+    const Sci::index n = 1000003;
+    Sci::Vector<double> v(n);
+    for (Sci::index i = 0; i < n; ++i) {
+        v(i) = 1.0 / static_cast<double>(i + 1);
+    }
+    Sci::Vector<double> w(v);
+
+    const double var = Sci::Stats::var(v);
+    const double rms = Sci::Stats::rms(v);
+    EXPECT_EQ(Sci::Stats::var(w), var);
+    EXPECT_EQ(Sci::Stats::rms(w), rms);
+    EXPECT_EQ(Sci::Stats::var(Sci::execution::seq, v), var);
+    EXPECT_EQ(Sci::Stats::rms(Sci::execution::seq, v), rms);
+    EXPECT_EQ(Sci::Stats::stddev(Sci::execution::seq, v), std::sqrt(var));
+    EXPECT_NEAR(Sci::Stats::var(Sci::par, v), var, 1.0e-15);
+    EXPECT_NEAR(Sci::Stats::rms(Sci::par, v), rms, 1.0e-15);
+    EXPECT_NEAR(Sci::Stats::mean(Sci::par, v), Sci::Stats::mean(v), 1.0e-15);
+}
@@ -12,6 +12,7 @@
 #include <initializer_list>
 #include <vector>
 #include <gtest/gtest.h>
+#include <range/v3/view/iota.hpp>
 #include <scilib/mdarray.h>
 
 #if _MSC_VER
@@ -236,3 +237,23 @@ TEST(TestVector, TestLast)
         EXPECT_EQ(v_slice[i], a[i + 2]);
     }
 }
+
+TEST(TestVector, TestAlignedVector)
+{
+    Sci::AlignedVector<double> a(13);
+    a = 1.0;
+    a += 2.0;
+
+    EXPECT_EQ(a.container_alignment(), 64);
+    EXPECT_TRUE(a.is_aligned(64));
+    EXPECT_GE(a.alignment(), 64);
+
+    const double* data = a.aligned_data<64>();
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(data[i], 3.0);
+    }
+
+    Sci::AlignedVector<double, Kokkos::layout_right, 128> b = {1.0, 2.0, 3.0};
+    EXPECT_TRUE(b.is_aligned(128));
+    EXPECT_EQ(b[2], 3.0);
+}